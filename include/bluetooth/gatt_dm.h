@@ -317,6 +317,21 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context);
  */
 int bt_gatt_dm_data_release(struct bt_gatt_dm *dm);
 
+/** @brief Remove cached discovery results of a peer.
+ *
+ * The cached results are removed automatically when the bond with the peer
+ * is deleted or when the peer indicates Service Changed. Use this function
+ * to remove them explicitly.
+ *
+ * @note Available only if @kconfig{CONFIG_BT_GATT_DM_CACHE} is enabled.
+ *
+ * @param[in] addr Peer identity address or NULL to remove results of all peers.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int bt_gatt_dm_cache_clear(const bt_addr_le_t *addr);
+
 /** @brief Print service discovery data.
  *
  * This function prints GATT attributes that belong to the discovered service.
@@ -33,14 +33,39 @@ extern "C" {
 		}                                                              \
 	}
 
+#if CONFIG_BT_MESH_LIGHT_CTRL_REG_SPEC_FIXED_POINT
+/** @cond INTERNAL_HIDDEN */
+/** Fixed-point regulator coefficients, converted from the configuration. */
+struct bt_mesh_light_ctrl_reg_spec_coeffs {
+	/** Configuration the coefficients were converted from. */
+	struct bt_mesh_light_ctrl_reg_cfg cfg;
+	/** Integral coefficients, multiplied by the update interval. */
+	int64_t ki_up;
+	int64_t ki_down;
+	/** Proportional coefficients. */
+	int64_t kp_up;
+	int64_t kp_down;
+	/** Half of the accuracy, as a fraction of the target. */
+	int64_t accuracy;
+};
+/** @endcond */
+#endif
+
 /** Specification-defined illuminance regulator context. */
 struct bt_mesh_light_ctrl_reg_spec {
 	/** Common regulator context. */
 	struct bt_mesh_light_ctrl_reg reg;
 	/** Regulator step timer. */
 	struct k_work_delayable timer;
+#if CONFIG_BT_MESH_LIGHT_CTRL_REG_SPEC_FIXED_POINT
+	/** Internal integral sum, in fixed-point format. */
+	int64_t i;
+	/** Fixed-point coefficients. */
+	struct bt_mesh_light_ctrl_reg_spec_coeffs coeffs;
+#else
 	/** Internal integral sum. */
 	float i;
+#endif
 	/** Regulator enabled flag. */
 	bool enabled;
 	/* If true, internal integral sum can be negative until it becomes positive. */
@@ -27,6 +27,10 @@ extern "C" {
 #define CONFIG_BT_MESH_SCENES_MAX 0
 #endif
 
+#ifndef CONFIG_BT_MESH_SCENE_SRV_CACHE_SCENES
+#define CONFIG_BT_MESH_SCENE_SRV_CACHE_SCENES 0
+#endif
+
 /** @def BT_MESH_SCENE_ENTRY_SIG
  *
  *  @brief Scene entry type definition for SIG models
@@ -67,6 +71,24 @@ struct bt_mesh_scene_srv;
 						 _srv),                        \
 			 &_bt_mesh_scene_setup_srv_cb)
 
+/** @cond INTERNAL_HIDDEN */
+#if CONFIG_BT_MESH_SCENE_SRV_CACHE_SCENES > 0
+/** Scene data cached in RAM. */
+struct bt_mesh_scene_srv_cache {
+	/** Scene number, or @ref BT_MESH_SCENE_NONE if the entry is unused. */
+	uint16_t scene;
+	/** Length of the SIG model scene data at the start of @c data. */
+	uint16_t sig_len;
+	/** Length of the vendor model scene data at the end of @c data. */
+	uint16_t vnd_len;
+	/** The scene data does not fit, and must be loaded from storage. */
+	bool overflow;
+	/** Scene data. */
+	uint8_t data[CONFIG_BT_MESH_SCENE_SRV_CACHE_SIZE];
+};
+#endif
+/** @endcond */
+
 /** Scene Server model instance */
 struct bt_mesh_scene_srv {
 	/** All known scenes. */
@@ -89,6 +111,11 @@ struct bt_mesh_scene_srv {
 	/** Linked list node for Scene Server list */
 	sys_snode_t n;
 
+#if CONFIG_BT_MESH_SCENE_SRV_CACHE_SCENES > 0
+	/** Scene data cache. */
+	struct bt_mesh_scene_srv_cache cache[CONFIG_BT_MESH_SCENE_SRV_CACHE_SCENES];
+#endif
+
 	/** Transition timer */
 	struct k_work_delayable work;
 	/** Transition parameters. */
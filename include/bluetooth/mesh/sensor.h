@@ -862,6 +862,9 @@ const char *bt_mesh_sensor_ch_str(const struct bt_mesh_sensor_value *ch);
  *  @kconfig{CONFIG_BT_MESH_SENSOR_ALL_TYPES} or by referencing them in the
  *  application.
  *
+ *  The sensor types are sorted by ID at link time, so the lookup is a binary
+ *  search.
+ *
  *  @param[in] id A Device Property ID.
  *
  *  @return The associated sensor type, or NULL if the ID is unknown.
@@ -133,6 +133,31 @@ int bt_mesh_sensor_srv_pub(struct bt_mesh_sensor_srv *srv,
 			   struct bt_mesh_sensor *sensor,
 			   const struct bt_mesh_sensor_value *value);
 
+/** @brief Publish the values of multiple sensors in a single message.
+ *
+ *  Works the same way as @ref bt_mesh_sensor_srv_pub(), except that the values
+ *  of all the given sensors are encoded in one pass into a single Sensor Status
+ *  message. This saves the overhead of sending one message per sensor on
+ *  servers that expose many sensors.
+ *
+ *  @param[in] srv     Sensor server instance.
+ *  @param[in] ctx     Message context to publish with, or NULL to publish on
+ *                     the configured publish parameters.
+ *  @param[in] sensors Sensors to publish with.
+ *  @param[in] values  Sensor values to publish, one array of sensor channel
+ *                     values per sensor in @c sensors.
+ *  @param[in] count   Number of sensors to publish.
+ *
+ *  @retval 0       The sensor values were published.
+ *  @retval -ENOMEM The sensor values don't fit in a single message.
+ *  @return Other (negative) error codes from @ref bt_mesh_sensor_srv_pub().
+ */
+int bt_mesh_sensor_srv_pub_multi(
+	struct bt_mesh_sensor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+	struct bt_mesh_sensor *const *sensors,
+	const struct bt_mesh_sensor_value (*values)[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX],
+	size_t count);
+
 /** @brief Make the server to take a sample of the sensor, and publish if the
  *         value changed sufficiently.
  *
@@ -280,6 +280,27 @@ struct bt_scan_filter_match {
 	struct bt_scan_manufacturer_data_filter_status manufacturer_data;
 };
 
+/**@brief RSSI statistics of the aggregated advertising reports.
+ *
+ * @details Filled when the @kconfig{CONFIG_BT_SCAN_DEDUP} option is enabled.
+ *          The statistics cover the reported advertising report and all
+ *          reports from the same device that were suppressed since the
+ *          previous report.
+ */
+struct bt_scan_rssi_stats {
+	/** Number of reports with a valid RSSI value. */
+	uint16_t count;
+
+	/** Minimum RSSI value. */
+	int8_t min;
+
+	/** Maximum RSSI value. */
+	int8_t max;
+
+	/** Average RSSI value. */
+	int8_t avg;
+};
+
 /**@brief Structure containing device data needed to establish
  *        connection and advertising information.
  */
@@ -296,6 +317,11 @@ struct bt_scan_device_info {
 	 *  advertising data type.
 	 */
 	struct net_buf_simple *adv_data;
+
+#if CONFIG_BT_SCAN_DEDUP
+	/** RSSI statistics of the reports aggregated into this one. */
+	const struct bt_scan_rssi_stats *rssi_stats;
+#endif /* CONFIG_BT_SCAN_DEDUP */
 };
 
 /** @brief Initializing macro for scanning module.
@@ -103,6 +103,9 @@ int emds_init(emds_store_cb_t cb);
  *
  * @note EMDS does not make a local copy of the dynamic entry structure.
  *
+ * @note If the @kconfig{CONFIG_EMDS_INCREMENTAL} option is enabled, the entry
+ *       ID 0xFFFF is reserved.
+ *
  * @param entry Entry to add to list and load data into.
  *
  * @retval 0 Success
@@ -186,6 +189,11 @@ int emds_prepare(void);
  * registered in the entries. This value is dependent on the chip used, and
  * should be checked against the chip datasheet.
  *
+ * If the @kconfig{CONFIG_EMDS_INCREMENTAL} option is enabled and an
+ * incremental snapshot is prepared, only the entries that have changed since
+ * the base snapshot are taken into account for the write time. The estimate
+ * never exceeds the one of a full snapshot.
+ *
  * @param store_time_us Pointer to a variable where the estimated time (in microseconds)
  *                      will be stored.
  *
@@ -301,6 +301,22 @@ struct esb_payload {
 	uint8_t data[CONFIG_ESB_MAX_PAYLOAD_LENGTH]; /**< The payload data. */
 };
 
+/** @brief Received Enhanced ShockBurst payload in a radio buffer.
+ *
+ *  Used with @kconfig{CONFIG_ESB_RX_ZERO_COPY} to access a received payload in
+ *  the buffer the radio received it into, without copying it.
+ */
+struct esb_rx_buf {
+	const uint8_t *data; /**< The payload data. */
+	uint8_t length; /**< Length of the payload data. */
+	uint8_t pipe;   /**< Pipe the payload was received on. */
+	int8_t rssi;    /**< RSSI for the received packet. */
+	uint8_t noack;  /**< Flag indicating that the packet was not
+			 *  acknowledged.
+			 */
+	uint8_t pid;    /**< PID of the received packet. */
+};
+
 /** @brief Enhanced ShockBurst event. */
 struct esb_evt {
 	enum esb_evt_id evt_id;	/**< Enhanced ShockBurst event ID. */
@@ -413,6 +429,38 @@ int esb_write_payload(const struct esb_payload *payload);
  */
 int esb_read_rx_payload(struct esb_payload *payload);
 
+/** @brief Get the next received payload without copying it.
+ *
+ *  The radio buffer holding the payload is handed over to the application,
+ *  and must be returned with @ref esb_release_rx_buf once the application is
+ *  done with it. The radio buffers are shared with the RX FIFO, so every
+ *  buffer held by the application reduces the number of packets that can be
+ *  received before the RX FIFO is full.
+ *
+ *  Requires @kconfig{CONFIG_ESB_RX_ZERO_COPY}.
+ *
+ *  @param[out] buf	Received payload.
+ *
+ * @retval 0 If successful.
+ * @retval -ENODATA If there are no received payloads.
+ * @retval -ENOTSUP If @kconfig{CONFIG_ESB_RX_ZERO_COPY} is disabled.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_get_rx_buf(struct esb_rx_buf *buf);
+
+/** @brief Release a received payload obtained with @ref esb_get_rx_buf.
+ *
+ *  All held buffers are invalidated when the module is disabled.
+ *
+ *  @param[in] buf	Received payload to release.
+ *
+ * @retval 0 If successful.
+ * @retval -EALREADY If the buffer has already been released.
+ * @retval -ENOTSUP If @kconfig{CONFIG_ESB_RX_ZERO_COPY} is disabled.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_release_rx_buf(const struct esb_rx_buf *buf);
+
 /** @brief Start transmitting data.
  *
  * @retval 0 If successful.
@@ -444,12 +492,33 @@ int esb_stop_rx(void);
 int esb_flush_tx(void);
 
 /** @brief Pop the first item from the TX buffer.
+ *
+ * With @kconfig{CONFIG_ESB_TX_PIPE_QUEUES} in PTX mode, the first item of the
+ * queue of the pipe that was last transmitted on is removed, for example the
+ * payload reported by @ref ESB_EVENT_TX_FAILED.
  *
  * @retval 0 If successful.
  *           Otherwise, a (negative) error code is returned.
  */
 int esb_pop_tx(void);
 
+/** @brief Set the TX priority of a pipe.
+ *
+ *  With @kconfig{CONFIG_ESB_TX_PIPE_QUEUES}, payloads written in PTX mode are
+ *  queued separately for each pipe. The next payload is always transmitted
+ *  from the pipe with the highest priority that has queued payloads, and
+ *  pipes with equal priority take turns. All pipes have priority 0 by
+ *  default.
+ *
+ *  @param[in] pipe	Pipe.
+ *  @param[in] priority	Priority of the pipe. Higher values are served first.
+ *
+ * @retval 0 If successful.
+ * @retval -ENOTSUP If @kconfig{CONFIG_ESB_TX_PIPE_QUEUES} is disabled.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int esb_set_pipe_priority(uint8_t pipe, uint8_t priority);
+
 /** @brief Check if there is some free space left in TX FIFO.
  *
  * @retval true when the TX FIFO is full, otherwise false.
@@ -215,6 +215,13 @@ struct location_data_details {
 	 */
 	uint32_t elapsed_time_method;
 
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE)
+	/**
+	 * Age of the location in seconds if it was taken from the cloud location cache,
+	 * or -1 if it was not.
+	 */
+	int32_t cloud_cache_age;
+#endif
 #if defined(CONFIG_LOCATION_METHOD_GNSS)
 	/** Location details for GNSS. */
 	struct location_data_details_gnss gnss;
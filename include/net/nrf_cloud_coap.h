@@ -238,6 +238,64 @@ int nrf_cloud_coap_message_send(const char *app_id, const char *message, bool js
  */
 int nrf_cloud_coap_json_message_send(const char *message, bool bulk, bool confirmable);
 
+/**
+ * @brief Queue a sensor value to be sent to nRF Cloud later.
+ *
+ *  The value is encoded as a JSON device message and added to the deferred upload queue.
+ *  Queued messages are sent together in one request by nrf_cloud_coap_queue_flush(),
+ *  or in the background once the size or time threshold set in Kconfig is reached.
+ *  Requires the @kconfig{CONFIG_NRF_CLOUD_COAP_QUEUE} Kconfig option.
+ *
+ * @param[in]     app_id The app ID identifying the type of data. See the values
+ *                       that begin with NRF_CLOUD_JSON_APPID_ in nrf_cloud_defs.h. You may
+ *                       also use custom names.
+ * @param[in]     value  Sensor reading.
+ * @param[in]     ts_ms  Timestamp the data was measured, or NRF_CLOUD_NO_TIMESTAMP to use
+ *                       the current time.
+ *
+ * @retval -ENOBUFS The queue is full and could not be flushed or stored in flash.
+ * @retval -ENODATA NRF_CLOUD_NO_TIMESTAMP was given before the current time was known.
+ * @return 0 If successful, otherwise a negative error code.
+ */
+int nrf_cloud_coap_sensor_queue(const char *app_id, double value, int64_t ts_ms);
+
+/**
+ * @brief Queue a message to be sent to nRF Cloud later.
+ *
+ *  The message is encoded as a JSON device message and added to the deferred upload queue.
+ *  See nrf_cloud_coap_sensor_queue().
+ *
+ * @param[in]     app_id     The app_id identifying the type of data. See the values in
+ *                           nrf_cloud_defs.h that begin with  NRF_CLOUD_JSON_APPID_.
+ *                           You may also use custom names.
+ * @param[in]     message    The string to send.
+ * @param[in]     ts_ms      Timestamp the data was measured, or NRF_CLOUD_NO_TIMESTAMP to use
+ *                           the current time.
+ *
+ * @retval -ENOBUFS The queue is full and could not be flushed or stored in flash.
+ * @retval -ENODATA NRF_CLOUD_NO_TIMESTAMP was given before the current time was known.
+ * @return 0 If successful, otherwise a negative error code.
+ */
+int nrf_cloud_coap_message_queue(const char *app_id, const char *message, int64_t ts_ms);
+
+/**
+ * @brief Send all queued messages to nRF Cloud.
+ *
+ *  The messages in RAM are sent as one JSON array to the bulk device-to-cloud resource,
+ *  followed by any messages stored in flash. Messages that are not sent stay queued.
+ *  Call this function when the device is about to go idle, to send the queued messages
+ *  in the same connection window as other traffic.
+ *
+ * @param[in]     confirmable Select whether to use a CON or NON CoAP transfer.
+ *
+ * @retval -EACCES Device does not have a valid nRF Cloud CoAP connection.
+ * @return 0 If successful, nonzero if failed.
+ *           Negative values are device-side errors defined in errno.h.
+ *           Positive values are cloud-side errors (CoAP result codes)
+ *           defined in zephyr/net/coap.h.
+ */
+int nrf_cloud_coap_queue_flush(bool confirmable);
+
 /**
  * @brief Send the device location in the @ref nrf_cloud_gnss_data PVT field to nRF Cloud.
  *
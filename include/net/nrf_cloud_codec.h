@@ -39,6 +39,11 @@ enum nrf_cloud_obj_type {
 	 *  using the corresponding field in the union in struct nrf_cloud_obj_coap_cbor.
 	 */
 	NRF_CLOUD_OBJ_TYPE_COAP_CBOR,
+	/** This object type is encoded while it is being built, directly into a caller-provided
+	 *  buffer, see @ref NRF_CLOUD_OBJ_STREAM_DEFINE.
+	 *  Requires the @kconfig{CONFIG_NRF_CLOUD_OBJ_STREAM} Kconfig option.
+	 */
+	NRF_CLOUD_OBJ_TYPE_STREAM,
 
 	NRF_CLOUD_OBJ_TYPE__LAST,
 };
@@ -80,6 +85,61 @@ struct nrf_cloud_obj_coap_cbor {
 	int64_t ts;
 };
 
+/** @brief Output formats of NRF_CLOUD_OBJ_TYPE_STREAM objects */
+enum nrf_cloud_obj_stream_fmt {
+	/** JSON, for MQTT, REST and CoAP */
+	NRF_CLOUD_OBJ_STREAM_FMT_JSON,
+	/** CBOR following the CoAP message_out schema, for CoAP only.
+	 *  The message holds the app ID, an optional timestamp and a single "data"
+	 *  value, which is either a number, a string or PVT members added to the
+	 *  "data" child object.
+	 */
+	NRF_CLOUD_OBJ_STREAM_FMT_CBOR,
+};
+
+/** Maximum nesting of containers in an NRF_CLOUD_OBJ_TYPE_STREAM object: the root object,
+ *  its "data" child object and an array value.
+ */
+#define NRF_CLOUD_OBJ_STREAM_DEPTH_MAX 3
+
+/** @brief Encoder state of NRF_CLOUD_OBJ_TYPE_STREAM objects.
+ *
+ *  Values are appended to the buffer as they are added to the object, so the
+ *  encoded message needs no heap memory and no intermediate tree.
+ */
+struct nrf_cloud_obj_stream {
+	/** Output format */
+	enum nrf_cloud_obj_stream_fmt fmt;
+	/** Output buffer */
+	uint8_t *buf;
+	/** Size of the output buffer */
+	size_t size;
+	/** Number of bytes written to the output buffer */
+	size_t len;
+	/** @cond INTERNAL_HIDDEN */
+	struct {
+		/* Offset of the container's first byte in the buffer */
+		size_t offset;
+		/* Number of members or elements in the container */
+		uint16_t count;
+		/* The container is an object (map) rather than an array */
+		bool map;
+	} level[NRF_CLOUD_OBJ_STREAM_DEPTH_MAX];
+	uint8_t depth;
+	/* The root container is an array of messages */
+	bool bulk;
+	/* The "data" child object is open */
+	bool data_open;
+	/* The "data" child object has been closed and cannot be reopened */
+	bool data_done;
+	/* CBOR: timestamp to be written when the message is completed */
+	bool ts_pending;
+	uint64_t ts;
+	/* CBOR: bitmask of the message_out keys already written */
+	uint16_t cbor_keys;
+	/** @endcond */
+};
+
 /** @brief Object used for building nRF Cloud messages. */
 struct nrf_cloud_obj {
 
@@ -87,6 +147,7 @@ struct nrf_cloud_obj {
 	union {
 		cJSON *json;
 		struct nrf_cloud_obj_coap_cbor *coap_cbor;
+		struct nrf_cloud_obj_stream *stream;
 	};
 
 	/** Source of encoded data */
@@ -192,6 +253,27 @@ struct nrf_cloud_obj_shadow_data {
 				       .enc_src = NRF_CLOUD_ENC_SRC_NONE, \
 				       .encoded_data = { .ptr = NULL, .len = 0 } }
 
+/** @brief Define an nRF Cloud stream object.
+ *
+ * This macro defines a codec object with the type of NRF_CLOUD_OBJ_TYPE_STREAM, together with
+ * its encoder state named _name_stream.
+ * The object is encoded into the provided buffer while it is being built.
+ * Values of the "data" child object must be added consecutively, and nested objects
+ * (@ref nrf_cloud_obj_object_add) are not supported.
+ *
+ * @param _name	Name of the object.
+ * @param _buf	Buffer for the encoded data.
+ * @param _size	Size of the buffer.
+ * @param _fmt	Output format, see @ref nrf_cloud_obj_stream_fmt.
+ */
+#define NRF_CLOUD_OBJ_STREAM_DEFINE(_name, _buf, _size, _fmt) \
+	struct nrf_cloud_obj_stream _name##_stream = { .fmt = _fmt, .buf = (uint8_t *)(_buf), \
+						       .size = (_size) }; \
+	struct nrf_cloud_obj _name = { .type = NRF_CLOUD_OBJ_TYPE_STREAM, \
+				       .stream = &_name##_stream, \
+				       .enc_src = NRF_CLOUD_ENC_SRC_NONE, \
+				       .encoded_data = { .ptr = NULL, .len = 0 } }
+
 /** @brief Define an nRF Cloud codec object of the specified type.
  *
  * @param _name	Name of the object.
@@ -426,6 +508,8 @@ bool nrf_cloud_obj_bulk_check(struct nrf_cloud_obj *const obj);
  * @brief Add an object to a bulk message object.
  *
  * @details If successful, the object belongs to the bulk message and should not be freed directly.
+ *          Stream objects are copied into the bulk message and reset, so the object can be
+ *          reused for the next message.
  *
  * @param[out] bulk Bulk container object.
  * @param[in] obj Object to add.
@@ -465,6 +549,7 @@ int nrf_cloud_obj_ts_add(struct nrf_cloud_obj *const obj, const int64_t time_ms)
  * @retval -EINVAL Invalid parameter.
  * @retval -ENOENT Object is not initialized.
  * @retval -ENOMEM Out of memory.
+ * @retval -EPERM The "data" child of a stream object was already closed.
  * @retval -ENOTSUP Action not supported for the object's type.
  * @retval 0 Success; item added.
  */
@@ -483,6 +568,7 @@ int nrf_cloud_obj_num_add(struct nrf_cloud_obj *const obj, const char *const key
  * @retval -EINVAL Invalid parameter.
  * @retval -ENOENT Object is not initialized.
  * @retval -ENOMEM Out of memory.
+ * @retval -EPERM The "data" child of a stream object was already closed.
  * @retval -ENOTSUP Action not supported for the object's type.
  * @retval 0 Success; item added.
  */
@@ -501,6 +587,7 @@ int nrf_cloud_obj_str_add(struct nrf_cloud_obj *const obj, const char *const key
  * @retval -EINVAL Invalid parameter.
  * @retval -ENOENT Object is not initialized.
  * @retval -ENOMEM Out of memory.
+ * @retval -EPERM The "data" child of a stream object was already closed.
  * @retval -ENOTSUP Action not supported for the object's type.
  * @retval 0 Success; item added.
  */
@@ -518,6 +605,7 @@ int nrf_cloud_obj_bool_add(struct nrf_cloud_obj *const obj, const char *const ke
  * @retval -EINVAL Invalid parameter.
  * @retval -ENOENT Object is not initialized.
  * @retval -ENOMEM Out of memory.
+ * @retval -EPERM The "data" child of a stream object was already closed.
  * @retval -ENOTSUP Action not supported for the object's type.
  * @retval 0 Success; item added.
  */
@@ -558,6 +646,7 @@ int nrf_cloud_obj_object_add(struct nrf_cloud_obj *const obj, const char *const
  * @retval -EINVAL Invalid parameter.
  * @retval -ENOENT Object is not initialized.
  * @retval -ENOMEM Out of memory.
+ * @retval -EPERM The "data" child of a stream object was already closed.
  * @retval -ENOTSUP Action not supported for the object's type.
  * @retval 0 Success; item added.
  */
@@ -578,6 +667,7 @@ int nrf_cloud_obj_int_array_add(struct nrf_cloud_obj *const obj, const char *con
  * @retval -EINVAL Invalid parameter.
  * @retval -ENOENT Object is not initialized.
  * @retval -ENOMEM Out of memory.
+ * @retval -EPERM The "data" child of a stream object was already closed.
  * @retval -ENOTSUP Action not supported for the object's type.
  * @retval 0 Success; item added.
  */
@@ -591,6 +681,8 @@ int nrf_cloud_obj_str_array_add(struct nrf_cloud_obj *const obj, const char *con
  * @details If successful, memory is allocated for the encoded data.
  *          The @ref nrf_cloud_obj_cloud_encoded_free function should
  *          be called when finished with the object.
+ *          Stream objects are only completed, and their encoded data points to the
+ *          object's buffer.
  *
  * @param[out] obj Object to encode.
  *
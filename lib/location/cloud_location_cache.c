@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <date_time.h>
+
+#include "cloud_location_cache.h"
+
+LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
+
+#define CACHE_SIZE		CONFIG_LOCATION_SERVICE_CLOUD_CACHE_SIZE
+#define CACHE_MAX_AGE_MS	(CONFIG_LOCATION_SERVICE_CLOUD_CACHE_MAX_AGE * MSEC_PER_SEC)
+#define CACHE_WIFI_APS		CONFIG_LOCATION_SERVICE_CLOUD_CACHE_WIFI_APS
+#define CACHE_WIFI_MATCH	CONFIG_LOCATION_SERVICE_CLOUD_CACHE_WIFI_MATCH
+
+#define SETTINGS_NAME		"loc_cache"
+#define SETTINGS_KEY_ENTRIES	"entries"
+#define SETTINGS_FULL_ENTRIES	SETTINGS_NAME "/" SETTINGS_KEY_ENTRIES
+
+/* Serving cell and strongest Wi-Fi access points seen when a location was resolved */
+struct cache_fingerprint {
+	uint32_t cell_id;
+	uint32_t tac;
+	uint16_t mcc;
+	uint16_t mnc;
+	uint8_t ap_cnt;
+	uint8_t aps[CACHE_WIFI_APS][WIFI_MAC_ADDR_LEN];
+};
+
+struct cache_entry {
+	struct cache_fingerprint fp;
+	/* UTC time in milliseconds when the location was resolved, 0 if the entry is unused */
+	int64_t timestamp;
+	double latitude;
+	double longitude;
+	float accuracy;
+};
+
+static struct cache_entry cache[CACHE_SIZE];
+static K_MUTEX_DEFINE(cache_mtx);
+
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE_SETTINGS)
+static int cache_settings_set(const char *key, size_t len_rd, settings_read_cb read_cb,
+			      void *cb_arg)
+{
+	int ret = -ENOTSUP;
+
+	if (!key) {
+		return -EINVAL;
+	}
+
+	/* Entries saved with a different cache configuration are ignored */
+	if (!strcmp(key, SETTINGS_KEY_ENTRIES) && (len_rd == sizeof(cache))) {
+		k_mutex_lock(&cache_mtx, K_FOREVER);
+		if (read_cb(cb_arg, (void *)cache, len_rd) == len_rd) {
+			ret = 0;
+		} else {
+			memset(cache, 0, sizeof(cache));
+		}
+		k_mutex_unlock(&cache_mtx);
+	}
+	return ret;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(location_cache, SETTINGS_NAME, NULL, cache_settings_set, NULL,
+			       NULL);
+#endif /* CONFIG_LOCATION_SERVICE_CLOUD_CACHE_SETTINGS */
+
+static bool cache_fingerprint_build(
+	const struct lte_lc_cells_info *cell_data,
+	const struct wifi_scan_info *wifi_data,
+	struct cache_fingerprint *fp)
+{
+	memset(fp, 0, sizeof(*fp));
+
+	if (cell_data != NULL && cell_data->current_cell.id != LTE_LC_CELL_EUTRAN_ID_INVALID) {
+		fp->cell_id = cell_data->current_cell.id;
+		fp->tac = cell_data->current_cell.tac;
+		fp->mcc = cell_data->current_cell.mcc;
+		fp->mnc = cell_data->current_cell.mnc;
+	}
+
+	if (wifi_data != NULL) {
+		int8_t rssi[CACHE_WIFI_APS] = { 0 };
+
+		/* Keep the strongest access points, sorted by descending RSSI */
+		for (int i = 0; i < wifi_data->cnt; i++) {
+			const struct wifi_scan_result *ap = &wifi_data->ap_info[i];
+			int pos = fp->ap_cnt;
+			int keep;
+
+			while (pos > 0 && rssi[pos - 1] < ap->rssi) {
+				pos--;
+			}
+			if (pos == CACHE_WIFI_APS) {
+				continue;
+			}
+
+			keep = MIN(fp->ap_cnt, CACHE_WIFI_APS - 1);
+			memmove(&fp->aps[pos + 1], &fp->aps[pos], (keep - pos) * WIFI_MAC_ADDR_LEN);
+			memmove(&rssi[pos + 1], &rssi[pos], keep - pos);
+			memcpy(fp->aps[pos], ap->mac, WIFI_MAC_ADDR_LEN);
+			rssi[pos] = ap->rssi;
+			fp->ap_cnt = keep + 1;
+		}
+	}
+
+	return fp->cell_id != 0 || fp->ap_cnt > 0;
+}
+
+static bool cache_fingerprint_match(
+	const struct cache_fingerprint *fp,
+	const struct cache_fingerprint *cached)
+{
+	int common = 0;
+
+	if (fp->cell_id != cached->cell_id || fp->tac != cached->tac ||
+	    fp->mcc != cached->mcc || fp->mnc != cached->mnc) {
+		return false;
+	}
+
+	/* A location resolved with Wi-Fi is not used for a cellular only request,
+	 * and the other way around, because their accuracy differs a lot.
+	 */
+	if (fp->ap_cnt == 0 || cached->ap_cnt == 0) {
+		return fp->ap_cnt == cached->ap_cnt;
+	}
+
+	/* The order of the strongest access points varies between scans */
+	for (int i = 0; i < fp->ap_cnt; i++) {
+		for (int j = 0; j < cached->ap_cnt; j++) {
+			if (!memcmp(fp->aps[i], cached->aps[j], WIFI_MAC_ADDR_LEN)) {
+				common++;
+				break;
+			}
+		}
+	}
+
+	return common >= MIN(CACHE_WIFI_MATCH, MIN(fp->ap_cnt, cached->ap_cnt));
+}
+
+int cloud_location_cache_get(
+	const struct lte_lc_cells_info *cell_data,
+	const struct wifi_scan_info *wifi_data,
+	struct location_data *location,
+	uint32_t *age)
+{
+	struct cache_fingerprint fp;
+	struct cache_entry *found = NULL;
+	int64_t now;
+
+	if (date_time_now(&now)) {
+		return -ENODATA;
+	}
+
+	if (!cache_fingerprint_build(cell_data, wifi_data, &fp)) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&cache_mtx, K_FOREVER);
+
+	for (int i = 0; i < CACHE_SIZE; i++) {
+		struct cache_entry *entry = &cache[i];
+
+		if (entry->timestamp == 0 || entry->timestamp > now ||
+		    now - entry->timestamp > CACHE_MAX_AGE_MS) {
+			continue;
+		}
+
+		if (cache_fingerprint_match(&fp, &entry->fp) &&
+		    (found == NULL || entry->timestamp > found->timestamp)) {
+			found = entry;
+		}
+	}
+
+	if (found != NULL) {
+		location->latitude = found->latitude;
+		location->longitude = found->longitude;
+		location->accuracy = found->accuracy;
+		*age = (uint32_t)((now - found->timestamp) / MSEC_PER_SEC);
+	}
+
+	k_mutex_unlock(&cache_mtx);
+
+	return found != NULL ? 0 : -ENOENT;
+}
+
+void cloud_location_cache_put(
+	const struct lte_lc_cells_info *cell_data,
+	const struct wifi_scan_info *wifi_data,
+	const struct location_data *location)
+{
+	struct cache_fingerprint fp;
+	struct cache_entry *entry = NULL;
+	int64_t now;
+
+	if (date_time_now(&now) || !cache_fingerprint_build(cell_data, wifi_data, &fp)) {
+		return;
+	}
+
+	k_mutex_lock(&cache_mtx, K_FOREVER);
+
+	/* Replace the location of the same place, or the oldest one */
+	for (int i = 0; i < CACHE_SIZE; i++) {
+		if (cache[i].timestamp != 0 && cache_fingerprint_match(&fp, &cache[i].fp)) {
+			entry = &cache[i];
+			break;
+		}
+		if (entry == NULL || cache[i].timestamp < entry->timestamp) {
+			entry = &cache[i];
+		}
+	}
+
+	entry->fp = fp;
+	entry->timestamp = now;
+	entry->latitude = location->latitude;
+	entry->longitude = location->longitude;
+	entry->accuracy = location->accuracy;
+
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE_SETTINGS)
+	int err = settings_save_one(SETTINGS_FULL_ENTRIES, cache, sizeof(cache));
+
+	if (err) {
+		LOG_WRN("Failed to save location cache, error: %d", err);
+	}
+#endif
+
+	k_mutex_unlock(&cache_mtx);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CLOUD_LOCATION_CACHE_H_
+#define CLOUD_LOCATION_CACHE_H_
+
+#include <modem/location.h>
+#include <modem/lte_lc.h>
+#include <net/wifi_location_common.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Look up a location resolved earlier from matching scanning results.
+ *
+ * The serving cell and the strongest Wi-Fi access points of the scanning results are
+ * compared against those of the cached locations.
+ *
+ * @param[in] cell_data Neighbor cell data, or NULL.
+ * @param[in] wifi_data Wi-Fi scanning results data, or NULL.
+ * @param[out] location Cached latitude, longitude and accuracy.
+ * @param[out] age Time since the cached location was resolved, in seconds.
+ *
+ * @return 0 if a matching location was found, or negative error code otherwise.
+ * @retval -ENOENT No matching location in the cache.
+ * @retval -ENODATA Current time is not known.
+ */
+int cloud_location_cache_get(
+	const struct lte_lc_cells_info *cell_data,
+	const struct wifi_scan_info *wifi_data,
+	struct location_data *location,
+	uint32_t *age);
+
+/**
+ * @brief Store a location resolved by the location service from the given scanning results.
+ *
+ * Replaces a cached location with a matching fingerprint, or the oldest one.
+ *
+ * @param[in] cell_data Neighbor cell data, or NULL.
+ * @param[in] wifi_data Wi-Fi scanning results data, or NULL.
+ * @param[in] location Location returned by the location service.
+ */
+void cloud_location_cache_put(
+	const struct lte_lc_cells_info *cell_data,
+	const struct wifi_scan_info *wifi_data,
+	const struct location_data *location);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLOUD_LOCATION_CACHE_H_ */
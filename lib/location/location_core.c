@@ -582,6 +582,13 @@ static void location_core_event_details_get(struct location_event_data *event)
 
 		location_method_api_get(loc_req_info.current_method)->details_get(details);
 
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE)
+		details->cloud_cache_age = -1;
+		if (loc_req_info.current_method != LOCATION_METHOD_GNSS) {
+			details->cloud_cache_age = method_cloud_location_cache_age_get();
+		}
+#endif
+
 		details->elapsed_time_method = (uint32_t)
 			(k_uptime_get() - loc_req_info.elapsed_time_method_start_timestamp);
 	}
@@ -16,6 +16,9 @@
 #include "scan_cellular.h"
 #include "scan_wifi.h"
 #include "cloud_service.h"
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE)
+#include "cloud_location_cache.h"
+#endif
 
 LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
 
@@ -42,11 +45,29 @@ struct method_cloud_location_start_work_args {
 
 static struct method_cloud_location_start_work_args method_cloud_location_start_work;
 static bool running;
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE)
+static int32_t cloud_cache_age;
+#endif
 
 #if defined(CONFIG_LOCATION_METHOD_WIFI)
 static K_SEM_DEFINE(wifi_scan_ready, 0, 1);
 #endif
 
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR_WIFI_EARLY_FINISH)
+static void method_cloud_location_wifi_done(const struct wifi_scan_info *scan_info)
+{
+	/* Wi-Fi positioning is far more accurate than cellular positioning, so once enough
+	 * access points are found, cell measurements are finished with the cells found so far
+	 * instead of waiting for the time consuming GCI searches. This runs in the Wi-Fi scan
+	 * event callback, so scan_cellular_finish() only requests the finish and the ongoing
+	 * search is stopped in the location workqueue.
+	 */
+	if (scan_info->cnt >= CONFIG_LOCATION_METHOD_CELLULAR_WIFI_EARLY_FINISH_AP_COUNT) {
+		scan_cellular_finish();
+	}
+}
+#endif
+
 static void method_cloud_location_positioning_work_fn(struct k_work *work)
 {
 	struct method_cloud_location_start_work_args *work_data =
@@ -61,11 +82,21 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 	struct lte_lc_cells_info *scan_cellular_info = NULL;
 	int err = 0;
 
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE)
+	cloud_cache_age = -1;
+#endif
 #if defined(CONFIG_LOCATION_METHOD_WIFI)
 	k_sem_reset(&wifi_scan_ready);
 
 	if (wifi_config != NULL) {
-		scan_wifi_execute(wifi_config->timeout, &wifi_scan_ready);
+		scan_wifi_done_handler_t done_handler = NULL;
+
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR_WIFI_EARLY_FINISH)
+		if (cell_config != NULL) {
+			done_handler = method_cloud_location_wifi_done;
+		}
+#endif
+		scan_wifi_execute(wifi_config->timeout, &wifi_scan_ready, done_handler);
 	}
 #endif
 
@@ -114,6 +145,24 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 		.timeout_ms = SYS_FOREVER_MS
 	};
 
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE)
+	uint32_t age;
+
+	/* A stationary device sees the same cell and access points as when its location
+	 * was last resolved, so there is no need to connect to the location service.
+	 */
+	if (!cloud_location_cache_get(scan_cellular_info, scan_wifi_info, &location, &age)) {
+		LOG_DBG("Using cached location resolved %u seconds ago", age);
+		cloud_cache_age = MIN(age, INT32_MAX);
+		location_utils_systime_to_location_datetime(&location_result.datetime);
+		location_result.latitude = location.latitude;
+		location_result.longitude = location.longitude;
+		location_result.accuracy = location.accuracy;
+		location_core_event_cb(&location_result);
+		goto end;
+	}
+#endif
+
 	if (IS_ENABLED(CONFIG_NRF_MODEM_LIB) && !location_utils_is_lte_available()) {
 		/* Not worth to start trying to fetch the location over LTE.
 		 * Thus, fail faster in this case and save the trying "costs".
@@ -143,6 +192,9 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 	if (err) {
 		LOG_ERR("Failed to acquire location using cloud location, error: %d", err);
 	} else {
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE)
+		cloud_location_cache_put(scan_cellular_info, scan_wifi_info, &location);
+#endif
 		location_result.latitude = location.latitude;
 		location_result.longitude = location.longitude;
 		location_result.accuracy = location.accuracy;
@@ -220,9 +272,19 @@ void method_cloud_location_details_get(struct location_data_details *details)
 }
 #endif
 
+#if defined(CONFIG_LOCATION_DATA_DETAILS) && defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE)
+int32_t method_cloud_location_cache_age_get(void)
+{
+	return cloud_cache_age;
+}
+#endif
+
 int method_cloud_location_init(void)
 {
 	running = false;
+#if defined(CONFIG_LOCATION_SERVICE_CLOUD_CACHE)
+	cloud_cache_age = -1;
+#endif
 
 	return 0;
 }
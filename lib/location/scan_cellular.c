@@ -38,6 +38,11 @@ static struct lte_lc_cells_info scan_cellular_info = {
 
 static volatile bool running;
 static volatile bool timeout_occurred;
+/* Set when the caller has enough data and only the ongoing search is completed */
+static volatile bool finish_requested;
+static volatile bool gci_search_ongoing;
+/* Set when the NCELLMEAS notification of the ongoing search has been received */
+static volatile bool ncellmeas_received;
 /* Indicates when individual ncellmeas operation is completed. This is internal to this file. */
 static struct k_sem scan_cellular_sem_ncellmeas_evt;
 
@@ -123,6 +128,7 @@ void scan_cellular_lte_ind_handler(const struct lte_lc_evt *const evt)
 			LOG_DBG("No surrounding cell information from modem");
 		}
 
+		ncellmeas_received = true;
 		k_sem_give(&scan_cellular_sem_ncellmeas_evt);
 	} break;
 	case LTE_LC_EVT_RRC_UPDATE:
@@ -139,6 +145,36 @@ void scan_cellular_lte_ind_handler(const struct lte_lc_evt *const evt)
 	}
 }
 
+/* Start a neighbor cell search */
+static int scan_cellular_ncellmeas_start(struct lte_lc_ncellmeas_params *params)
+{
+	ncellmeas_received = false;
+
+	return lte_lc_neighbor_cell_measurement(params);
+}
+
+/* Wait for the NCELLMEAS notification of an ongoing GCI search.
+ *
+ * scan_cellular_finish() wakes this up without a notification. The GCI search is then
+ * stopped from here, so that the AT command is not sent from the context that requested
+ * the finish. Stopping the search triggers a NCELLMEAS notification with the cells found
+ * so far.
+ */
+static int scan_cellular_gci_wait(void)
+{
+	int err;
+
+	while (true) {
+		err = k_sem_take(&scan_cellular_sem_ncellmeas_evt, K_FOREVER);
+		if (err || ncellmeas_received) {
+			return err;
+		}
+
+		LOG_DBG("Finish requested, stopping GCI search");
+		(void)lte_lc_neighbor_cell_measurement_cancel();
+	}
+}
+
 void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 {
 	struct lte_lc_ncellmeas_params ncellmeas_params = {
@@ -150,6 +186,10 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 
 	running = true;
 	timeout_occurred = false;
+	finish_requested = false;
+	gci_search_ongoing = false;
+	/* Discard a wakeup by scan_cellular_finish() that was not needed in the previous search */
+	k_sem_reset(&scan_cellular_sem_ncellmeas_evt);
 	scan_cellular_info.current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
 	scan_cellular_info.ncells_count = 0;
 	scan_cellular_info.gci_cells_count = 0;
@@ -166,7 +206,7 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 	 *      In addition neighbor cells are received.
 	 */
 	LOG_DBG("Normal neighbor search (NCELLMEAS=1)");
-	err = lte_lc_neighbor_cell_measurement(&ncellmeas_params);
+	err = scan_cellular_ncellmeas_start(&ncellmeas_params);
 	if (err) {
 		LOG_ERR("Failed to initiate neighbor cell measurements: %d", err);
 		goto end;
@@ -188,6 +228,12 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 		goto end;
 	}
 
+	gci_search_ongoing = true;
+	if (finish_requested) {
+		LOG_DBG("Finish requested, skipping GCI searches");
+		goto end;
+	}
+
 	/* GCI searches are not done when in RRC connected mode. We are waiting for
 	 * device to enter RRC idle mode unless it's there already.
 	 */
@@ -196,8 +242,10 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 		"RRC already in idle mode");
 
 	if (k_sem_take(&entered_rrc_idle, K_SECONDS(SCAN_CELLULAR_RRC_IDLE_WAIT_TIME)) != 0) {
-		/* If semaphore is reset while waiting, the position request was canceled */
-		if (!running) {
+		/* If semaphore is reset while waiting, the position request was canceled
+		 * or finish was requested
+		 */
+		if (!running || finish_requested) {
 			goto end;
 		}
 		/* The wait for RRC idle timed out */
@@ -207,6 +255,14 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 	}
 	k_sem_give(&entered_rrc_idle);
 
+	/* Finish may have been requested while the semaphore was taken, in which case
+	 * scan_cellular_finish() could not unblock the wait.
+	 */
+	if (!running || finish_requested) {
+		LOG_DBG("Finish requested, skipping GCI searches");
+		goto end;
+	}
+
 	/*****
 	 * 2nd: GCI history search to get GCI cells we can quickly search and measure.
 	 *      Because history search is quick and very power efficient, we request
@@ -218,7 +274,7 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 	ncellmeas_params.search_type = LTE_LC_NEIGHBOR_SEARCH_TYPE_GCI_DEFAULT;
 	ncellmeas_params.gci_count = ncellmeas3_cell_count;
 
-	err = lte_lc_neighbor_cell_measurement(&ncellmeas_params);
+	err = scan_cellular_ncellmeas_start(&ncellmeas_params);
 	if (err) {
 		LOG_WRN("Failed to initiate GCI cell measurements: %d", err);
 		/* Clearing 'err' because previous neighbor search has succeeded
@@ -227,7 +283,7 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 		err = 0;
 		goto end;
 	}
-	err = k_sem_take(&scan_cellular_sem_ncellmeas_evt, K_FOREVER);
+	err = scan_cellular_gci_wait();
 	if (err) {
 		/* Semaphore was reset so stop search procedure */
 		err = 0;
@@ -237,6 +293,10 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 		LOG_DBG("Timeout occurred after 2nd neighbor measurement");
 		goto end;
 	}
+	if (finish_requested) {
+		LOG_DBG("Finish requested after 2nd neighbor measurement");
+		goto end;
+	}
 
 	/* If we received already enough GCI cells including current cell */
 	if (scan_cellular_info.gci_cells_count + 1 >= cell_count) {
@@ -252,7 +312,7 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 	ncellmeas_params.search_type = LTE_LC_NEIGHBOR_SEARCH_TYPE_GCI_EXTENDED_LIGHT;
 	ncellmeas_params.gci_count = cell_count;
 
-	err = lte_lc_neighbor_cell_measurement(&ncellmeas_params);
+	err = scan_cellular_ncellmeas_start(&ncellmeas_params);
 	if (err) {
 		LOG_WRN("Failed to initiate GCI cell measurements: %d", err);
 		/* Clearing 'err' because previous neighbor search has succeeded
@@ -261,13 +321,37 @@ void scan_cellular_execute(int32_t timeout, uint8_t cell_count)
 		err = 0;
 		goto end;
 	}
-	k_sem_take(&scan_cellular_sem_ncellmeas_evt, K_FOREVER);
+	(void)scan_cellular_gci_wait();
 
 end:
 	k_work_cancel_delayable(&scan_cellular_timeout_work);
+	gci_search_ongoing = false;
 	running = false;
 }
 
+void scan_cellular_finish(void)
+{
+	if (!running) {
+		return;
+	}
+
+	LOG_DBG("Finishing cell measurements with the results found so far");
+	finish_requested = true;
+
+	/* This is called from the Wi-Fi scan event callback, so the blocking AT command to
+	 * stop a GCI search is sent by scan_cellular_execute() in the location workqueue.
+	 * The normal neighbor search providing the current cell is always completed.
+	 */
+	if (gci_search_ongoing) {
+		k_sem_give(&scan_cellular_sem_ncellmeas_evt);
+
+		/* Unblock the wait for RRC idle mode without losing the current RRC state */
+		if (!k_sem_count_get(&entered_rrc_idle)) {
+			k_sem_reset(&entered_rrc_idle);
+		}
+	}
+}
+
 int scan_cellular_cancel(void)
 {
 	int rrc_idling;
@@ -13,6 +13,7 @@ int scan_cellular_init(void);
 void scan_cellular_execute(int32_t timeout, uint8_t cell_count);
 struct lte_lc_cells_info *scan_cellular_results_get(void);
 int scan_cellular_cancel(void);
+void scan_cellular_finish(void);
 #if defined(CONFIG_LOCATION_DATA_DETAILS)
 void scan_cellular_details_get(struct location_data_details *details);
 #endif
@@ -27,6 +27,7 @@ static struct wifi_scan_info scan_wifi_info = {
 	.ap_info = scan_results,
 };
 static struct k_sem *scan_wifi_ready;
+static scan_wifi_done_handler_t scan_wifi_done_handler;
 
 /** Handler for timeout. */
 static void scan_wifi_timeout_work_fn(struct k_work *work);
@@ -97,11 +98,13 @@ static int scan_wifi_startup_interface(struct net_if *iface)
 }
 #endif /* defined(CONFIG_LOCATION_METHOD_WIFI_NET_IF_UPDOWN) */
 
-void scan_wifi_execute(int32_t timeout, struct k_sem *wifi_scan_ready)
+void scan_wifi_execute(int32_t timeout, struct k_sem *wifi_scan_ready,
+		       scan_wifi_done_handler_t done_handler)
 {
 	int ret;
 
 	scan_wifi_ready = wifi_scan_ready;
+	scan_wifi_done_handler = done_handler;
 
 	LOG_DBG("Triggering start of Wi-Fi scanning");
 
@@ -165,6 +168,10 @@ static void scan_wifi_done_handle(struct net_mgmt_event_callback *cb)
 		LOG_WRN("Wi-Fi scan request failed (%d)", status->status);
 	} else {
 		LOG_DBG("Scan request done with %d Wi-Fi APs", scan_wifi_info.cnt);
+
+		if (scan_wifi_done_handler != NULL) {
+			scan_wifi_done_handler(&scan_wifi_info);
+		}
 	}
 
 	k_sem_give(scan_wifi_ready);
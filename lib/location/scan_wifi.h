@@ -10,8 +10,12 @@
 #include <modem/location.h>
 #include <net/wifi_location_common.h>
 
+/** Handler called from the network management event context when scanning is done. */
+typedef void (*scan_wifi_done_handler_t)(const struct wifi_scan_info *scan_info);
+
 int scan_wifi_init(void);
-void scan_wifi_execute(int32_t timeout, struct k_sem *wifi_scan_ready);
+void scan_wifi_execute(int32_t timeout, struct k_sem *wifi_scan_ready,
+		       scan_wifi_done_handler_t done_handler);
 struct wifi_scan_info *scan_wifi_results_get(void);
 int scan_wifi_cancel(void);
 #if defined(CONFIG_LOCATION_DATA_DETAILS)
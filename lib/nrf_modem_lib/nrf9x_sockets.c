@@ -46,11 +46,16 @@
 #define OBJ_TO_SD(obj) (((struct nrf_sock_ctx *)obj)->nrf_fd)
 #define OBJ_TO_CTX(obj) ((struct nrf_sock_ctx *)obj)
 
-/* Offloading context related to nRF socket. */
+/* Offloading context related to nRF socket.
+ * The context of an nRF socket descriptor is stored at the index of the descriptor
+ * whenever possible, so that it is found without searching the table.
+ */
 static struct nrf_sock_ctx {
 	int nrf_fd; /* nRF socket descriptior. */
 	struct k_mutex *lock; /* Mutex associated with the socket. */
 	struct k_poll_signal poll; /* poll() signal. */
+	struct k_mutex sendmsg_lock; /* Mutex protecting sendmsg_buf. */
+	uint8_t sendmsg_buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE]; /* sendmsg() buffer. */
 } offload_ctx[NRF_MODEM_MAX_SOCKET_COUNT];
 
 static K_MUTEX_DEFINE(ctx_lock);
@@ -62,12 +67,23 @@ static bool offload_disabled;
 /* TLS offloading disabled only. */
 static bool tls_offload_disabled;
 
+static bool nrf_fd_is_index(int nrf_fd)
+{
+	return (nrf_fd >= 0) && (nrf_fd < ARRAY_SIZE(offload_ctx));
+}
+
 static struct nrf_sock_ctx *allocate_ctx(int nrf_fd)
 {
 	struct nrf_sock_ctx *ctx = NULL;
 
 	k_mutex_lock(&ctx_lock, K_FOREVER);
 
+	if (nrf_fd_is_index(nrf_fd) && offload_ctx[nrf_fd].nrf_fd == -1) {
+		ctx = &offload_ctx[nrf_fd];
+		ctx->nrf_fd = nrf_fd;
+		goto out;
+	}
+
 	for (int i = 0; i < ARRAY_SIZE(offload_ctx); i++) {
 		if (offload_ctx[i].nrf_fd == -1) {
 			ctx = &offload_ctx[i];
@@ -76,6 +92,7 @@ static struct nrf_sock_ctx *allocate_ctx(int nrf_fd)
 		}
 	}
 
+out:
 	k_mutex_unlock(&ctx_lock);
 
 	return ctx;
@@ -666,81 +683,90 @@ static ssize_t nrf9x_socket_offload_sendto(void *obj, const void *buf,
 	return retval;
 }
 
+static ssize_t sendmsg_buf_flush(void *obj, const uint8_t *data, size_t len, int flags,
+				 const struct msghdr *msg)
+{
+	size_t offset = 0;
+	ssize_t ret;
+
+	while (offset < len) {
+		ret = nrf9x_socket_offload_sendto(obj, data + offset, len - offset, flags,
+						  msg->msg_name, msg->msg_namelen);
+		if (ret < 0) {
+			return ret;
+		}
+		offset += ret;
+	}
+
+	return offset;
+}
+
 static ssize_t nrf9x_socket_offload_sendmsg(void *obj, const struct msghdr *msg,
 					    int flags)
 {
+	struct nrf_sock_ctx *ctx = OBJ_TO_CTX(obj);
 	ssize_t len = 0;
-	ssize_t ret;
-	ssize_t offset;
-	int i;
-	static K_MUTEX_DEFINE(sendmsg_lock);
-	static uint8_t buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE];
+	ssize_t ret = 0;
+	size_t used = 0;
 
 	if (msg == NULL) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	/* Try to reduce number of `sendto` calls - copy data if they fit into
-	 * a single buffer
+	/* The socket lock is released while sending, so the buffer of the socket
+	 * is protected by its own mutex. Sockets do not wait for each other.
 	 */
+	k_mutex_lock(&ctx->sendmsg_lock, K_FOREVER);
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		len += msg->msg_iov[i].iov_len;
-	}
-
-	if (len <= sizeof(buf)) {
-		/* Protect `buf` access with a mutex. */
-		k_mutex_lock(&sendmsg_lock, K_FOREVER);
-		len = 0;
+	/* Try to reduce number of `sendto` calls - gather the message parts into
+	 * the buffer of the socket, and send parts that fill the buffer directly.
+	 */
+	for (int i = 0; i < msg->msg_iovlen; i++) {
+		const uint8_t *data = msg->msg_iov[i].iov_base;
+		size_t remaining = msg->msg_iov[i].iov_len;
 
-		for (i = 0; i < msg->msg_iovlen; i++) {
-			memcpy(buf + len, msg->msg_iov[i].iov_base,
-			       msg->msg_iov[i].iov_len);
-			len += msg->msg_iov[i].iov_len;
-		}
+		while (remaining > 0) {
+			size_t part;
 
-		offset = 0;
-		ret = 0;
-		while ((offset < len) && (ret >= 0)) {
-			ret = nrf9x_socket_offload_sendto(obj,
-				(buf + offset), (len - offset), flags,
-				msg->msg_name, msg->msg_namelen);
-			if (ret > 0) {
-				offset += ret;
+			if (used == 0 && remaining >= sizeof(ctx->sendmsg_buf)) {
+				ret = sendmsg_buf_flush(obj, data, remaining, flags, msg);
+				if (ret < 0) {
+					goto out;
+				}
+				len += ret;
+				break;
 			}
-		}
-
-		k_mutex_unlock(&sendmsg_lock);
-		return ret;
-	}
-
-	/* If the data won't fit into intermediate buffer, send the buffers
-	 * separately
-	 */
 
-	len = 0;
+			part = MIN(remaining, sizeof(ctx->sendmsg_buf) - used);
+			memcpy(ctx->sendmsg_buf + used, data, part);
+			used += part;
+			data += part;
+			remaining -= part;
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		if (msg->msg_iov[i].iov_len == 0) {
-			continue;
+			if (used == sizeof(ctx->sendmsg_buf)) {
+				ret = sendmsg_buf_flush(obj, ctx->sendmsg_buf, used, flags, msg);
+				if (ret < 0) {
+					goto out;
+				}
+				len += ret;
+				used = 0;
+			}
 		}
+	}
 
-		offset = 0;
-		while (offset < msg->msg_iov[i].iov_len) {
-			ret = nrf9x_socket_offload_sendto(obj,
-				(((uint8_t *) msg->msg_iov[i].iov_base) + offset),
-				(msg->msg_iov[i].iov_len - offset), flags,
-				msg->msg_name, msg->msg_namelen);
-			if (ret < 0) {
-				return ret;
-			}
-			offset += ret;
-			len += ret;
+	if (used > 0) {
+		ret = sendmsg_buf_flush(obj, ctx->sendmsg_buf, used, flags, msg);
+		if (ret < 0) {
+			goto out;
 		}
+		len += ret;
 	}
 
-	return len;
+	ret = len;
+out:
+	k_mutex_unlock(&ctx->sendmsg_lock);
+	return ret;
 }
 
 static void nrf9x_socket_offload_freeaddrinfo(struct zsock_addrinfo *root)
@@ -857,8 +883,15 @@ static int nrf9x_socket_offload_fcntl(int fd, int cmd, va_list args)
 	return retval;
 }
 
+/* Called from the poll callback without taking ctx_lock. A context is found
+ * directly by its index, unless its slot was taken when it was allocated.
+ */
 static struct nrf_sock_ctx *find_ctx(int fd)
 {
+	if (nrf_fd_is_index(fd) && offload_ctx[fd].nrf_fd == fd) {
+		return &offload_ctx[fd];
+	}
+
 	for (size_t i = 0; i < ARRAY_SIZE(offload_ctx); i++) {
 		if (offload_ctx[i].nrf_fd == fd) {
 			return &offload_ctx[i];
@@ -1122,6 +1155,7 @@ static int nrf9x_socket_offload_init(const struct device *arg)
 
 	for (int i = 0; i < ARRAY_SIZE(offload_ctx); i++) {
 		offload_ctx[i].nrf_fd = -1;
+		k_mutex_init(&offload_ctx[i].sendmsg_lock);
 	}
 
 	return 0;
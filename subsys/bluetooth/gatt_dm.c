@@ -5,8 +5,14 @@
  */
 
 #include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
 
 #include <bluetooth/gatt_dm.h>
 
@@ -44,6 +50,8 @@ SYS_INIT(gatt_dm_wq_init, POST_KERNEL, CONFIG_BT_GATT_DM_WORKQ_INIT_PRIO);
 enum {
 	STATE_ATTRS_LOCKED,
 	STATE_ATTRS_RELEASE_PENDING,
+	STATE_DB_HASH_VALID,
+	STATE_CACHE_REPLAYED,
 	STATE_NUM
 };
 
@@ -55,6 +63,12 @@ struct data_chunk_item {
 	uint8_t data[CHUNK_DATA_SIZE];
 };
 
+#if defined(CONFIG_BT_GATT_DM_DATA_ALLOC_SLAB)
+/* Memory slab used for user data chunks */
+K_MEM_SLAB_DEFINE_STATIC(data_chunk_slab, sizeof(struct data_chunk_item),
+			 CONFIG_BT_GATT_DM_DATA_SLAB_COUNT, DATA_ALIGN);
+#endif
+
 /* The instance structure real declaration */
 struct bt_gatt_dm {
 	/* Connection object */
@@ -68,6 +82,10 @@ struct bt_gatt_dm {
 	struct bt_gatt_dm_attr attrs[CONFIG_BT_GATT_DM_MAX_ATTRS];
 	/* Currently accessed attribute */
 	size_t cur_attr_id;
+	/* Indexes of the characteristic declarations in the attrs array */
+	uint16_t chrc_ids[CONFIG_BT_GATT_DM_MAX_ATTRS];
+	/* Number of the characteristic declarations */
+	size_t chrc_cnt;
 	/* Flags with the status of the attributes */
 	ATOMIC_DEFINE(state_flags, STATE_NUM);
 
@@ -92,11 +110,46 @@ struct bt_gatt_dm {
 
 	/* Work item used for discovery callbacks. */
 	struct k_work discover_work;
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	/* GATT read parameters used to read the peer Database Hash. */
+	struct bt_gatt_read_params db_hash_read_params;
+	/* Peer Database Hash, valid if STATE_DB_HASH_VALID is set. */
+	uint8_t db_hash[16];
+	/* Start handle of the discovery, part of the cache key. */
+	uint16_t cache_start_handle;
+#endif
 };
 
 /* Currently only one instance is supported */
 static struct bt_gatt_dm bt_gatt_dm_inst;
 
+static struct data_chunk_item *data_chunk_alloc(void)
+{
+	struct data_chunk_item *item;
+
+#if defined(CONFIG_BT_GATT_DM_DATA_ALLOC_SLAB)
+	if (k_mem_slab_alloc(&data_chunk_slab, (void **)&item, K_NO_WAIT)) {
+		return NULL;
+	}
+
+	memset(item, 0, sizeof(*item));
+#else
+	item = k_calloc(1, sizeof(*item));
+#endif
+
+	return item;
+}
+
+static void data_chunk_free(struct data_chunk_item *item)
+{
+#if defined(CONFIG_BT_GATT_DM_DATA_ALLOC_SLAB)
+	k_mem_slab_free(&data_chunk_slab, item);
+#else
+	k_free(item);
+#endif
+}
+
 /* Returns pointer to newly allocated space in a dm->data_chunk */
 static void *user_data_alloc(struct bt_gatt_dm *dm,
 			     size_t len)
@@ -114,7 +167,7 @@ static void *user_data_alloc(struct bt_gatt_dm *dm,
 	if (sys_slist_is_empty(&dm->chunk_list) ||
 	    dm->cur_chunk_len + len > CHUNK_DATA_SIZE) {
 
-		item = k_calloc(1, sizeof(struct data_chunk_item));
+		item = data_chunk_alloc();
 
 		if (!item) {
 			return NULL;
@@ -145,12 +198,13 @@ static void svc_attr_memory_release(struct bt_gatt_dm *dm)
 
 	/* Clear attributes */
 	dm->cur_attr_id = 0;
+	dm->chrc_cnt = 0;
 
 	/* Release dynamic memory data chunks */
 	while (!sys_slist_is_empty(&dm->chunk_list)) {
 		node = sys_slist_get_not_empty(&dm->chunk_list);
 		item = CONTAINER_OF(node, struct data_chunk_item, node);
-		k_free(item);
+		data_chunk_free(item);
 	}
 
 	dm->cur_chunk_len = 0;
@@ -216,6 +270,10 @@ static struct bt_gatt_dm_attr *attr_store(struct bt_gatt_dm *dm,
 
 	memcpy(cur_attr->uuid, attr->uuid, uuid_size);
 
+	if (bt_uuid_cmp(cur_attr->uuid, BT_UUID_GATT_CHRC) == 0) {
+		dm->chrc_ids[dm->chrc_cnt++] = cur_attr - dm->attrs;
+	}
+
 	return cur_attr;
 }
 
@@ -268,9 +326,853 @@ static struct bt_gatt_dm_attr *attr_find_by_handle(
 	return NULL;
 }
 
+static void discovery_work_submit(struct bt_gatt_dm *dm, struct k_work *work)
+{
+#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
+	k_work_submit_to_queue(&bt_gatt_dm_wq, work);
+#else
+	k_work_submit(work);
+#endif
+}
+
+static void discovery_complete(struct bt_gatt_dm *dm);
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+#define CACHE_KEY_PREFIX "bt_dm"
+#define CACHE_KEY_LEN 64
+#define CACHE_VERSION 2
+/* Version, use sequence number, Database Hash, end handle and attribute count */
+#define CACHE_HDR_LEN (1 + sizeof(uint32_t) + 16 + 2 * sizeof(uint16_t))
+#define CACHE_SEQ_OFFSET 1
+
+/* Buffer shared by the cache replay and store. Only one discovery runs at
+ * a time and the store is written from the same workqueue that later runs
+ * the replay, so the buffer is never used simultaneously.
+ */
+NET_BUF_SIMPLE_DEFINE_STATIC(cache_buf, CONFIG_BT_GATT_DM_CACHE_ENTRY_SIZE);
+static char cache_store_key[CACHE_KEY_LEN];
+static atomic_t cache_store_pending;
+/* The stored entry is a restored one that only needs a new sequence number. */
+static bool cache_store_touch;
+/* Largest use sequence number of the cached entries, or 0 if not known yet.
+ * Only accessed from the workqueue.
+ */
+static uint32_t cache_seq;
+
+static void cache_store_work_handler(struct k_work *work);
+static K_WORK_DEFINE(cache_store_work, cache_store_work_handler);
+
+union cache_uuid {
+	struct bt_uuid uuid;
+	struct bt_uuid_16 u16;
+	struct bt_uuid_32 u32;
+	struct bt_uuid_128 u128;
+};
+
+static bool cache_addr_supported(const bt_addr_le_t *addr)
+{
+	/* Resolvable private addresses change over time and would only
+	 * pollute the cache.
+	 */
+	return !bt_addr_le_is_rpa(addr);
+}
+
+static int cache_addr_key_get(const bt_addr_le_t *addr, char *key, size_t key_size)
+{
+	char addr_str[2 * sizeof(bt_addr_le_t) + 1];
+	int ret;
+
+	bin2hex((const uint8_t *)addr, sizeof(*addr), addr_str, sizeof(addr_str));
+
+	ret = snprintf(key, key_size, CACHE_KEY_PREFIX "/%s", addr_str);
+	if ((ret < 0) || (ret >= key_size)) {
+		return -ENAMETOOLONG;
+	}
+
+	return ret;
+}
+
+static int cache_key_get(const struct bt_gatt_dm *dm, char *key, size_t key_size)
+{
+	char uuid_str[2 * BT_UUID_SIZE_128 + 1] = "any";
+	int len;
+	int ret;
+
+	if (dm->search_svc_by_uuid) {
+		switch (dm->svc_uuid.uuid.type) {
+		case BT_UUID_TYPE_16:
+			snprintf(uuid_str, sizeof(uuid_str), "%04x", dm->svc_uuid.u16.val);
+			break;
+		case BT_UUID_TYPE_128:
+			bin2hex(dm->svc_uuid.u128.val, sizeof(dm->svc_uuid.u128.val), uuid_str,
+				sizeof(uuid_str));
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	len = cache_addr_key_get(bt_conn_get_dst(dm->conn), key, key_size);
+	if (len < 0) {
+		return len;
+	}
+
+	ret = snprintf(&key[len], key_size - len, "/%s_%04x", uuid_str,
+		       dm->cache_start_handle);
+	if ((ret < 0) || (ret >= (key_size - len))) {
+		return -ENAMETOOLONG;
+	}
+
+	return 0;
+}
+
+static int cache_uuid_push(struct net_buf_simple *buf, const struct bt_uuid *uuid)
+{
+	size_t uuid_size = get_uuid_size(uuid);
+	size_t val_size = uuid_size - sizeof(struct bt_uuid);
+
+	if ((uuid_size == 0) || (net_buf_simple_tailroom(buf) < (1 + val_size))) {
+		return -ENOMEM;
+	}
+
+	net_buf_simple_add_u8(buf, uuid->type);
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		net_buf_simple_add_le16(buf, BT_UUID_16(uuid)->val);
+		break;
+	case BT_UUID_TYPE_32:
+		net_buf_simple_add_le32(buf, BT_UUID_32(uuid)->val);
+		break;
+	default:
+		net_buf_simple_add_mem(buf, BT_UUID_128(uuid)->val, BT_UUID_SIZE_128);
+		break;
+	}
+
+	return 0;
+}
+
+static int cache_uuid_pull(struct net_buf_simple *buf, union cache_uuid *uuid)
+{
+	if (buf->len < 1) {
+		return -EINVAL;
+	}
+
+	uuid->uuid.type = net_buf_simple_pull_u8(buf);
+
+	switch (uuid->uuid.type) {
+	case BT_UUID_TYPE_16:
+		if (buf->len < sizeof(uint16_t)) {
+			return -EINVAL;
+		}
+		uuid->u16.val = net_buf_simple_pull_le16(buf);
+		break;
+	case BT_UUID_TYPE_32:
+		if (buf->len < sizeof(uint32_t)) {
+			return -EINVAL;
+		}
+		uuid->u32.val = net_buf_simple_pull_le32(buf);
+		break;
+	case BT_UUID_TYPE_128:
+		if (buf->len < BT_UUID_SIZE_128) {
+			return -EINVAL;
+		}
+		memcpy(uuid->u128.val, net_buf_simple_pull_mem(buf, BT_UUID_SIZE_128),
+		       BT_UUID_SIZE_128);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int cache_attr_push(struct net_buf_simple *buf, const struct bt_gatt_dm_attr *attr)
+{
+	const struct bt_gatt_service_val *service_val = bt_gatt_dm_attr_service_val(attr);
+	const struct bt_gatt_chrc *chrc = bt_gatt_dm_attr_chrc_val(attr);
+	int err;
+
+	if (net_buf_simple_tailroom(buf) < (sizeof(uint16_t) + sizeof(uint8_t))) {
+		return -ENOMEM;
+	}
+
+	net_buf_simple_add_le16(buf, attr->handle);
+	net_buf_simple_add_u8(buf, attr->perm);
+
+	err = cache_uuid_push(buf, attr->uuid);
+	if (err) {
+		return err;
+	}
+
+	if (service_val) {
+		if (net_buf_simple_tailroom(buf) < sizeof(uint16_t)) {
+			return -ENOMEM;
+		}
+
+		net_buf_simple_add_le16(buf, service_val->end_handle);
+
+		return cache_uuid_push(buf, service_val->uuid);
+	}
+
+	if (chrc) {
+		if (net_buf_simple_tailroom(buf) < (sizeof(uint16_t) + sizeof(uint8_t))) {
+			return -ENOMEM;
+		}
+
+		net_buf_simple_add_le16(buf, chrc->value_handle);
+		net_buf_simple_add_u8(buf, chrc->properties);
+
+		return cache_uuid_push(buf, chrc->uuid);
+	}
+
+	return 0;
+}
+
+static int cache_attr_pull(struct bt_gatt_dm *dm, struct net_buf_simple *buf)
+{
+	union cache_uuid attr_uuid;
+	union cache_uuid val_uuid;
+	struct bt_gatt_attr attr = {
+		.uuid = &attr_uuid.uuid,
+	};
+	struct bt_gatt_dm_attr *cur_attr;
+	int err;
+
+	if (buf->len < (sizeof(uint16_t) + sizeof(uint8_t))) {
+		return -EINVAL;
+	}
+
+	attr.handle = net_buf_simple_pull_le16(buf);
+	attr.perm = net_buf_simple_pull_u8(buf);
+
+	err = cache_uuid_pull(buf, &attr_uuid);
+	if (err) {
+		return err;
+	}
+
+	if ((bt_uuid_cmp(attr.uuid, BT_UUID_GATT_PRIMARY) == 0) ||
+	    (bt_uuid_cmp(attr.uuid, BT_UUID_GATT_SECONDARY) == 0)) {
+		struct bt_gatt_service_val *service_val;
+
+		cur_attr = attr_store(dm, &attr, sizeof(*service_val));
+		if (!cur_attr || (buf->len < sizeof(uint16_t))) {
+			return -ENOMEM;
+		}
+
+		service_val = bt_gatt_dm_attr_service_val(cur_attr);
+		service_val->end_handle = net_buf_simple_pull_le16(buf);
+
+		err = cache_uuid_pull(buf, &val_uuid);
+		if (err) {
+			return err;
+		}
+
+		service_val->uuid = uuid_store(dm, &val_uuid.uuid);
+		if (!service_val->uuid) {
+			return -ENOMEM;
+		}
+	} else if (bt_uuid_cmp(attr.uuid, BT_UUID_GATT_CHRC) == 0) {
+		struct bt_gatt_chrc *chrc;
+
+		cur_attr = attr_store(dm, &attr, sizeof(*chrc));
+		if (!cur_attr || (buf->len < (sizeof(uint16_t) + sizeof(uint8_t)))) {
+			return -ENOMEM;
+		}
+
+		chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
+		chrc->value_handle = net_buf_simple_pull_le16(buf);
+		chrc->properties = net_buf_simple_pull_u8(buf);
+
+		err = cache_uuid_pull(buf, &val_uuid);
+		if (err) {
+			return err;
+		}
+
+		chrc->uuid = uuid_store(dm, &val_uuid.uuid);
+		if (!chrc->uuid) {
+			return -ENOMEM;
+		}
+	} else {
+		cur_attr = attr_store(dm, &attr, 0);
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+static int cache_load_cb(const char *key, size_t len, settings_read_cb read_cb,
+			 void *cb_arg, void *param)
+{
+	struct net_buf_simple *buf = param;
+	ssize_t ret;
+
+	/* Skip the entries placed below the requested one. */
+	if (settings_name_next(key, NULL) != 0) {
+		return 0;
+	}
+
+	if (len > net_buf_simple_tailroom(buf)) {
+		return -ENOMEM;
+	}
+
+	ret = read_cb(cb_arg, net_buf_simple_add(buf, len), len);
+	if (ret != len) {
+		net_buf_simple_reset(buf);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/* Marks the entry in cache_buf as the most recently used one, unless it
+ * already is.
+ */
+static void cache_touch(const char *key, size_t entry_len, uint32_t seq)
+{
+	if ((cache_seq != 0) && (seq == cache_seq)) {
+		return;
+	}
+
+	if (!atomic_cas(&cache_store_pending, 0, 1)) {
+		return;
+	}
+
+	/* The entry is still in the buffer after it was parsed. */
+	net_buf_simple_reset(&cache_buf);
+	net_buf_simple_add(&cache_buf, entry_len);
+
+	strcpy(cache_store_key, key);
+	cache_store_touch = true;
+	discovery_work_submit(NULL, &cache_store_work);
+}
+
+/* Restores the discovery result from the cache and completes the discovery. */
+static int cache_replay(struct bt_gatt_dm *dm)
+{
+	char key[CACHE_KEY_LEN];
+	uint16_t end_handle;
+	uint16_t attr_cnt;
+	uint32_t seq;
+	size_t entry_len;
+	int err;
+
+	err = cache_key_get(dm, key, sizeof(key));
+	if (err) {
+		return err;
+	}
+
+	net_buf_simple_reset(&cache_buf);
+
+	err = settings_load_subtree_direct(key, cache_load_cb, &cache_buf);
+	if (err || (cache_buf.len == 0)) {
+		return -ENOENT;
+	}
+
+	entry_len = cache_buf.len;
+
+	if ((cache_buf.len < CACHE_HDR_LEN) ||
+	    (net_buf_simple_pull_u8(&cache_buf) != CACHE_VERSION)) {
+		return -EINVAL;
+	}
+
+	seq = net_buf_simple_pull_le32(&cache_buf);
+
+	if (memcmp(net_buf_simple_pull_mem(&cache_buf, sizeof(dm->db_hash)), dm->db_hash,
+		   sizeof(dm->db_hash)) != 0) {
+		LOG_DBG("Cached discovery is outdated");
+		return -ESTALE;
+	}
+
+	end_handle = net_buf_simple_pull_le16(&cache_buf);
+	attr_cnt = net_buf_simple_pull_le16(&cache_buf);
+
+	for (size_t i = 0; i < attr_cnt; i++) {
+		err = cache_attr_pull(dm, &cache_buf);
+		if (err) {
+			LOG_WRN("Cached discovery restore failed, error: %d", err);
+			svc_attr_memory_release(dm);
+			return err;
+		}
+	}
+
+	LOG_DBG("Discovery restored from cache, %u attributes", attr_cnt);
+
+	cache_touch(key, entry_len, seq);
+
+	dm->discover_params.end_handle = end_handle;
+	atomic_set_bit(dm->state_flags, STATE_CACHE_REPLAYED);
+	discovery_complete(dm);
+
+	return 0;
+}
+
+struct cache_scan_info {
+	/* Key of the stored entry, relative to CACHE_KEY_PREFIX. */
+	const char *key;
+	/* Key of the least recently used entry, relative to CACHE_KEY_PREFIX. */
+	char lru_key[CACHE_KEY_LEN];
+	uint32_t lru_seq;
+	uint32_t max_seq;
+	size_t cnt;
+	bool found;
+};
+
+static int cache_scan_cb(const char *key, size_t len, settings_read_cb read_cb,
+			 void *cb_arg, void *param)
+{
+	struct cache_scan_info *info = param;
+	uint8_t hdr[CACHE_SEQ_OFFSET + sizeof(uint32_t)];
+	uint32_t seq = 0;
+
+	if (!key) {
+		return 0;
+	}
+
+	/* Entries of an older format are the first to be removed. */
+	if ((read_cb(cb_arg, hdr, sizeof(hdr)) >= (ssize_t)sizeof(hdr)) &&
+	    (hdr[0] == CACHE_VERSION)) {
+		seq = sys_get_le32(&hdr[CACHE_SEQ_OFFSET]);
+	}
+
+	if (!strcmp(key, info->key)) {
+		info->found = true;
+	}
+
+	if ((info->cnt == 0) || (seq < info->lru_seq)) {
+		strncpy(info->lru_key, key, sizeof(info->lru_key) - 1);
+		info->lru_key[sizeof(info->lru_key) - 1] = '\0';
+		info->lru_seq = seq;
+	}
+
+	info->max_seq = MAX(info->max_seq, seq);
+	info->cnt++;
+
+	return 0;
+}
+
+/* Finds the largest sequence number and removes the least recently used
+ * entry if the stored entry is a new one and the cache is full.
+ */
+static int cache_evict(void)
+{
+	struct cache_scan_info info = {
+		.key = &cache_store_key[sizeof(CACHE_KEY_PREFIX)],
+	};
+	char name[sizeof(CACHE_KEY_PREFIX) + CACHE_KEY_LEN];
+	int err;
+
+	err = settings_load_subtree_direct(CACHE_KEY_PREFIX, cache_scan_cb, &info);
+	if (err) {
+		return err;
+	}
+
+	cache_seq = MAX(cache_seq, info.max_seq);
+
+	if (info.found || (info.cnt < CONFIG_BT_GATT_DM_CACHE_MAX_ENTRIES)) {
+		return 0;
+	}
+
+	snprintf(name, sizeof(name), CACHE_KEY_PREFIX "/%s", info.lru_key);
+	LOG_DBG("Removing least recently used cache entry %s", name);
+
+	return settings_delete(name);
+}
+
+static void cache_store_work_handler(struct k_work *work)
+{
+	int err = 0;
+
+	/* Restored entries are already counted, but the largest sequence
+	 * number must be found once after boot.
+	 */
+	if (!cache_store_touch || (cache_seq == 0)) {
+		err = cache_evict();
+	}
+
+	if (!err) {
+		sys_put_le32(++cache_seq, &cache_buf.data[CACHE_SEQ_OFFSET]);
+		err = settings_save_one(cache_store_key, cache_buf.data, cache_buf.len);
+	}
+
+	if (err) {
+		LOG_WRN("Cannot store discovery cache, error: %d", err);
+	}
+
+	atomic_clear(&cache_store_pending);
+}
+
+/* Serializes the discovery result and schedules storing it in the cache. */
+static void cache_store(struct bt_gatt_dm *dm)
+{
+	int err;
+
+	if (!atomic_test_bit(dm->state_flags, STATE_DB_HASH_VALID) ||
+	    atomic_test_and_clear_bit(dm->state_flags, STATE_CACHE_REPLAYED)) {
+		return;
+	}
+
+	if (!atomic_cas(&cache_store_pending, 0, 1)) {
+		LOG_DBG("Discovery cache store in progress");
+		return;
+	}
+
+	err = cache_key_get(dm, cache_store_key, sizeof(cache_store_key));
+	if (err) {
+		goto error;
+	}
+
+	net_buf_simple_reset(&cache_buf);
+
+	if (net_buf_simple_tailroom(&cache_buf) < CACHE_HDR_LEN) {
+		err = -ENOMEM;
+		goto error;
+	}
+
+	net_buf_simple_add_u8(&cache_buf, CACHE_VERSION);
+	/* The sequence number is set when the entry is written. */
+	net_buf_simple_add_le32(&cache_buf, 0);
+	net_buf_simple_add_mem(&cache_buf, dm->db_hash, sizeof(dm->db_hash));
+	net_buf_simple_add_le16(&cache_buf, dm->discover_params.end_handle);
+	net_buf_simple_add_le16(&cache_buf, dm->cur_attr_id);
+
+	for (size_t i = 0; i < dm->cur_attr_id; i++) {
+		err = cache_attr_push(&cache_buf, &dm->attrs[i]);
+		if (err) {
+			goto error;
+		}
+	}
+
+	cache_store_touch = false;
+	discovery_work_submit(dm, &cache_store_work);
+
+	return;
+
+error:
+	LOG_DBG("Discovery not cached, error: %d", err);
+	atomic_clear(&cache_store_pending);
+}
+
+/* Service Changed subscription of a connection, used to invalidate the
+ * cached results of the peer when its database changes.
+ */
+struct cache_sc_sub {
+	struct bt_gatt_discover_params disc_params;
+	struct bt_gatt_subscribe_params sub_params;
+	struct k_work invalidate_work;
+	bt_addr_le_t addr;
+	/* Discovery waiting for the subscription to complete. */
+	struct bt_gatt_dm *dm;
+	/* Subscription started on the current connection. */
+	atomic_t started;
+};
+
+static struct cache_sc_sub cache_sc_subs[CONFIG_BT_MAX_CONN];
+
+/* Continues in the workqueue, either from the cache or over the air. */
+static void cache_discovery_continue(struct bt_gatt_dm *dm)
+{
+	dm->cache_start_handle = dm->discover_params.start_handle;
+	discovery_work_submit(dm, &dm->discover_work);
+}
+
+static void cache_invalidate_work_handler(struct k_work *work)
+{
+	struct cache_sc_sub *sub = CONTAINER_OF(work, struct cache_sc_sub, invalidate_work);
+	int err;
+
+	err = bt_gatt_dm_cache_clear(&sub->addr);
+	if (err) {
+		LOG_WRN("Cannot clear discovery cache, error: %d", err);
+	}
+}
+
+static uint8_t cache_sc_indicated(struct bt_conn *conn, struct bt_gatt_subscribe_params *params,
+				  const void *data, uint16_t length)
+{
+	struct cache_sc_sub *sub = CONTAINER_OF(params, struct cache_sc_sub, sub_params);
+
+	if (!data) {
+		/* Unsubscribed. */
+		return BT_GATT_ITER_STOP;
+	}
+
+	LOG_DBG("Service Changed, invalidating discovery cache");
+	discovery_work_submit(NULL, &sub->invalidate_work);
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void cache_sc_subscribed(struct bt_conn *conn, uint8_t err,
+				struct bt_gatt_subscribe_params *params)
+{
+	struct cache_sc_sub *sub = CONTAINER_OF(params, struct cache_sc_sub, sub_params);
+	struct bt_gatt_dm *dm = sub->dm;
+
+	if (err) {
+		LOG_DBG("Service Changed subscription failed, error: %u", err);
+	}
+
+	sub->dm = NULL;
+
+	if (dm) {
+		cache_discovery_continue(dm);
+	}
+}
+
+static uint8_t cache_sc_discover_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+				    struct bt_gatt_discover_params *params)
+{
+	struct cache_sc_sub *sub = CONTAINER_OF(params, struct cache_sc_sub, disc_params);
+	const struct bt_gatt_chrc *chrc;
+	int err;
+
+	if (!attr) {
+		LOG_DBG("Service Changed indications not supported");
+		cache_sc_subscribed(conn, 0, &sub->sub_params);
+		return BT_GATT_ITER_STOP;
+	}
+
+	if (params->type == BT_GATT_DISCOVER_CHARACTERISTIC) {
+		chrc = attr->user_data;
+		if (bt_uuid_cmp(chrc->uuid, BT_UUID_GATT_SC)) {
+			return BT_GATT_ITER_CONTINUE;
+		}
+
+		memset(&sub->sub_params, 0, sizeof(sub->sub_params));
+		sub->sub_params.notify = cache_sc_indicated;
+		sub->sub_params.subscribe = cache_sc_subscribed;
+		sub->sub_params.value = BT_GATT_CCC_INDICATE;
+		sub->sub_params.value_handle = chrc->value_handle;
+		/* Subscribe again on each connection. */
+		atomic_set_bit(sub->sub_params.flags, BT_GATT_SUBSCRIBE_FLAG_VOLATILE);
+
+		/* The CCC descriptor follows the characteristic value. */
+		params->uuid = NULL;
+		params->type = BT_GATT_DISCOVER_ATTRIBUTE;
+		params->start_handle = chrc->value_handle + 1;
+		params->end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+
+		err = bt_gatt_discover(conn, params);
+		if (err) {
+			cache_sc_subscribed(conn, err, &sub->sub_params);
+		}
+
+		return BT_GATT_ITER_STOP;
+	}
+
+	if (!bt_uuid_cmp(attr->uuid, BT_UUID_GATT_CHRC) ||
+	    !bt_uuid_cmp(attr->uuid, BT_UUID_GATT_PRIMARY) ||
+	    !bt_uuid_cmp(attr->uuid, BT_UUID_GATT_SECONDARY)) {
+		LOG_DBG("Service Changed CCC descriptor not found");
+		cache_sc_subscribed(conn, 0, &sub->sub_params);
+		return BT_GATT_ITER_STOP;
+	}
+
+	if (bt_uuid_cmp(attr->uuid, BT_UUID_GATT_CCC)) {
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	sub->sub_params.ccc_handle = attr->handle;
+
+	err = bt_gatt_subscribe(conn, &sub->sub_params);
+	if (err) {
+		cache_sc_subscribed(conn, err, &sub->sub_params);
+	}
+
+	return BT_GATT_ITER_STOP;
+}
+
+/* Subscribes to the Service Changed indications once per connection before
+ * the discovery continues.
+ */
+static void cache_sc_subscribe(struct bt_gatt_dm *dm)
+{
+	struct cache_sc_sub *sub = &cache_sc_subs[bt_conn_index(dm->conn)];
+	struct bt_gatt_discover_params *params = &sub->disc_params;
+	int err;
+
+	if (!atomic_test_bit(dm->state_flags, STATE_DB_HASH_VALID) ||
+	    !atomic_cas(&sub->started, 0, 1)) {
+		cache_discovery_continue(dm);
+		return;
+	}
+
+	sub->dm = dm;
+	bt_addr_le_copy(&sub->addr, bt_conn_get_dst(dm->conn));
+
+	if (!sub->invalidate_work.handler) {
+		k_work_init(&sub->invalidate_work, cache_invalidate_work_handler);
+	}
+
+	memset(params, 0, sizeof(*params));
+	params->uuid = BT_UUID_GATT_SC;
+	params->func = cache_sc_discover_cb;
+	params->start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	params->end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+	params->type = BT_GATT_DISCOVER_CHARACTERISTIC;
+
+	err = bt_gatt_discover(dm->conn, params);
+	if (err) {
+		cache_sc_subscribed(dm->conn, err, &sub->sub_params);
+	}
+}
+
+static void cache_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	/* The volatile subscription is removed on disconnection. */
+	atomic_clear(&cache_sc_subs[bt_conn_index(conn)].started);
+}
+
+BT_CONN_CB_DEFINE(gatt_dm_cache_conn_cb) = {
+	.disconnected = cache_disconnected,
+};
+
+static uint8_t db_hash_read_cb(struct bt_conn *conn, uint8_t err,
+			       struct bt_gatt_read_params *params,
+			       const void *data, uint16_t length)
+{
+	struct bt_gatt_dm *dm = CONTAINER_OF(params, struct bt_gatt_dm, db_hash_read_params);
+
+	if (!err && data && (length == sizeof(dm->db_hash))) {
+		memcpy(dm->db_hash, data, sizeof(dm->db_hash));
+		atomic_set_bit(dm->state_flags, STATE_DB_HASH_VALID);
+	} else {
+		LOG_DBG("Database Hash not available, error: %u", err);
+	}
+
+	cache_sc_subscribe(dm);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static int db_hash_read(struct bt_gatt_dm *dm)
+{
+	struct bt_gatt_read_params *params = &dm->db_hash_read_params;
+
+	if (!cache_addr_supported(bt_conn_get_dst(dm->conn))) {
+		return -ENOTSUP;
+	}
+
+	memset(params, 0, sizeof(*params));
+	params->func = db_hash_read_cb;
+	params->handle_count = 0;
+	params->by_uuid.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	params->by_uuid.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+	params->by_uuid.uuid = BT_UUID_GATT_DB_HASH;
+
+	return bt_gatt_read(dm->conn, params);
+}
+
+#define CACHE_CLEAR_BATCH 4
+
+struct cache_clear_info {
+	char names[CACHE_CLEAR_BATCH][CACHE_KEY_LEN];
+	size_t cnt;
+};
+
+static int cache_clear_cb(const char *key, size_t len, settings_read_cb read_cb,
+			  void *cb_arg, void *param)
+{
+	struct cache_clear_info *info = param;
+
+	if (!key || (info->cnt >= ARRAY_SIZE(info->names))) {
+		return 0;
+	}
+
+	strncpy(info->names[info->cnt], key, CACHE_KEY_LEN - 1);
+	info->names[info->cnt][CACHE_KEY_LEN - 1] = '\0';
+	info->cnt++;
+
+	return 0;
+}
+
+int bt_gatt_dm_cache_clear(const bt_addr_le_t *addr)
+{
+	struct cache_clear_info info;
+	char subtree[CACHE_KEY_LEN];
+	char name[2 * CACHE_KEY_LEN];
+	int err;
+
+	if (addr) {
+		err = cache_addr_key_get(addr, subtree, sizeof(subtree));
+		if (err < 0) {
+			return err;
+		}
+	} else {
+		strcpy(subtree, CACHE_KEY_PREFIX);
+	}
+
+	/* Entries are collected in batches and deleted outside of the settings
+	 * iteration.
+	 */
+	do {
+		info.cnt = 0;
+
+		err = settings_load_subtree_direct(subtree, cache_clear_cb, &info);
+		if (err) {
+			return err;
+		}
+
+		for (size_t i = 0; i < info.cnt; i++) {
+			snprintf(name, sizeof(name), "%s/%s", subtree, info.names[i]);
+
+			err = settings_delete(name);
+			if (err) {
+				return err;
+			}
+		}
+	} while (info.cnt == ARRAY_SIZE(info.names));
+
+	return 0;
+}
+
+#if defined(CONFIG_BT_SMP)
+static void cache_bond_deleted(uint8_t id, const bt_addr_le_t *peer)
+{
+	int err = bt_gatt_dm_cache_clear(peer);
+
+	if (err) {
+		LOG_WRN("Cannot clear discovery cache, error: %d", err);
+	}
+}
+
+static struct bt_conn_auth_info_cb cache_auth_info_cb = {
+	.bond_deleted = cache_bond_deleted,
+};
+
+static int gatt_dm_cache_init(void)
+{
+	return bt_conn_auth_info_cb_register(&cache_auth_info_cb);
+}
+
+SYS_INIT(gatt_dm_cache_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* defined(CONFIG_BT_SMP) */
+#endif /* defined(CONFIG_BT_GATT_DM_CACHE) */
+
+static int discovery_begin(struct bt_gatt_dm *dm)
+{
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	if (atomic_test_bit(dm->state_flags, STATE_DB_HASH_VALID)) {
+		dm->cache_start_handle = dm->discover_params.start_handle;
+		discovery_work_submit(dm, &dm->discover_work);
+		return 0;
+	}
+#endif
+
+	return bt_gatt_discover(dm->conn, &dm->discover_params);
+}
+
 static void discovery_complete(struct bt_gatt_dm *dm)
 {
 	LOG_DBG("Discovery complete.");
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	cache_store(dm);
+#endif
+
 	atomic_set_bit(dm->state_flags, STATE_ATTRS_RELEASE_PENDING);
 	if (dm->callback->completed) {
 		dm->callback->completed(dm, dm->context);
@@ -307,6 +1209,14 @@ static void gatt_discover_work(struct k_work *work)
 		return;
 	}
 
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	if ((dm->discover_params.type == BT_GATT_DISCOVER_PRIMARY) &&
+	    atomic_test_bit(dm->state_flags, STATE_DB_HASH_VALID) &&
+	    (cache_replay(dm) == 0)) {
+		return;
+	}
+#endif
+
 	int err = bt_gatt_discover(dm->conn, &(dm->discover_params));
 
 	if (err) {
@@ -373,11 +1283,7 @@ static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 	dm->discover_params.start_handle = cur_attr->handle + 1;
 	LOG_DBG("Starting descriptors discovery");
 
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-	k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-	k_work_submit(&dm->discover_work);
-#endif
+	discovery_work_submit(dm, &dm->discover_work);
 
 	return BT_GATT_ITER_STOP;
 }
@@ -396,11 +1302,7 @@ static uint8_t discovery_process_attribute(struct bt_gatt_dm *dm,
 			dm->discover_params.type =
 				BT_GATT_DISCOVER_CHARACTERISTIC;
 
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-			k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-			k_work_submit(&dm->discover_work);
-#endif
+			discovery_work_submit(dm, &dm->discover_work);
 		} else {
 			discovery_complete(dm);
 		}
@@ -409,9 +1311,12 @@ static uint8_t discovery_process_attribute(struct bt_gatt_dm *dm,
 
 	if (bt_uuid_cmp(attr->uuid, BT_UUID_GATT_CHRC) == 0) {
 		cur_attr = attr_store(dm, attr, sizeof(struct bt_gatt_chrc));
-		struct bt_gatt_chrc *cur_gatt_chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
+		if (cur_attr) {
+			struct bt_gatt_chrc *cur_gatt_chrc =
+				bt_gatt_dm_attr_chrc_val(cur_attr);
 
-		cur_gatt_chrc->uuid = cur_attr->uuid;
+			cur_gatt_chrc->uuid = cur_attr->uuid;
+		}
 	} else {
 		cur_attr = attr_store(dm, attr, 0);
 	}
@@ -539,34 +1444,55 @@ const struct bt_gatt_dm_attr *bt_gatt_dm_service_get(
 	return &(dm->attrs[0]);
 }
 
+/* Returns position in dm->chrc_ids of the first characteristic declaration
+ * placed after the given attribute index.
+ */
+static size_t chrc_pos_after(const struct bt_gatt_dm *dm, size_t attr_id)
+{
+	size_t lower = 0;
+	size_t upper = dm->chrc_cnt;
+
+	while (lower < upper) {
+		size_t m = (lower + upper) / 2;
+
+		if (dm->chrc_ids[m] <= attr_id) {
+			lower = m + 1;
+		} else {
+			upper = m;
+		}
+	}
+
+	return lower;
+}
+
 const struct bt_gatt_dm_attr *bt_gatt_dm_char_next(
 	const struct bt_gatt_dm *dm,
 	const struct bt_gatt_dm_attr *prev)
 {
+	size_t pos;
+
 	if (!prev) {
 		prev = dm->attrs;
 	}
 
-	if (dm->attrs <= prev) {
-		const struct bt_gatt_dm_attr *const end =
-			&(dm->attrs[dm->cur_attr_id]);
-		while (++prev < end) {
-			if (!bt_uuid_cmp(BT_UUID_GATT_CHRC, prev->uuid)) {
-				return prev;
-			}
-		}
+	if ((prev < dm->attrs) || (prev >= &(dm->attrs[dm->cur_attr_id]))) {
+		return NULL;
 	}
 
-	return NULL;
+	pos = chrc_pos_after(dm, prev - dm->attrs);
+	if (pos >= dm->chrc_cnt) {
+		return NULL;
+	}
+
+	return &(dm->attrs[dm->chrc_ids[pos]]);
 }
 
 const struct bt_gatt_dm_attr *bt_gatt_dm_char_by_uuid(
 	const struct bt_gatt_dm *dm,
 	const struct bt_uuid *uuid)
 {
-	const struct bt_gatt_dm_attr *curr = NULL;
-
-	while ((curr = bt_gatt_dm_char_next(dm, curr)) != NULL) {
+	for (size_t i = 0; i < dm->chrc_cnt; i++) {
+		const struct bt_gatt_dm_attr *curr = &(dm->attrs[dm->chrc_ids[i]]);
 		struct bt_gatt_chrc *chrc = bt_gatt_dm_attr_chrc_val(curr);
 
 		__ASSERT_NO_MSG(chrc != NULL);
@@ -661,6 +1587,7 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 	dm->context = context;
 	dm->callback = cb;
 	dm->cur_attr_id = 0;
+	dm->chrc_cnt = 0;
 	sys_slist_init(&dm->chunk_list);
 	dm->cur_chunk_len = 0;
 	dm->search_svc_by_uuid = (svc_uuid != NULL);
@@ -678,8 +1605,19 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 	dm->discover_params.end_handle = 0xffff;
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 	k_work_init(&dm->discover_work, gatt_discover_work);
+	atomic_clear_bit(dm->state_flags, STATE_DB_HASH_VALID);
+	atomic_clear_bit(dm->state_flags, STATE_CACHE_REPLAYED);
 
-	err = bt_gatt_discover(conn, &dm->discover_params);
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	/* The discovery continues from the read callback. */
+	err = db_hash_read(dm);
+	if (err) {
+		LOG_DBG("Database Hash read not started, error: %d", err);
+		err = discovery_begin(dm);
+	}
+#else
+	err = discovery_begin(dm);
+#endif
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
 		atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
@@ -722,7 +1660,7 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context)
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 	dm->discover_params.uuid = dm->search_svc_by_uuid ? &dm->svc_uuid.uuid : NULL;
 
-	err = bt_gatt_discover(dm->conn, &dm->discover_params);
+	err = discovery_begin(dm);
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
 		atomic_clear_bit(dm->state_flags, STATE_ATTRS_LOCKED);
@@ -4,15 +4,121 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <string.h>
 #include <bluetooth/mesh/light_ctrl_reg_spec.h>
 
 #define REG_INT CONFIG_BT_MESH_LIGHT_CTRL_REG_SPEC_INTERVAL
 
+#if CONFIG_BT_MESH_LIGHT_CTRL_REG_SPEC_FIXED_POINT
+
+/* Illuminance and lightness values have REG_Q fractional bits, the
+ * coefficients have REG_COEFF_Q fractional bits, and the accuracy has
+ * REG_ACCURACY_Q fractional bits. The coefficients are limited to
+ * REG_COEFF_MAX, so that the intermediate products in fx_mul() fit in 64 bits.
+ */
+#define REG_Q 16
+#define REG_COEFF_Q 24
+#define REG_ACCURACY_Q 32
+#define REG_COEFF_MAX 16383.0f
+
+#define REG_LIGHTNESS(_lightness) ((int64_t)(_lightness) << REG_Q)
+
+typedef int64_t reg_val_t;
+
+static int64_t reg_val_get(float val)
+{
+	return val * (1 << REG_Q);
+}
+
+static int64_t coeff_get(float coeff)
+{
+	return CLAMP(coeff, -REG_COEFF_MAX, REG_COEFF_MAX) * (1 << REG_COEFF_Q);
+}
+
+/** Multiply a value by a coefficient with @c q fractional bits. The value is
+ *  split in an integer and a fractional part to keep the products in range.
+ */
+static int64_t fx_mul(int64_t val, int64_t coeff, uint8_t q)
+{
+	return (val >> q) * coeff + (((val & BIT64_MASK(q)) * coeff) >> q);
+}
+
+static void coeffs_update(struct bt_mesh_light_ctrl_reg_spec *spec_reg)
+{
+	struct bt_mesh_light_ctrl_reg_spec_coeffs *coeffs = &spec_reg->coeffs;
+	const struct bt_mesh_light_ctrl_reg_cfg *cfg = &spec_reg->reg.cfg;
+
+	/* The configuration may change at any time, so it's compared to the one
+	 * the coefficients were converted from on every step.
+	 */
+	if (!memcmp(&coeffs->cfg, cfg, sizeof(*cfg))) {
+		return;
+	}
+
+	coeffs->cfg = *cfg;
+	coeffs->ki_up = coeff_get(cfg->ki.up * ((float)REG_INT / (float)MSEC_PER_SEC));
+	coeffs->ki_down = coeff_get(cfg->ki.down * ((float)REG_INT / (float)MSEC_PER_SEC));
+	coeffs->kp_up = coeff_get(cfg->kp.up);
+	coeffs->kp_down = coeff_get(cfg->kp.down);
+	/* Accuracy should be in percent and both up and down: */
+	coeffs->accuracy = CLAMP(cfg->accuracy / (2 * 100.0f), 0.0f, 0.5f) *
+			   (float)BIT64(REG_ACCURACY_Q);
+}
+
+static float reg_output(int64_t output)
+{
+	/* The output is truncated to an integer lightness level anyway. */
+	return output >> REG_Q;
+}
+
+#else
+
+#define REG_LIGHTNESS(_lightness) ((float)(_lightness))
+
+typedef float reg_val_t;
+
+#endif /* CONFIG_BT_MESH_LIGHT_CTRL_REG_SPEC_FIXED_POINT */
+
 struct reg_terms {
-	float i;
-	float p;
+	reg_val_t i;
+	reg_val_t p;
 };
 
+#if CONFIG_BT_MESH_LIGHT_CTRL_REG_SPEC_FIXED_POINT
+static struct reg_terms reg_terms_calc(struct bt_mesh_light_ctrl_reg_spec *spec_reg)
+{
+	int64_t target = reg_val_get(bt_mesh_light_ctrl_reg_target_get(&spec_reg->reg));
+	int64_t error = target - reg_val_get(spec_reg->reg.measured);
+	int64_t accuracy;
+	int64_t input;
+	int64_t kp, ki;
+
+	coeffs_update(spec_reg);
+
+	accuracy = fx_mul(target, spec_reg->coeffs.accuracy, REG_ACCURACY_Q);
+
+	if (error > accuracy) {
+		input = error - accuracy;
+	} else if (error < -accuracy) {
+		input = error + accuracy;
+	} else {
+		input = 0;
+	}
+
+	if (input >= 0) {
+		kp = spec_reg->coeffs.kp_up;
+		ki = spec_reg->coeffs.ki_up;
+	} else {
+		kp = spec_reg->coeffs.kp_down;
+		ki = spec_reg->coeffs.ki_down;
+	}
+
+	return (struct reg_terms){
+		.i = fx_mul(input, ki, REG_COEFF_Q),
+		.p = fx_mul(input, kp, REG_COEFF_Q),
+	};
+}
+#else
 static struct reg_terms reg_terms_calc(struct bt_mesh_light_ctrl_reg_spec *spec_reg)
 {
 	float target = bt_mesh_light_ctrl_reg_target_get(&spec_reg->reg);
@@ -44,6 +150,12 @@ static struct reg_terms reg_terms_calc(struct bt_mesh_light_ctrl_reg_spec *spec_
 	};
 }
 
+static float reg_output(float output)
+{
+	return output;
+}
+#endif /* CONFIG_BT_MESH_LIGHT_CTRL_REG_SPEC_FIXED_POINT */
+
 static void reg_step(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -67,10 +179,10 @@ static void reg_step(struct k_work *work)
 	}
 
 	if (!spec_reg->neg) {
-		spec_reg->i = CLAMP(spec_reg->i, 0, UINT16_MAX);
+		spec_reg->i = CLAMP(spec_reg->i, 0, REG_LIGHTNESS(UINT16_MAX));
 	}
 
-	float output = spec_reg->i + reg_terms.p;
+	float output = reg_output(spec_reg->i + reg_terms.p);
 
 	spec_reg->reg.updated(&spec_reg->reg, output);
 }
@@ -84,7 +196,7 @@ static void internal_sum_recover(struct bt_mesh_light_ctrl_reg_spec *spec_reg, u
 	/* Recalculate the internal sum so that it is equal to the passed lightness level at the
 	 * next regulator step.
 	 */
-	spec_reg->i = lightness - reg_terms.i;
+	spec_reg->i = REG_LIGHTNESS(lightness) - reg_terms.i;
 	/* Allow the internal sum to be negative until it becomes positive. */
 	spec_reg->neg = true;
 }
@@ -18,13 +18,140 @@ LOG_MODULE_REGISTER(bt_mesh_rpl);
 #include <mesh/rpl.h>
 #include <emds/emds.h>
 
+/* Number of slots in the source address index, kept at most half full. */
+#define RPL_INDEX_SIZE (2 * CONFIG_BT_MESH_CRPL + 1)
+
+/* Index slots hold the list index plus one. */
+BUILD_ASSERT(CONFIG_BT_MESH_CRPL <= UINT16_MAX, "Replay list too large for the index");
+
+/* The used entries are kept at the start of the list, which is stored as is
+ * in the Emergency Data Storage.
+ */
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 
 EMDS_STATIC_ENTRY_DEFINE(rpl_store, CONFIG_BT_MESH_RPL_INDEX, replay_list, sizeof(replay_list));
 
+/* Open addressing index of the replay list by source address. Each slot holds
+ * the list index of the entry plus one, or zero if empty. As the list is
+ * restored from the Emergency Data Storage behind our back, the index is built
+ * on first use. The list is restored before the settings are loaded, and the
+ * mesh only receives messages or updates the IV index once the settings are
+ * loaded, so the first use is always after the restore.
+ */
+static uint16_t rpl_index[RPL_INDEX_SIZE];
+static uint16_t rpl_count;
+static bool rpl_index_valid;
+
+static uint32_t rpl_index_home(uint16_t src)
+{
+	/* Unicast addresses are mostly allocated sequentially, so they spread
+	 * evenly over the slots without further mixing.
+	 */
+	return src % RPL_INDEX_SIZE;
+}
+
+static uint32_t rpl_index_next(uint32_t pos)
+{
+	return (pos + 1) % RPL_INDEX_SIZE;
+}
+
+static void rpl_index_insert(uint16_t src, uint16_t idx)
+{
+	uint32_t pos = rpl_index_home(src);
+
+	while (rpl_index[pos]) {
+		pos = rpl_index_next(pos);
+	}
+
+	rpl_index[pos] = idx + 1;
+}
+
+static void rpl_index_remove(uint16_t src)
+{
+	uint32_t pos = rpl_index_home(src);
+	uint32_t next;
+
+	while (rpl_index[pos]) {
+		if (replay_list[rpl_index[pos] - 1].src == src) {
+			break;
+		}
+
+		pos = rpl_index_next(pos);
+	}
+
+	if (!rpl_index[pos]) {
+		return;
+	}
+
+	rpl_index[pos] = 0;
+
+	/* Move back the following entries of the probe sequence that would no
+	 * longer be reachable from their home slot.
+	 */
+	for (next = rpl_index_next(pos); rpl_index[next]; next = rpl_index_next(next)) {
+		uint32_t home = rpl_index_home(replay_list[rpl_index[next] - 1].src);
+		bool reachable;
+
+		if (pos <= next) {
+			reachable = (home > pos) && (home <= next);
+		} else {
+			reachable = (home > pos) || (home <= next);
+		}
+
+		if (!reachable) {
+			rpl_index[pos] = rpl_index[next];
+			rpl_index[next] = 0;
+			pos = next;
+		}
+	}
+}
+
+static void rpl_index_build(void)
+{
+	(void)memset(rpl_index, 0, sizeof(rpl_index));
+
+	for (rpl_count = 0; rpl_count < ARRAY_SIZE(replay_list); rpl_count++) {
+		if (!replay_list[rpl_count].src) {
+			break;
+		}
+
+		rpl_index_insert(replay_list[rpl_count].src, rpl_count);
+	}
+
+	rpl_index_valid = true;
+}
+
+static struct bt_mesh_rpl *rpl_find(uint16_t src)
+{
+	uint32_t pos = rpl_index_home(src);
+
+	while (rpl_index[pos]) {
+		struct bt_mesh_rpl *rpl = &replay_list[rpl_index[pos] - 1];
+
+		if (rpl->src == src) {
+			return rpl;
+		}
+
+		pos = rpl_index_next(pos);
+	}
+
+	return NULL;
+}
+
 void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		struct bt_mesh_net_rx *rx)
 {
+	if (!rpl_index_valid) {
+		rpl_index_build();
+	}
+
+	/* Keep the used entries at the start of the list, even if the list
+	 * was compacted since the empty slot was handed out.
+	 */
+	if (!rpl->src && rpl != &replay_list[rpl_count]) {
+		rpl = &replay_list[rpl_count];
+	}
+
 	/* If this is the first message on the new IV index, we should reset it
 	 * to zero to avoid invalid combinations of IV index and seg.
 	 */
@@ -32,6 +159,19 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
+	if (rpl->src != rx->ctx.addr) {
+		/* The slot was handed out as empty by bt_mesh_rpl_check(), but
+		 * another source may have taken it in the meantime.
+		 */
+		if (rpl->src) {
+			rpl_index_remove(rpl->src);
+		} else {
+			rpl_count++;
+		}
+
+		rpl_index_insert(rx->ctx.addr, rpl - replay_list);
+	}
+
 	rpl->src = rx->ctx.addr;
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
@@ -45,7 +185,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match, bool bridge)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -57,11 +197,20 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	if (!rpl_index_valid) {
+		rpl_index_build();
+	}
+
+	rpl = rpl_find(rx->ctx.addr);
+
+	/* Existing slot for given address */
+	if (rpl) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
 
-		/* Empty slot */
-		if (!rpl->src) {
+		if ((!rx->old_iv && rpl->old_iv) ||
+		    rpl->seq < rx->seq) {
 			if (match) {
 				*match = rpl;
 			} else {
@@ -69,36 +218,32 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 			}
 
 			return false;
+		} else {
+			return true;
 		}
+	}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+	if (rpl_count == ARRAY_SIZE(replay_list)) {
+		LOG_ERR("RPL is full!");
+		return true;
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
+	/* Empty slot */
+	rpl = &replay_list[rpl_count];
 
-				return false;
-			} else {
-				return true;
-			}
-		}
+	if (match) {
+		*match = rpl;
+	} else {
+		bt_mesh_rpl_update(rpl, rx);
 	}
 
-	LOG_ERR("RPL is full!");
-	return true;
+	return false;
 }
 
 void bt_mesh_rpl_clear(void)
 {
 	(void)memset(replay_list, 0, sizeof(replay_list));
+	rpl_index_valid = false;
 }
 
 void bt_mesh_rpl_reset(void)
@@ -130,6 +275,8 @@ void bt_mesh_rpl_reset(void)
 	}
 
 	(void) memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+
+	rpl_index_build();
 }
 
 void bt_mesh_rpl_pending_store(uint16_t addr)
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <zephyr/bluetooth/mesh/access.h>
 #include <bluetooth/mesh/models.h>
 #include <zephyr/sys/byteorder.h>
@@ -343,6 +344,117 @@ static void page_recover(struct bt_mesh_scene_srv *srv, bool vnd,
 	}
 }
 
+#if CONFIG_BT_MESH_SCENE_SRV_CACHE_SCENES > 0
+static struct bt_mesh_scene_srv_cache *cache_find(struct bt_mesh_scene_srv *srv,
+						  uint16_t scene)
+{
+	for (int i = 0; i < ARRAY_SIZE(srv->cache); i++) {
+		if (srv->cache[i].scene == scene) {
+			return &srv->cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/** Start caching the data of the given scene, discarding any previously
+ *  cached data. Scenes that don't get a cache entry are recalled from storage.
+ */
+static void cache_reset(struct bt_mesh_scene_srv *srv, uint16_t scene)
+{
+	struct bt_mesh_scene_srv_cache *cache = cache_find(srv, scene);
+
+	if (!cache) {
+		cache = cache_find(srv, BT_MESH_SCENE_NONE);
+		if (!cache) {
+			return;
+		}
+	}
+
+	memset(cache, 0, sizeof(*cache));
+	cache->scene = scene;
+}
+
+static void cache_clear(struct bt_mesh_scene_srv *srv, uint16_t scene)
+{
+	struct bt_mesh_scene_srv_cache *cache = cache_find(srv, scene);
+
+	if (cache) {
+		memset(cache, 0, sizeof(*cache));
+	}
+}
+
+/** Reserve room for a page of scene data in the cache.
+ *
+ *  SIG model data is added from the start of the cache buffer, and vendor model
+ *  data from the end, so that each can be recovered as a single page.
+ */
+static uint8_t *cache_reserve(struct bt_mesh_scene_srv *srv, uint16_t scene,
+			      bool vnd, size_t len)
+{
+	struct bt_mesh_scene_srv_cache *cache = cache_find(srv, scene);
+	uint8_t *data;
+
+	if (!cache || cache->overflow) {
+		return NULL;
+	}
+
+	if (cache->sig_len + cache->vnd_len + len > sizeof(cache->data)) {
+		LOG_DBG("Scene 0x%x doesn't fit in cache", scene);
+		cache->overflow = true;
+		return NULL;
+	}
+
+	if (vnd) {
+		cache->vnd_len += len;
+		data = &cache->data[sizeof(cache->data) - cache->vnd_len];
+	} else {
+		data = &cache->data[cache->sig_len];
+		cache->sig_len += len;
+	}
+
+	return data;
+}
+
+static void cache_invalidate(struct bt_mesh_scene_srv *srv, uint16_t scene)
+{
+	struct bt_mesh_scene_srv_cache *cache = cache_find(srv, scene);
+
+	if (cache) {
+		cache->overflow = true;
+	}
+}
+
+static bool cache_recover(struct bt_mesh_scene_srv *srv, uint16_t scene)
+{
+	struct bt_mesh_scene_srv_cache *cache = cache_find(srv, scene);
+
+	if (!cache || cache->overflow) {
+		return false;
+	}
+
+	LOG_DBG("Recovering 0x%x from cache", scene);
+
+	page_recover(srv, false, cache->data, cache->sig_len);
+	page_recover(srv, true, &cache->data[sizeof(cache->data) - cache->vnd_len],
+		     cache->vnd_len);
+	return true;
+}
+#else
+static inline void cache_reset(struct bt_mesh_scene_srv *srv, uint16_t scene) {}
+static inline void cache_clear(struct bt_mesh_scene_srv *srv, uint16_t scene) {}
+static inline uint8_t *cache_reserve(struct bt_mesh_scene_srv *srv,
+				     uint16_t scene, bool vnd, size_t len)
+{
+	return NULL;
+}
+static inline void cache_invalidate(struct bt_mesh_scene_srv *srv, uint16_t scene) {}
+static inline bool cache_recover(struct bt_mesh_scene_srv *srv, uint16_t scene)
+{
+	return false;
+}
+#endif
+
 static ssize_t entry_store(const struct bt_mesh_model *mod,
 			   const struct bt_mesh_scene_entry *entry, bool vnd,
 			   uint8_t buf[])
@@ -392,12 +504,18 @@ static ssize_t entry_store(const struct bt_mesh_model *mod,
 static void page_store(struct bt_mesh_scene_srv *srv, uint16_t scene,
 		       uint8_t page, bool vnd, uint8_t buf[], size_t len)
 {
+	uint8_t *cached;
 	char path[9];
 	int err;
 
 	scene_path(path, scene, vnd, page);
 	update_page_count(srv, vnd, page);
 
+	cached = cache_reserve(srv, scene, vnd, len);
+	if (cached) {
+		memcpy(cached, buf, len);
+	}
+
 	err = bt_mesh_model_data_store(srv->model, false, path, buf, len);
 	if (err) {
 		LOG_ERR("Failed storing %s: %d", path, err);
@@ -544,6 +662,7 @@ static enum bt_mesh_scene_status scene_store(struct bt_mesh_scene_srv *srv,
 		srv->all[srv->count++] = scene;
 	}
 
+	cache_reset(srv, scene);
 	scene_store_mod(srv, scene, false);
 	scene_store_mod(srv, scene, true);
 
@@ -561,6 +680,8 @@ static void scene_delete(struct bt_mesh_scene_srv *srv, uint16_t *scene)
 
 	LOG_DBG("0x%x", *scene);
 
+	cache_clear(srv, *scene);
+
 	for (int i = 0; i < srv->sigpages; i++) {
 		scene_path(path, *scene, false, i);
 		(void)bt_mesh_model_data_store(srv->model, false, path, NULL, 0);
@@ -734,6 +855,7 @@ static int scene_srv_set(const struct bt_mesh_model *model, const char *path,
 {
 	struct bt_mesh_scene_srv *srv = model->rt->user_data;
 	uint8_t buf[SCENE_PAGE_SIZE];
+	uint8_t *cached;
 	uint16_t scene;
 	ssize_t size;
 	uint8_t page;
@@ -763,22 +885,28 @@ static int scene_srv_set(const struct bt_mesh_model *model, const char *path,
 	page = strtol(&path[1], NULL, 16);
 	update_page_count(srv, vnd, page);
 
-	/* Before starting the mesh, we'll just register that the scene exists:
+	/* Before starting the mesh, we'll just register that the scene exists,
+	 * and preload its data if there's room for it in the cache:
 	 * Once the mesh starts, we'll load the current scene, and end up in
 	 * this callback again, but bt_mesh_is_provisioned() will be true.
 	 */
 	if (!bt_mesh_is_provisioned()) {
-		if (scene_find(srv, scene)) {
-			return 0;
+		if (!scene_find(srv, scene)) {
+			if (srv->count == ARRAY_SIZE(srv->all)) {
+				LOG_WRN("No room for scene 0x%x", scene);
+				return 0;
+			}
+
+			LOG_DBG("Recovered scene 0x%x", scene);
+			srv->all[srv->count++] = scene;
+			cache_reset(srv, scene);
 		}
 
-		if (srv->count == ARRAY_SIZE(srv->all)) {
-			LOG_WRN("No room for scene 0x%x", scene);
-			return 0;
+		cached = cache_reserve(srv, scene, vnd, len_rd);
+		if (cached && read_cb(cb_arg, cached, len_rd) != len_rd) {
+			cache_invalidate(srv, scene);
 		}
 
-		LOG_DBG("Recovered scene 0x%x", scene);
-		srv->all[srv->count++] = scene;
 		return 0;
 	}
 
@@ -914,6 +1042,11 @@ int bt_mesh_scene_srv_set(struct bt_mesh_scene_srv *srv, uint16_t scene,
 		(void)k_work_cancel_delayable(&srv->work);
 	}
 
+	if (cache_recover(srv, scene)) {
+		scene_recall_complete(srv);
+		return 0;
+	}
+
 	sprintf(path, "bt/mesh/s/%x/data/%x",
 		(srv->model->rt->elem_idx << 8) | srv->model->rt->mod_idx, scene);
 
@@ -1164,6 +1164,44 @@ int bt_mesh_sensor_srv_pub(struct bt_mesh_sensor_srv *srv,
 	return 0;
 }
 
+int bt_mesh_sensor_srv_pub_multi(
+	struct bt_mesh_sensor_srv *srv, struct bt_mesh_msg_ctx *ctx,
+	struct bt_mesh_sensor *const *sensors,
+	const struct bt_mesh_sensor_value (*values)[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX],
+	size_t count)
+{
+	int err;
+
+	NET_BUF_SIMPLE_DEFINE(msg, BT_MESH_TX_SDU_MAX);
+	bt_mesh_model_msg_init(&msg, BT_MESH_SENSOR_OP_STATUS);
+
+	for (size_t i = 0; i < count; i++) {
+		err = sensor_status_encode(&msg, sensors[i], values[i]);
+		if (err) {
+			return err;
+		}
+	}
+
+	if (net_buf_simple_tailroom(&msg) < BT_MESH_MIC_SHORT) {
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		sensor_cadence_update(sensors[i], values[i]);
+	}
+
+	err = bt_mesh_msg_send(srv->model, ctx, &msg);
+	if (err) {
+		return err;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		sensors[i]->state.prev = values[i][0];
+	}
+
+	return 0;
+}
+
 int bt_mesh_sensor_srv_sample(struct bt_mesh_sensor_srv *srv,
 			      struct bt_mesh_sensor *sensor)
 {
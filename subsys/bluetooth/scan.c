@@ -5,7 +5,9 @@
  */
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/hci.h>
 #include <string.h>
 #include <bluetooth/scan.h>
 
@@ -18,6 +20,14 @@ LOG_MODULE_REGISTER(nrf_bt_scan, CONFIG_BT_SCAN_LOG_LEVEL);
 	BT_SCAN_SHORT_NAME_FILTER | BT_SCAN_APPEARANCE_FILTER | \
 	BT_SCAN_UUID_FILTER | BT_SCAN_MANUFACTURER_DATA_FILTER)
 
+/* Address index is used by the blocklist, the connection attempts filter
+ * or the advertising report deduplication cache.
+ */
+#define SCAN_ADDR_INDEX \
+	(IS_ENABLED(CONFIG_BT_SCAN_BLOCKLIST) || \
+	 IS_ENABLED(CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER) || \
+	 IS_ENABLED(CONFIG_BT_SCAN_DEDUP))
+
 /* Scan filter mutex. */
 K_MUTEX_DEFINE(scan_mutex);
 
@@ -45,6 +55,11 @@ struct bt_scan_control {
 
 	/* Scan filter status. */
 	struct bt_scan_filter_match filter_status;
+
+#if CONFIG_BT_SCAN_DEDUP
+	/* RSSI statistics of the aggregated advertising reports. */
+	struct bt_scan_rssi_stats rssi_stats;
+#endif /* CONFIG_BT_SCAN_DEDUP */
 };
 
 /* Name filter structure.
@@ -196,26 +211,35 @@ struct bt_scan_filters {
 	bool all_mode;
 };
 
-#if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
-/* Connection attempts filter device */
-struct conn_attempts_device {
-	/* Filtered device address. */
-	bt_addr_le_t addr;
-
-	/* Number of the connection attempts. */
-	size_t attempts;
-};
+#if SCAN_ADDR_INDEX
+/* Address index slot count. The index is an open-addressing hash table with
+ * linear probing, sized for a load factor of at most one half.
+ */
+#define ADDR_INDEX_SIZE(_len) (2 * (_len) + 1)
+#endif /* SCAN_ADDR_INDEX */
 
+#if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
 /* Connection attempts filter. */
 struct conn_attempts_filter {
-	/* Array of the filtered devices. */
-	struct conn_attempts_device device[CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN];
+	/* Addresses of the filtered devices. */
+	bt_addr_le_t addr[CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN];
+
+	/* Number of the connection attempts of the filtered devices. */
+	size_t attempts[CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN];
+
+	/* Address index. Each slot holds the device index incremented by one,
+	 * zero marks an empty slot.
+	 */
+	uint16_t slot[ADDR_INDEX_SIZE(CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN)];
 
 	/* The oldest device index. */
 	uint32_t oldest_idx;
 
 	/* Count of the filtered devices. */
 	size_t count;
+
+	/* Modification sequence counter, odd while the filter is updated. */
+	atomic_t seq;
 };
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
@@ -225,11 +249,68 @@ struct conn_blocklist {
 	/* Array of the blocklist devices. */
 	bt_addr_le_t addr[CONFIG_BT_SCAN_BLOCKLIST_LEN];
 
+	/* Address index. Each slot holds the device index incremented by one,
+	 * zero marks an empty slot.
+	 */
+	uint16_t slot[ADDR_INDEX_SIZE(CONFIG_BT_SCAN_BLOCKLIST_LEN)];
+
 	/* Blocklist device count. */
 	uint32_t count;
+
+	/* Modification sequence counter, odd while the blocklist is updated. */
+	atomic_t seq;
 };
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
+#if CONFIG_BT_SCAN_DEDUP
+/* Last reported advertising payload of a given kind. */
+struct dedup_payload {
+	/* Hash of the advertising data. */
+	uint32_t hash;
+
+	/* Uptime of the last report, in milliseconds. */
+	uint32_t timestamp;
+
+	/* Payload has been reported. */
+	bool valid;
+};
+
+/* Advertising report deduplication cache entry. */
+struct dedup_entry {
+	/* LRU list node. */
+	sys_dnode_t node;
+
+	/* Last reported advertising data and scan response data. */
+	struct dedup_payload payload[2];
+
+	/* RSSI statistics since the last report. */
+	int32_t rssi_sum;
+	uint16_t rssi_cnt;
+	int8_t rssi_min;
+	int8_t rssi_max;
+};
+
+/* Advertising report deduplication cache. */
+struct dedup_cache {
+	/* Device addresses of the cache entries. */
+	bt_addr_le_t addr[CONFIG_BT_SCAN_DEDUP_CACHE_SIZE];
+
+	/* Cache entries. */
+	struct dedup_entry entry[CONFIG_BT_SCAN_DEDUP_CACHE_SIZE];
+
+	/* Address index. Each slot holds the entry index incremented by one,
+	 * zero marks an empty slot.
+	 */
+	uint16_t slot[ADDR_INDEX_SIZE(CONFIG_BT_SCAN_DEDUP_CACHE_SIZE)];
+
+	/* Entries ordered from the most to the least recently used. */
+	sys_dlist_t lru;
+
+	/* Count of the used entries. */
+	size_t count;
+};
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 /* Scanning module instance. Options for the different scanning modes.
  * This structure stores all module settings. It is used to enable
  * or disable scanning modes and to configure filters.
@@ -266,6 +347,13 @@ static struct bt_scan {
 	struct conn_blocklist blocklist;
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
+#if CONFIG_BT_SCAN_DEDUP
+	/* Advertising report deduplication cache. Accessed only from
+	 * the scan callback.
+	 */
+	struct dedup_cache dedup;
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 } bt_scan;
 
 static sys_slist_t callback_list;
@@ -330,21 +418,169 @@ static void notify_connecting_error(struct bt_scan_device_info *device_info)
 }
 #endif /* CONFIG_BT_CENTRAL */
 
-#if CONFIG_BT_SCAN_BLOCKLIST
-static bool blocklist_device_check(const bt_addr_le_t *addr)
+#if SCAN_ADDR_INDEX
+#define FNV1A_OFFSET_BASIS 2166136261U
+#define FNV1A_PRIME 16777619U
+
+static uint32_t fnv1a_hash(uint32_t hash, const uint8_t *data, size_t len)
 {
-	bool blocklist_device = false;
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ data[i]) * FNV1A_PRIME;
+	}
 
-	k_mutex_lock(&scan_mutex, K_FOREVER);
+	return hash;
+}
+
+static uint32_t addr_hash(const bt_addr_le_t *addr)
+{
+	uint32_t hash = FNV1A_OFFSET_BASIS;
+
+	hash = fnv1a_hash(hash, &addr->type, sizeof(addr->type));
 
-	for (size_t i = 0; i < bt_scan.blocklist.count; i++) {
-		if (bt_addr_le_cmp(&bt_scan.blocklist.addr[i], addr) == 0) {
-			blocklist_device = true;
+	return fnv1a_hash(hash, addr->a.val, sizeof(addr->a.val));
+}
 
+static int addr_index_find(const uint16_t *slot, size_t slot_cnt,
+			   const bt_addr_le_t *addrs, size_t addr_cnt,
+			   const bt_addr_le_t *addr)
+{
+	size_t pos = addr_hash(addr) % slot_cnt;
+
+	for (size_t i = 0; i < slot_cnt; i++) {
+		uint16_t entry = slot[pos];
+
+		if (entry == 0) {
 			break;
 		}
+
+		/* The slot may be stale if the index is read without
+		 * the mutex, so validate it before use.
+		 */
+		if ((entry <= addr_cnt) &&
+		    (bt_addr_le_cmp(&addrs[entry - 1], addr) == 0)) {
+			return entry - 1;
+		}
+
+		pos = (pos + 1) % slot_cnt;
+	}
+
+	return -ENOENT;
+}
+
+static void addr_index_insert(uint16_t *slot, size_t slot_cnt,
+			      const bt_addr_le_t *addrs, size_t idx)
+{
+	size_t pos = addr_hash(&addrs[idx]) % slot_cnt;
+
+	while (slot[pos] != 0) {
+		pos = (pos + 1) % slot_cnt;
+	}
+
+	slot[pos] = idx + 1;
+}
+
+static void addr_index_remove(uint16_t *slot, size_t slot_cnt,
+			      const bt_addr_le_t *addrs, size_t idx)
+{
+	size_t pos = addr_hash(&addrs[idx]) % slot_cnt;
+	size_t next;
+
+	while (slot[pos] != (idx + 1)) {
+		if (slot[pos] == 0) {
+			return;
+		}
+
+		pos = (pos + 1) % slot_cnt;
 	}
 
+	slot[pos] = 0;
+
+	/* Shift back the entries of the probe sequence that follows the
+	 * removed slot, so that no tombstones are needed.
+	 */
+	for (next = (pos + 1) % slot_cnt; slot[next] != 0;
+	     next = (next + 1) % slot_cnt) {
+		size_t home = addr_hash(&addrs[slot[next] - 1]) % slot_cnt;
+		bool in_range;
+
+		/* Entries whose home slot lies cyclically in (pos, next]
+		 * are still reachable and must stay in place.
+		 */
+		if (pos <= next) {
+			in_range = (home > pos) && (home <= next);
+		} else {
+			in_range = (home > pos) || (home <= next);
+		}
+
+		if (!in_range) {
+			slot[pos] = slot[next];
+			slot[next] = 0;
+			pos = next;
+		}
+	}
+}
+
+#if CONFIG_BT_SCAN_BLOCKLIST || CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
+static void addr_index_write_begin(atomic_t *seq)
+{
+	atomic_inc(seq);
+}
+
+static void addr_index_write_end(atomic_t *seq)
+{
+	atomic_inc(seq);
+}
+
+static bool addr_index_read_begin(const atomic_t *seq, atomic_val_t *start)
+{
+	*start = atomic_get(seq);
+
+	/* The index is read after the sequence counter. */
+	barrier_dmem_fence_full();
+
+	/* An odd value means that a writer is in progress. */
+	return (*start & 1) == 0;
+}
+
+static bool addr_index_read_valid(const atomic_t *seq, atomic_val_t start)
+{
+	/* The sequence counter is read after the index. */
+	barrier_dmem_fence_full();
+
+	return atomic_get(seq) == start;
+}
+#endif /* CONFIG_BT_SCAN_BLOCKLIST || CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
+#endif /* SCAN_ADDR_INDEX */
+
+#if CONFIG_BT_SCAN_BLOCKLIST
+static int blocklist_find(const bt_addr_le_t *addr)
+{
+	struct conn_blocklist *blocklist = &bt_scan.blocklist;
+
+	return addr_index_find(blocklist->slot, ARRAY_SIZE(blocklist->slot),
+			       blocklist->addr, ARRAY_SIZE(blocklist->addr),
+			       addr);
+}
+
+static bool blocklist_device_check(const bt_addr_le_t *addr)
+{
+	atomic_val_t seq;
+	bool blocklist_device;
+
+	/* Search without the mutex first, as this is done for every
+	 * advertising report.
+	 */
+	if (addr_index_read_begin(&bt_scan.blocklist.seq, &seq)) {
+		blocklist_device = (blocklist_find(addr) >= 0);
+
+		if (addr_index_read_valid(&bt_scan.blocklist.seq, seq)) {
+			return blocklist_device;
+		}
+	}
+
+	/* Raced with a blocklist update, search again with the mutex held. */
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+	blocklist_device = (blocklist_find(addr) >= 0);
 	k_mutex_unlock(&scan_mutex);
 
 	return blocklist_device;
@@ -352,14 +588,30 @@ static bool blocklist_device_check(const bt_addr_le_t *addr)
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
 #if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
+static int attempts_filter_find(const bt_addr_le_t *addr)
+{
+	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
+
+	return addr_index_find(filter->slot, ARRAY_SIZE(filter->slot),
+			       filter->addr, ARRAY_SIZE(filter->addr), addr);
+}
+
 static void attempts_filter_force_add(struct conn_attempts_filter *filter,
 				      const bt_addr_le_t *addr)
 {
+	uint32_t idx = filter->oldest_idx;
+
 	/* Overwrite the oldest device */
-	filter->device[filter->oldest_idx].attempts = 0;
-	bt_addr_le_copy(&filter->device[filter->oldest_idx].addr, addr);
+	addr_index_remove(filter->slot, ARRAY_SIZE(filter->slot),
+			  filter->addr, idx);
 
-	if (filter->oldest_idx == (ARRAY_SIZE(filter->device) - 1)) {
+	filter->attempts[idx] = 0;
+	bt_addr_le_copy(&filter->addr[idx], addr);
+
+	addr_index_insert(filter->slot, ARRAY_SIZE(filter->slot),
+			  filter->addr, idx);
+
+	if (filter->oldest_idx == (ARRAY_SIZE(filter->addr) - 1)) {
 		filter->oldest_idx = 0;
 
 		return;
@@ -378,24 +630,26 @@ static void scan_attempts_filter_device_add(const bt_addr_le_t *addr)
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
 	/* Check if device is already in the filter array. */
-	for (size_t i = 0; i < filter->count; i++) {
-		struct conn_attempts_device *device = &filter->device[i];
-
-		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
-			LOG_DBG("Device %s is already in the filter array",
-				addr_str);
-			goto out;
-		}
+	if (attempts_filter_find(addr) >= 0) {
+		LOG_DBG("Device %s is already in the filter array", addr_str);
+		goto out;
 	}
 
-	if (filter->count >= ARRAY_SIZE(filter->device)) {
+	addr_index_write_begin(&filter->seq);
+
+	if (filter->count >= ARRAY_SIZE(filter->addr)) {
 		LOG_DBG("Force adding %s device filter", addr_str);
 		attempts_filter_force_add(filter, addr);
 	} else {
-		bt_addr_le_copy(&filter->device[filter->count].addr, addr);
+		filter->attempts[filter->count] = 0;
+		bt_addr_le_copy(&filter->addr[filter->count], addr);
+		addr_index_insert(filter->slot, ARRAY_SIZE(filter->slot),
+				  filter->addr, filter->count);
 		filter->count++;
 	}
 
+	addr_index_write_end(&filter->seq);
+
 out:
 	k_mutex_unlock(&scan_mutex);
 }
@@ -404,56 +658,191 @@ static void device_conn_attempts_count(struct bt_conn *conn)
 {
 	const bt_addr_le_t *addr = bt_conn_get_dst(conn);
 	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
+	int idx;
 
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
-	for (size_t i = 0; i < filter->count; i++) {
-		struct conn_attempts_device *device = &filter->device[i];
-
-		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
-			if (device->attempts < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT) {
-				device->attempts++;
-			}
-
-			break;
-		}
+	idx = attempts_filter_find(addr);
+	if ((idx >= 0) &&
+	    (filter->attempts[idx] < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT)) {
+		addr_index_write_begin(&filter->seq);
+		filter->attempts[idx]++;
+		addr_index_write_end(&filter->seq);
 	}
 
 	k_mutex_unlock(&scan_mutex);
 }
 
-static bool conn_attempts_exceeded(const bt_addr_le_t *addr)
+static bool attempts_filter_exceeded(const bt_addr_le_t *addr)
 {
 	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
-	char addr_str[BT_ADDR_LE_STR_LEN];
-	bool attempts_exceeded = false;
+	int idx = attempts_filter_find(addr);
 
-	bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
-
-	k_mutex_lock(&scan_mutex, K_FOREVER);
+	return (idx >= 0) &&
+	       (filter->attempts[idx] >= CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT);
+}
 
-	/* Check if the device is in the filter array. */
-	for (size_t i = 0; i < filter->count; i++) {
-		struct conn_attempts_device *device = &filter->device[i];
+static bool conn_attempts_exceeded(const bt_addr_le_t *addr)
+{
+	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
+	atomic_val_t seq;
+	bool attempts_exceeded;
 
-		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
-			if (device->attempts >= CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT) {
-				LOG_DBG("Connection attempts count for %s exceeded",
-					addr_str);
-				attempts_exceeded = true;
-			}
+	/* Search without the mutex first, as this is done for every
+	 * advertising report.
+	 */
+	if (addr_index_read_begin(&filter->seq, &seq)) {
+		attempts_exceeded = attempts_filter_exceeded(addr);
 
-			break;
+		if (addr_index_read_valid(&filter->seq, seq)) {
+			goto out;
 		}
 	}
 
+	/* Raced with a filter update, search again with the mutex held. */
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+	attempts_exceeded = attempts_filter_exceeded(addr);
 	k_mutex_unlock(&scan_mutex);
 
+out:
+	if (attempts_exceeded) {
+		char addr_str[BT_ADDR_LE_STR_LEN];
+
+		bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
+		LOG_DBG("Connection attempts count for %s exceeded", addr_str);
+	}
+
 	return attempts_exceeded;
 }
 
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
+#if CONFIG_BT_SCAN_DEDUP
+static void dedup_cache_init(void)
+{
+	struct dedup_cache *cache = &bt_scan.dedup;
+
+	memset(cache, 0, sizeof(*cache));
+	sys_dlist_init(&cache->lru);
+}
+
+static size_t dedup_entry_get(const bt_addr_le_t *addr)
+{
+	struct dedup_cache *cache = &bt_scan.dedup;
+	struct dedup_entry *entry;
+	int idx;
+
+	idx = addr_index_find(cache->slot, ARRAY_SIZE(cache->slot),
+			      cache->addr, cache->count, addr);
+	if (idx >= 0) {
+		entry = &cache->entry[idx];
+		sys_dlist_remove(&entry->node);
+		sys_dlist_prepend(&cache->lru, &entry->node);
+
+		return idx;
+	}
+
+	if (cache->count < ARRAY_SIZE(cache->entry)) {
+		idx = cache->count++;
+	} else {
+		/* Reuse the least recently used entry. */
+		entry = CONTAINER_OF(sys_dlist_peek_tail(&cache->lru),
+				     struct dedup_entry, node);
+		idx = entry - cache->entry;
+
+		addr_index_remove(cache->slot, ARRAY_SIZE(cache->slot),
+				  cache->addr, idx);
+		sys_dlist_remove(&entry->node);
+	}
+
+	entry = &cache->entry[idx];
+	memset(entry, 0, sizeof(*entry));
+	bt_addr_le_copy(&cache->addr[idx], addr);
+
+	addr_index_insert(cache->slot, ARRAY_SIZE(cache->slot), cache->addr,
+			  idx);
+	sys_dlist_prepend(&cache->lru, &entry->node);
+
+	return idx;
+}
+
+static void dedup_rssi_add(struct dedup_entry *entry, int8_t rssi)
+{
+	if (rssi == BT_HCI_LE_RSSI_NOT_AVAILABLE) {
+		return;
+	}
+
+	if ((entry->rssi_cnt == 0) || (rssi < entry->rssi_min)) {
+		entry->rssi_min = rssi;
+	}
+
+	if ((entry->rssi_cnt == 0) || (rssi > entry->rssi_max)) {
+		entry->rssi_max = rssi;
+	}
+
+	entry->rssi_sum += rssi;
+
+	if (entry->rssi_cnt < UINT16_MAX) {
+		entry->rssi_cnt++;
+	} else {
+		/* Keep the average while preventing the sum overflow. */
+		entry->rssi_sum -= entry->rssi_sum / entry->rssi_cnt;
+	}
+}
+
+/* Returns true if the report is unchanged since the last report from the
+ * device. Forced reports are always reported.
+ */
+static bool dedup_report_suppress(const struct bt_le_scan_recv_info *info,
+				  const struct net_buf_simple *ad, bool force,
+				  struct bt_scan_rssi_stats *rssi_stats)
+{
+	struct dedup_cache *cache = &bt_scan.dedup;
+	struct dedup_entry *entry;
+	struct dedup_payload *payload;
+	uint32_t now = k_uptime_get_32();
+	uint32_t hash;
+	bool scan_rsp;
+
+	scan_rsp = (info->adv_type == BT_GAP_ADV_TYPE_SCAN_RSP) ||
+		   ((info->adv_props & BT_GAP_ADV_PROP_SCAN_RESPONSE) != 0);
+
+	hash = fnv1a_hash(FNV1A_OFFSET_BASIS, &info->adv_type,
+			  sizeof(info->adv_type));
+	hash = fnv1a_hash(hash, ad->data, ad->len);
+
+	entry = &cache->entry[dedup_entry_get(info->addr)];
+	payload = &entry->payload[scan_rsp ? 1 : 0];
+
+	dedup_rssi_add(entry, info->rssi);
+
+	if (!force && payload->valid && (payload->hash == hash) &&
+	    ((now - payload->timestamp) < CONFIG_BT_SCAN_DEDUP_WINDOW_MS)) {
+		return true;
+	}
+
+	payload->hash = hash;
+	payload->timestamp = now;
+	payload->valid = true;
+
+	rssi_stats->count = entry->rssi_cnt;
+	if (entry->rssi_cnt > 0) {
+		rssi_stats->min = entry->rssi_min;
+		rssi_stats->max = entry->rssi_max;
+		rssi_stats->avg = entry->rssi_sum / entry->rssi_cnt;
+	} else {
+		rssi_stats->min = BT_HCI_LE_RSSI_NOT_AVAILABLE;
+		rssi_stats->max = BT_HCI_LE_RSSI_NOT_AVAILABLE;
+		rssi_stats->avg = BT_HCI_LE_RSSI_NOT_AVAILABLE;
+	}
+
+	entry->rssi_sum = 0;
+	entry->rssi_cnt = 0;
+
+	return false;
+}
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 static bool scan_device_filter_check(const bt_addr_le_t *addr)
 {
 #if CONFIG_BT_SCAN_BLOCKLIST
@@ -1338,6 +1727,10 @@ void bt_scan_init(const struct bt_scan_init_param *init)
 	/* Disable all scanning filters. */
 	memset(&bt_scan.scan_filters, 0, sizeof(bt_scan.scan_filters));
 
+#if CONFIG_BT_SCAN_DEDUP
+	dedup_cache_init();
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 	/* If the pointer to the initialization structure exist,
 	 * use it to scan the configuration.
 	 */
@@ -1461,24 +1854,40 @@ static bool adv_data_found(struct bt_data *data, void *user_data)
 static void filter_state_check(struct bt_scan_control *control,
 			       const bt_addr_le_t *addr)
 {
+	bool match;
+#if CONFIG_BT_SCAN_DEDUP
+	bool connect = false;
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
 	if (!scan_device_filter_check(addr)) {
 		return;
 	}
 
-	if (control->all_mode &&
-	    (control->filter_match_cnt == control->filter_cnt)) {
-		notify_filter_matched(&control->device_info,
-				      &control->filter_status,
-				      control->connectable);
+	/* In the normal filter mode, only one filter match is
+	 * needed to generate the notification to the main application.
+	 */
+	if (control->all_mode) {
+		match = (control->filter_match_cnt == control->filter_cnt);
+	} else {
+		match = control->filter_match;
+	}
+
+#if CONFIG_BT_SCAN_DEDUP
 #if CONFIG_BT_CENTRAL
-		scan_connect_with_target(control, addr);
+	connect = match && bt_scan.connect_if_match;
 #endif /* CONFIG_BT_CENTRAL */
-	}
 
-	/* In the normal filter mode, only one filter match is
-	 * needed to generate the notification to the main application.
+	/* Unchanged reports are not passed to the application, unless they
+	 * trigger the automatic connection.
 	 */
-	else if ((!control->all_mode) && control->filter_match) {
+	if (dedup_report_suppress(control->device_info.recv_info,
+				  control->device_info.adv_data, connect,
+				  &control->rssi_stats)) {
+		return;
+	}
+#endif /* CONFIG_BT_SCAN_DEDUP */
+
+	if (match) {
 		notify_filter_matched(&control->device_info,
 				      &control->filter_status,
 				      control->connectable);
@@ -1520,6 +1929,9 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 	scan_control.device_info.recv_info = info;
 	scan_control.device_info.conn_param = &bt_scan.conn_param;
 	scan_control.device_info.adv_data = ad;
+#if CONFIG_BT_SCAN_DEDUP
+	scan_control.device_info.rssi_stats = &scan_control.rssi_stats;
+#endif /* CONFIG_BT_SCAN_DEDUP */
 
 	/* In the multifilter mode, the number of the active filters must equal
 	 * the number of the filters matched to generate the notification.
@@ -1577,6 +1989,7 @@ int bt_scan_params_set(struct bt_le_scan_param *scan_param)
 #if CONFIG_BT_SCAN_BLOCKLIST
 int bt_scan_blocklist_device_add(const bt_addr_le_t *addr)
 {
+	struct conn_blocklist *blocklist = &bt_scan.blocklist;
 	int err = 0;
 	char addr_str[BT_ADDR_LE_STR_LEN];
 
@@ -1589,22 +2002,22 @@ int bt_scan_blocklist_device_add(const bt_addr_le_t *addr)
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
 	/* Check if the device is already on the blocklist. */
-	for (size_t i = 0; i < ARRAY_SIZE(bt_scan.blocklist.addr); i++) {
-		if (bt_addr_le_cmp(&bt_scan.blocklist.addr[i], addr) == 0) {
-			LOG_DBG("Device %s is already on the blocklist",
-				addr_str);
+	if (blocklist_find(addr) >= 0) {
+		LOG_DBG("Device %s is already on the blocklist", addr_str);
 
-			goto out;
-		}
+		goto out;
 	}
 
-	if (bt_scan.blocklist.count >= ARRAY_SIZE(bt_scan.blocklist.addr)) {
+	if (blocklist->count >= ARRAY_SIZE(blocklist->addr)) {
 		LOG_ERR("No place for the new device");
 		err = -ENOMEM;
 	} else {
-		bt_addr_le_copy(&bt_scan.blocklist.addr[bt_scan.blocklist.count],
-				addr);
-		bt_scan.blocklist.count++;
+		addr_index_write_begin(&blocklist->seq);
+		bt_addr_le_copy(&blocklist->addr[blocklist->count], addr);
+		addr_index_insert(blocklist->slot, ARRAY_SIZE(blocklist->slot),
+				  blocklist->addr, blocklist->count);
+		blocklist->count++;
+		addr_index_write_end(&blocklist->seq);
 		LOG_INF("Device %s added to the scanning blocklist", addr_str);
 	}
 
@@ -1616,8 +2029,14 @@ out:
 
 void bt_scan_blocklist_clear(void)
 {
+	struct conn_blocklist *blocklist = &bt_scan.blocklist;
+
 	k_mutex_lock(&scan_mutex, K_FOREVER);
-	memset(&bt_scan.blocklist, 0, sizeof(bt_scan.blocklist));
+	addr_index_write_begin(&blocklist->seq);
+	memset(blocklist->addr, 0, sizeof(blocklist->addr));
+	memset(blocklist->slot, 0, sizeof(blocklist->slot));
+	blocklist->count = 0;
+	addr_index_write_end(&blocklist->seq);
 	k_mutex_unlock(&scan_mutex);
 }
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
@@ -1625,8 +2044,16 @@ void bt_scan_blocklist_clear(void)
 #if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
 void bt_scan_conn_attempts_filter_clear(void)
 {
+	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
+
 	k_mutex_lock(&scan_mutex, K_FOREVER);
-	memset(&bt_scan.attempts_filter, 0, sizeof(bt_scan.attempts_filter));
+	addr_index_write_begin(&filter->seq);
+	memset(filter->addr, 0, sizeof(filter->addr));
+	memset(filter->attempts, 0, sizeof(filter->attempts));
+	memset(filter->slot, 0, sizeof(filter->slot));
+	filter->oldest_idx = 0;
+	filter->count = 0;
+	addr_index_write_end(&filter->seq);
 	k_mutex_unlock(&scan_mutex);
 }
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
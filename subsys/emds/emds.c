@@ -86,6 +86,23 @@ static sys_slist_t emds_dynamic_entries;
 static struct emds_partition partition[PARTITIONS_NUM_MAX];
 static emds_store_cb_t app_store_cb;
 
+#if CONFIG_EMDS_INCREMENTAL
+#define BASE_REF_SIZE (sizeof(struct emds_data_entry) + sizeof(struct emds_base_ref))
+
+/* Full snapshot that the next incremental snapshot is stored on top of. */
+static struct emds_snapshot_candidate base_snapshot;
+static bool incremental;
+
+/* State of the entries relative to the base snapshot, in the order in which
+ * the entries are stored. Entries past the end of the table are always stored.
+ */
+static struct {
+	uint32_t crc;
+	bool in_base;
+	bool dirty;
+} entry_state[CONFIG_EMDS_INCREMENTAL_ENTRIES_MAX];
+#endif
+
 static void emds_print_init_info(void)
 {
 	LOG_DBG("EMDS initialized with the following partitions:");
@@ -173,6 +190,10 @@ int emds_entry_add(struct emds_dynamic_entry *entry)
 		return -ECANCELED;
 	}
 
+	if (IS_ENABLED(CONFIG_EMDS_INCREMENTAL) && entry->entry.id == EMDS_BASE_REF_ENTRY_ID) {
+		return -EINVAL;
+	}
+
 	STRUCT_SECTION_FOREACH(emds_entry, static_entry) {
 		if (static_entry->id == entry->entry.id) {
 			return -EINVAL;
@@ -227,11 +248,57 @@ bool emds_is_ready(void)
 	return emds_state == EMDS_STATE_READY;
 }
 
+#if CONFIG_EMDS_INCREMENTAL
+static bool entry_dirty_check(const struct emds_entry *entry, int idx, bool update)
+{
+	bool dirty;
+
+	if (idx >= CONFIG_EMDS_INCREMENTAL_ENTRIES_MAX) {
+		return true;
+	}
+
+	dirty = !entry_state[idx].in_base ||
+		(entry_state[idx].crc != crc32_k_4_2_update(0, entry->data, entry->len));
+
+	if (update) {
+		entry_state[idx].dirty = dirty;
+	}
+
+	return dirty;
+}
+
+/* Returns the size of an incremental snapshot of the entries that have changed since
+ * the base snapshot. Their dirty state is only updated when storing, as the data may
+ * still change before that.
+ */
+static size_t entries_dirty_size(bool update)
+{
+	size_t size = BASE_REF_SIZE;
+	int idx = 0;
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		if (entry_dirty_check(ch, idx++, update)) {
+			size += ch->len + sizeof(struct emds_data_entry);
+		}
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		if (entry_dirty_check(&ch->entry, idx++, update)) {
+			size += ch->entry.len + sizeof(struct emds_data_entry);
+		}
+	}
+
+	return size;
+}
+#endif
+
 int emds_store_time_get(uint32_t *store_time)
 {
 	size_t store_size = 0;
 	size_t words;
-	int chunk_handling;
+	size_t chunk_handling;
 	int rc;
 
 	rc = emds_store_size_get(&store_size);
@@ -239,9 +306,19 @@ int emds_store_time_get(uint32_t *store_time)
 		return rc;
 	}
 
+	chunk_handling = DIV_ROUND_UP(store_size, CHUNK_SIZE);
+
+#if CONFIG_EMDS_INCREMENTAL
+	/* All chunks are still handled to check the entries for changes, but only the
+	 * changed ones are written. The snapshot is stored in full if it is not smaller.
+	 */
+	if (incremental) {
+		store_size = MIN(entries_dirty_size(false), store_size);
+	}
+#endif
+
 	words = DIV_ROUND_UP(store_size, 4);
 	words += DIV_ROUND_UP(sizeof(struct emds_snapshot_metadata), 4);
-	chunk_handling = DIV_ROUND_UP(store_size, CHUNK_SIZE);
 
 	*store_time = words * CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US;
 	*store_time += chunk_handling * CONFIG_EMDS_CHUNK_PREPARATION_TIME_US;
@@ -291,7 +368,12 @@ static int emds_read_data(const struct flash_area *fa, struct emds_snapshot_meta
 		data_len -= sizeof(entry);
 		flash_entry_data_len = entry.length;
 
-		data_buf = emds_entry_memory_get(&entry);
+		if (IS_ENABLED(CONFIG_EMDS_INCREMENTAL) && entry.id == EMDS_BASE_REF_ENTRY_ID) {
+			/* The base snapshot has already been read. */
+			data_buf = NULL;
+		} else {
+			data_buf = emds_entry_memory_get(&entry);
+		}
 
 		if (data_buf) {
 			rc = flash_area_read(fa, data_off, data_buf, entry.length);
@@ -308,6 +390,150 @@ static int emds_read_data(const struct flash_area *fa, struct emds_snapshot_meta
 	return 0;
 }
 
+#if CONFIG_EMDS_INCREMENTAL
+/* Finds the entry stored at the given position, or returns -ENOENT. */
+static int entry_idx_find(uint16_t id, size_t len)
+{
+	int idx = 0;
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		if (ch->id == id) {
+			return ch->len == len ? idx : -ENOENT;
+		}
+		idx++;
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		if (ch->entry.id == id) {
+			return ch->entry.len == len ? idx : -ENOENT;
+		}
+		idx++;
+	}
+
+	return -ENOENT;
+}
+
+static int flash_data_crc(const struct flash_area *fa, off_t data_off, size_t len, uint32_t *crc)
+{
+	uint8_t data_chunk[CHUNK_SIZE];
+	size_t chunk_size;
+	int rc;
+
+	*crc = 0;
+
+	while (len > 0) {
+		chunk_size = MIN(len, sizeof(data_chunk));
+		rc = flash_area_read(fa, data_off, data_chunk, chunk_size);
+		if (rc) {
+			return rc;
+		}
+
+		*crc = crc32_k_4_2_update(*crc, data_chunk, chunk_size);
+		data_off += chunk_size;
+		len -= chunk_size;
+	}
+
+	return 0;
+}
+
+/* Records the CRC of each entry stored in the base snapshot, to find the
+ * entries that have changed since then when storing.
+ */
+static int entry_state_init(void)
+{
+	const struct flash_area *fa = partition[base_snapshot.partition_index].fa;
+	struct emds_data_entry entry;
+	off_t data_off = base_snapshot.metadata.data_instance_off;
+	int32_t data_len = base_snapshot.metadata.data_instance_len;
+	uint32_t crc;
+	int idx;
+	int rc = 0;
+
+	memset(entry_state, 0, sizeof(entry_state));
+
+	while (data_len > 0) {
+		rc = flash_area_read(fa, data_off, &entry, sizeof(entry));
+		if (rc) {
+			break;
+		}
+
+		data_off += sizeof(entry);
+		data_len -= sizeof(entry);
+
+		idx = entry_idx_find(entry.id, entry.length);
+		if (idx >= 0 && idx < CONFIG_EMDS_INCREMENTAL_ENTRIES_MAX) {
+			rc = flash_data_crc(fa, data_off, entry.length, &crc);
+			if (rc) {
+				break;
+			}
+
+			entry_state[idx].crc = crc;
+			entry_state[idx].in_base = true;
+		}
+
+		data_off += entry.length;
+		data_len -= entry.length;
+	}
+
+	if (rc) {
+		LOG_ERR("Failed to read base snapshot: %d", rc);
+		memset(entry_state, 0, sizeof(entry_state));
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/* Reads the base snapshot if the freshest snapshot is an incremental one. */
+static int base_snapshot_load(void)
+{
+	int idx = freshest_snapshot.partition_index;
+	const struct flash_area *fa = partition[idx].fa;
+	off_t data_off = freshest_snapshot.metadata.data_instance_off;
+	struct emds_data_entry entry;
+	struct emds_base_ref ref;
+	int rc;
+
+	base_snapshot = freshest_snapshot;
+
+	if (freshest_snapshot.metadata.data_instance_len < BASE_REF_SIZE) {
+		return 0;
+	}
+
+	rc = flash_area_read(fa, data_off, &entry, sizeof(entry));
+	if (rc) {
+		LOG_ERR("Failed to read data entry: %d", rc);
+		return -EIO;
+	}
+
+	if (entry.id != EMDS_BASE_REF_ENTRY_ID) {
+		return 0;
+	}
+
+	rc = flash_area_read(fa, data_off + sizeof(entry), &ref, sizeof(ref));
+	if (rc) {
+		LOG_ERR("Failed to read base snapshot reference: %d", rc);
+		return -EIO;
+	}
+
+	rc = emds_flash_snapshot_get(&partition[idx], ref.metadata_off, ref.fresh_cnt,
+				     &base_snapshot);
+	if (rc) {
+		LOG_ERR("Base snapshot with fresh_cnt %u not found: %d", ref.fresh_cnt, rc);
+		memset(&base_snapshot, 0, sizeof(base_snapshot));
+		return -EIO;
+	}
+
+	base_snapshot.partition_index = idx;
+
+	LOG_DBG("Loading base snapshot with fresh_cnt %u", ref.fresh_cnt);
+
+	return emds_read_data(fa, &base_snapshot.metadata);
+}
+#endif /* CONFIG_EMDS_INCREMENTAL */
+
 int emds_load(void)
 {
 	struct emds_snapshot_candidate candidate = {0};
@@ -316,6 +542,11 @@ int emds_load(void)
 		return -ECANCELED;
 	}
 
+#if CONFIG_EMDS_INCREMENTAL
+	memset(&base_snapshot, 0, sizeof(base_snapshot));
+	incremental = false;
+#endif
+
 	for (int i = 0; i < PARTITIONS_NUM_MAX; i++) {
 		if (emds_flash_scan_partition(&partition[i], &candidate)) {
 			LOG_ERR("Failed to scan partition: %d", i);
@@ -338,6 +569,14 @@ int emds_load(void)
 	LOG_DBG("Found freshest snapshot in partition %d with fresh_cnt %u",
 		freshest_snapshot.partition_index, freshest_snapshot.metadata.fresh_cnt);
 
+#if CONFIG_EMDS_INCREMENTAL
+	int rc = base_snapshot_load();
+
+	if (rc) {
+		return rc;
+	}
+#endif
+
 	return emds_read_data(partition[freshest_snapshot.partition_index].fa,
 			      &freshest_snapshot.metadata);
 }
@@ -362,6 +601,27 @@ int emds_prepare(void)
 	/* First try to allocate snapshot in the same partition where freshest snapshot exists */
 	if (freshest_snapshot.metadata.fresh_cnt > 0) {
 		freshest_partition_idx = freshest_snapshot.partition_index;
+
+#if CONFIG_EMDS_INCREMENTAL
+		/* The base snapshot must stay in the partition of the incremental
+		 * one, as the other partition may be erased by the next prepare.
+		 */
+		incremental = false;
+		if (base_snapshot.metadata.fresh_cnt > 0 &&
+		    base_snapshot.partition_index == freshest_partition_idx) {
+			rc = emds_flash_allocate_snapshot(&partition[freshest_partition_idx],
+							  &freshest_snapshot, &allocated_snapshot,
+							  data_size + BASE_REF_SIZE);
+			if (rc == 0) {
+				(void)entry_state_init();
+				incremental = true;
+				allocated_snapshot.partition_index = freshest_partition_idx;
+				emds_state = EMDS_STATE_READY;
+				return 0;
+			}
+		}
+#endif
+
 		rc = emds_flash_allocate_snapshot(&partition[freshest_partition_idx],
 						  &freshest_snapshot, &allocated_snapshot,
 						  data_size);
@@ -417,8 +677,22 @@ static void data_to_stream(const struct emds_partition *partition, off_t *data_o
 			   uint8_t *out, size_t *wp, size_t len)
 {
 	size_t rp = 0;
+	size_t bulk_len;
 
 	while (rp != len) {
+		/* When the chunk buffer is empty, whole chunks of word-aligned data
+		 * are written directly from the entry memory in one go.
+		 */
+		bulk_len = ROUND_DOWN(len - rp, CHUNK_SIZE);
+		if (*wp == 0 && bulk_len && IS_ALIGNED(in + rp, sizeof(uint32_t))) {
+			allocated_snapshot.metadata.snapshot_crc = crc32_k_4_2_update(
+				allocated_snapshot.metadata.snapshot_crc, in + rp, bulk_len);
+			emds_flash_write_data(partition, *data_off, in + rp, bulk_len);
+			*data_off += bulk_len;
+			rp += bulk_len;
+			continue;
+		}
+
 		data_stream_pack(in, out, wp, &rp, len);
 		if (*wp == CHUNK_SIZE) {
 			allocated_snapshot.metadata.snapshot_crc = crc32_k_4_2_update(
@@ -443,6 +717,54 @@ static void entry_to_stream(const struct emds_partition *partition, off_t *data_
 	data_to_stream(partition, data_off, entry->data, out, wp, entry->len);
 }
 
+#if CONFIG_EMDS_INCREMENTAL
+/* Shrinks the allocated snapshot to the entries that changed since the base
+ * snapshot, which are then the only ones stored after the base reference. Falls
+ * back to a full snapshot if the incremental one is not smaller.
+ */
+static void snapshot_incremental_init(void)
+{
+	size_t data_size;
+	size_t dirty_size = entries_dirty_size(true);
+
+	(void)emds_store_size_get(&data_size);
+	if (dirty_size >= data_size) {
+		incremental = false;
+		dirty_size = data_size;
+	}
+
+	allocated_snapshot.metadata.data_instance_len = dirty_size;
+	allocated_snapshot.metadata.metadata_crc =
+		crc32_k_4_2_update(0, (const unsigned char *)&allocated_snapshot.metadata,
+				   offsetof(struct emds_snapshot_metadata, metadata_crc));
+}
+
+static void base_ref_to_stream(const struct emds_partition *partition, off_t *data_off,
+			       uint8_t *out, size_t *wp)
+{
+	struct emds_base_ref ref = {
+		.fresh_cnt = base_snapshot.metadata.fresh_cnt,
+		.metadata_off = base_snapshot.metadata_off,
+	};
+	struct emds_entry ref_entry = {
+		.id = EMDS_BASE_REF_ENTRY_ID,
+		.data = (uint8_t *)&ref,
+		.len = sizeof(ref),
+	};
+
+	entry_to_stream(partition, data_off, out, wp, &ref_entry);
+}
+#endif
+
+static bool entry_store_needed(int idx)
+{
+#if CONFIG_EMDS_INCREMENTAL
+	return !incremental || idx >= CONFIG_EMDS_INCREMENTAL_ENTRIES_MAX || entry_state[idx].dirty;
+#else
+	return true;
+#endif
+}
+
 static void stream_fflush(const struct emds_partition *partition, off_t *data_off, uint8_t *out,
 			  size_t *wp)
 {
@@ -462,6 +784,7 @@ int emds_store(void)
 	size_t wp = 0;
 	off_t data_off = allocated_snapshot.metadata.data_instance_off;
 	int idx = allocated_snapshot.partition_index;
+	int entry_idx = 0;
 	int rc = 0;
 
 	if (emds_state != EMDS_STATE_READY) {
@@ -476,6 +799,12 @@ int emds_store(void)
 		goto unlock_and_exit;
 	}
 
+#if CONFIG_EMDS_INCREMENTAL
+	if (incremental) {
+		snapshot_incremental_init();
+	}
+#endif
+
 	if (flash_params_get_erase_cap(partition[idx].fp) & FLASH_ERASE_C_EXPLICIT) {
 		LOG_DBG("Writing metadata on offset: 0x%4lx, address : 0x%4lx",
 			 allocated_snapshot.metadata_off,
@@ -485,14 +814,24 @@ int emds_store(void)
 				      offsetof(struct emds_snapshot_metadata, snapshot_crc));
 	}
 
+#if CONFIG_EMDS_INCREMENTAL
+	if (incremental) {
+		base_ref_to_stream(&partition[idx], &data_off, data_chunk, &wp);
+	}
+#endif
+
 	STRUCT_SECTION_FOREACH(emds_entry, ch) {
-		entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, ch);
+		if (entry_store_needed(entry_idx++)) {
+			entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, ch);
+		}
 	}
 
 	struct emds_dynamic_entry *ch;
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
-		entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, &ch->entry);
+		if (entry_store_needed(entry_idx++)) {
+			entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, &ch->entry);
+		}
 	}
 
 	stream_fflush(&partition[idx], &data_off, data_chunk, &wp);
@@ -541,6 +880,10 @@ int emds_clear(void)
 	emds_state = EMDS_STATE_INITIALIZED;
 	memset(&freshest_snapshot, 0, sizeof(freshest_snapshot));
 	memset(&allocated_snapshot, 0, sizeof(allocated_snapshot));
+#if CONFIG_EMDS_INCREMENTAL
+	memset(&base_snapshot, 0, sizeof(base_snapshot));
+	incremental = false;
+#endif
 	for (int i = 0; i < PARTITIONS_NUM_MAX; i++) {
 		rc = emds_flash_erase_partition(&partition[i]);
 		if (rc) {
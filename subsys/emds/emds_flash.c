@@ -213,6 +213,40 @@ int emds_flash_scan_partition(const struct emds_partition *partition,
 	return 0;
 }
 
+int emds_flash_snapshot_get(const struct emds_partition *partition, off_t metadata_off,
+			    uint32_t fresh_cnt, struct emds_snapshot_candidate *snapshot)
+{
+	const struct flash_area *fa = partition->fa;
+	struct emds_snapshot_metadata metadata;
+	uint32_t crc;
+	int rc;
+
+	if (metadata_off < 0 || (size_t)metadata_off + sizeof(metadata) > fa->fa_size) {
+		return -ENOENT;
+	}
+
+	rc = flash_area_read(fa, metadata_off, &metadata, sizeof(metadata));
+	if (rc) {
+		LOG_ERR("Failed to read snapshot metadata: %d", rc);
+		return -EIO;
+	}
+
+	if (metadata.marker != EMDS_SNAPSHOT_METADATA_MARKER || metadata.fresh_cnt != fresh_cnt) {
+		return -ENOENT;
+	}
+
+	crc = crc32_k_4_2_update(0, (const unsigned char *)&metadata,
+				 offsetof(struct emds_snapshot_metadata, metadata_crc));
+	if (crc != metadata.metadata_crc || !cand_snapshot_crc_check(partition, &metadata)) {
+		return -ENOENT;
+	}
+
+	snapshot->metadata_off = metadata_off;
+	snapshot->metadata = metadata;
+
+	return 0;
+}
+
 int emds_flash_allocate_snapshot(const struct emds_partition *partition,
 				 const struct emds_snapshot_candidate *freshest_snapshot,
 				 struct emds_snapshot_candidate *allocated_snapshot,
@@ -309,14 +343,17 @@ static void nvmc_wait_ready(void)
 }
 
 #if defined CONFIG_SOC_FLASH_NRF_RRAM
-static void commit_changes(const struct emds_partition *partition, size_t len)
+/* Maximum number of 128-bit words in the RRAMC write buffer. */
+#define RRAMC_WRITE_BUFF_SIZE_MAX 32
+
+static void commit_changes(const struct emds_partition *partition, size_t len, uint8_t buff_size)
 {
 	if (nrf_rramc_empty_buffer_check(NRF_RRAMC)) {
 		/* The internal write-buffer has been committed to RRAM and is now empty. */
 		return;
 	}
 
-	if ((len % partition->fp->write_block_size) == 0) {
+	if ((len % (partition->fp->write_block_size * buff_size)) == 0) {
 		/* Our last operation was buffer size-aligned, so we're done. */
 		return;
 	}
@@ -337,20 +374,32 @@ void emds_flash_write_data(const struct emds_partition *partition, off_t data_of
 	nvmc_wait_ready();
 
 #if defined CONFIG_SOC_FLASH_NRF_RRAM
-	/* 1 word of 128bits length */
-	nrf_rramc_config_t config = {.mode_write = true, .write_buff_size = 1};
+	/* Bulk writes are buffered in up to 32 words of 128 bits length, so
+	 * RRAMC commits them in bursts instead of word by word.
+	 */
+	nrf_rramc_config_t config = {
+		.mode_write = true,
+		.write_buff_size = CLAMP(data_size / partition->fp->write_block_size, 1,
+					 RRAMC_WRITE_BUFF_SIZE_MAX),
+	};
 
 	nrf_rramc_config_set(NRF_RRAMC, &config);
 	memcpy((void *)flash_addr, data_chunk, data_size);
 
 	barrier_dmem_fence_full(); /* Barrier following our last write. */
-	commit_changes(partition, data_size);
+	commit_changes(partition, data_size, config.write_buff_size);
 
 	config.mode_write = false;
 	nrf_rramc_config_set(NRF_RRAMC, &config);
 #else
 	uint32_t data_addr = (uint32_t)data_chunk;
 
+	if (IS_ALIGNED(data_addr, sizeof(uint32_t)) && IS_ALIGNED(data_size, sizeof(uint32_t))) {
+		nrfx_nvmc_words_write(flash_addr, data_chunk, data_size / sizeof(uint32_t));
+		nvmc_wait_ready();
+		return;
+	}
+
 	data_size = ROUND_UP(data_size, sizeof(uint32_t));
 
 	while (data_size >= sizeof(uint32_t)) {
@@ -55,6 +55,25 @@ struct emds_data_entry {
 	uint8_t data[];
 } __packed;
 
+/**
+ * @brief Entry ID reserved for the reference to the base snapshot
+ *
+ * An incremental snapshot starts with an entry with this ID, followed by the
+ * data entries that changed since the base snapshot was stored.
+ */
+#define EMDS_BASE_REF_ENTRY_ID 0xFFFF
+
+/**
+ * @brief Emergency data storage base snapshot reference structure
+ *
+ * @param fresh_cnt Increment counter of the base snapshot.
+ * @param metadata_off Offset of the base snapshot metadata within the partition.
+ */
+struct emds_base_ref {
+	uint32_t fresh_cnt;
+	uint32_t metadata_off;
+} __packed;
+
 /**
  * @brief Emergency data storage metadata structure
  *
@@ -129,6 +148,26 @@ int emds_flash_init(struct emds_partition *partition);
 int emds_flash_scan_partition(const struct emds_partition *partition,
 			      struct emds_snapshot_candidate *candidate);
 
+/**
+ * @brief Read and validate the snapshot with the given metadata offset.
+ *
+ * This function is used to find the base snapshot of an incremental snapshot.
+ * The snapshot is valid if its metadata is valid, its fresh_cnt value matches
+ * and its snapshot crc value is correct.
+ *
+ * @param partition Pointer to the emergency data storage partition structure.
+ * @param metadata_off Offset of the snapshot metadata within the partition.
+ * @param fresh_cnt Expected fresh_cnt value of the snapshot.
+ * @param snapshot Pointer to the emergency data storage snapshot candidate structure
+ * that will be filled with the snapshot metadata.
+ *
+ * @retval 0 on success.
+ * @retval -ENOENT if no valid snapshot is found at the given offset.
+ * @retval -EIO if an error occurs during reading.
+ */
+int emds_flash_snapshot_get(const struct emds_partition *partition, off_t metadata_off,
+			    uint32_t fresh_cnt, struct emds_snapshot_candidate *snapshot);
+
 /** * @brief Allocate a new snapshot in the emergency data storage partition.
  *
  * This function allocates a new snapshot in the specified partition based on the
@@ -22,6 +22,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/drivers/gpio.h>
 #if NRF54H_ERRATA_216_PRESENT
 #include <zephyr/drivers/mbox.h>
@@ -178,8 +179,13 @@ struct payload_tx_fifo {
 
 /* First-in, first-out queue of received payloads. */
 struct payload_rx_fifo {
+#if defined(CONFIG_ESB_RX_ZERO_COPY)
+	/* Received payloads, pointing into the radio buffers they were received in. */
+	struct esb_rx_buf buf[CONFIG_ESB_RX_FIFO_SIZE];
+#else
 	 /* Payload queue */
 	struct esb_payload *payload[CONFIG_ESB_RX_FIFO_SIZE];
+#endif /* defined(CONFIG_ESB_RX_ZERO_COPY) */
 
 	uint32_t back;	/* Back of the queue (last in). */
 	uint32_t front;	/* Front of queue (first out). */
@@ -289,15 +295,38 @@ static struct esb_payload *current_payload;
 static struct payload_tx_fifo tx_fifo;
 static struct payload_rx_fifo rx_fifo;
 
-static uint8_t tx_payload_buffer[CONFIG_ESB_MAX_PAYLOAD_LENGTH +
-				 sizeof(struct esb_radio_pdu)];
-static uint8_t rx_payload_buffer[CONFIG_ESB_MAX_PAYLOAD_LENGTH +
-				 sizeof(struct esb_radio_pdu)];
+#define RADIO_PDU_SIZE (CONFIG_ESB_MAX_PAYLOAD_LENGTH + sizeof(struct esb_radio_pdu))
+
+static uint8_t tx_payload_buffer[RADIO_PDU_SIZE];
+
+#if defined(CONFIG_ESB_RX_ZERO_COPY)
+/* One radio buffer more than the RX FIFO can hold, so that the radio always has
+ * a buffer to receive into when the FIFO is full.
+ */
+#define RX_POOL_SIZE (CONFIG_ESB_RX_FIFO_SIZE + 1)
+BUILD_ASSERT(RX_POOL_SIZE <= 32, "RX buffer pool does not fit the free buffer bitfield");
+
+static uint8_t rx_pool[RX_POOL_SIZE][RADIO_PDU_SIZE];
+/* Bitfield of radio buffers that are neither queued, used by the radio, nor
+ * held by the application.
+ */
+static uint32_t rx_pool_free;
+/* Radio buffer that the next packet is received into. */
+static uint8_t *rx_payload_buffer;
+#else
+static uint8_t rx_radio_buffer[RADIO_PDU_SIZE];
+static uint8_t *const rx_payload_buffer = rx_radio_buffer;
+#endif /* defined(CONFIG_ESB_RX_ZERO_COPY) */
 
 /* Random access buffer variables for ACK payload handling */
 struct payload_wrap ack_pl_wrap[CONFIG_ESB_TX_FIFO_SIZE];
 struct payload_wrap *ack_pl_wrap_pipe[CONFIG_ESB_PIPE_COUNT];
 
+/* Per-pipe TX queue scheduling, used with CONFIG_ESB_TX_PIPE_QUEUES */
+static uint8_t pipe_priority[CONFIG_ESB_PIPE_COUNT];
+static uint8_t tx_pipe;	   /* Pipe of the payload that is being transmitted. */
+static uint8_t tx_pipe_rr; /* First pipe to check when priorities are equal. */
+
 /* Run time variables */
 static uint8_t pids[CONFIG_ESB_PIPE_COUNT];
 static struct pipe_info rx_pipe_info[CONFIG_ESB_PIPE_COUNT];
@@ -1044,11 +1073,15 @@ static void reset_fifos(void)
 	rx_fifo.back = 0;
 	rx_fifo.front = 0;
 	rx_fifo.count = 0;
+
+#if defined(CONFIG_ESB_RX_ZERO_COPY)
+	rx_payload_buffer = rx_pool[0];
+	rx_pool_free = BIT_MASK(RX_POOL_SIZE) & ~BIT(0);
+#endif
 }
 
 static void initialize_fifos(void)
 {
-	static struct esb_payload rx_payload[CONFIG_ESB_RX_FIFO_SIZE];
 	static struct esb_payload tx_payload[CONFIG_ESB_TX_FIFO_SIZE];
 
 	reset_fifos();
@@ -1057,9 +1090,13 @@ static void initialize_fifos(void)
 		tx_fifo.payload[i] = &tx_payload[i];
 	}
 
+#if !defined(CONFIG_ESB_RX_ZERO_COPY)
+	static struct esb_payload rx_payload[CONFIG_ESB_RX_FIFO_SIZE];
+
 	for (size_t i = 0; i < CONFIG_ESB_RX_FIFO_SIZE; i++) {
 		rx_fifo.payload[i] = &rx_payload[i];
 	}
+#endif
 
 	for (size_t i = 0; i < CONFIG_ESB_TX_FIFO_SIZE; i++) {
 		ack_pl_wrap[i].p_payload = &tx_payload[i];
@@ -1072,6 +1109,69 @@ static void initialize_fifos(void)
 	}
 }
 
+static bool tx_pipe_queues(void)
+{
+	return IS_ENABLED(CONFIG_ESB_TX_PIPE_QUEUES) && (esb_cfg.mode == ESB_MODE_PTX);
+}
+
+/* Select the pipe to transmit from when using per-pipe TX queues.
+ *
+ * The non-empty queue of the pipe with the highest priority is selected.
+ * Pipes with equal priority are served in turn, starting after the last
+ * selected pipe.
+ */
+static int tx_pipe_select(void)
+{
+	int selected = -1;
+
+	for (size_t i = 0; i < CONFIG_ESB_PIPE_COUNT; i++) {
+		uint8_t pipe = (tx_pipe_rr + i) % CONFIG_ESB_PIPE_COUNT;
+
+		if (ack_pl_wrap_pipe[pipe] == NULL) {
+			continue;
+		}
+
+		if ((selected < 0) || (pipe_priority[pipe] > pipe_priority[selected])) {
+			selected = pipe;
+		}
+	}
+
+	return selected;
+}
+
+/* Get the next payload to transmit. */
+static struct esb_payload *tx_fifo_front(void)
+{
+	int pipe;
+
+	if (!tx_pipe_queues()) {
+		return tx_fifo.payload[tx_fifo.front];
+	}
+
+	pipe = tx_pipe_select();
+	if (pipe < 0) {
+		return NULL;
+	}
+
+	tx_pipe = pipe;
+	tx_pipe_rr = (pipe + 1) % CONFIG_ESB_PIPE_COUNT;
+
+	return ack_pl_wrap_pipe[pipe]->p_payload;
+}
+
+static void tx_queue_remove_first(uint8_t pipe)
+{
+	struct payload_wrap *first = ack_pl_wrap_pipe[pipe];
+
+	if (first == NULL) {
+		return;
+	}
+
+	first->in_use = false;
+	ack_pl_wrap_pipe[pipe] = first->p_next;
+	tx_fifo.count--;
+}
+
 static void tx_fifo_remove_last(void)
 {
 	if (tx_fifo.count == 0) {
@@ -1080,19 +1180,50 @@ static void tx_fifo_remove_last(void)
 
 	unsigned int key = irq_lock();
 
-	tx_fifo.count--;
-	if (++tx_fifo.front >= CONFIG_ESB_TX_FIFO_SIZE) {
-		tx_fifo.front = 0;
+	if (tx_pipe_queues()) {
+		tx_queue_remove_first(tx_pipe);
+	} else {
+		tx_fifo.count--;
+		if (++tx_fifo.front >= CONFIG_ESB_TX_FIFO_SIZE) {
+			tx_fifo.front = 0;
+		}
 	}
 
 	irq_unlock(key);
 }
 
-/*  Function to push the content of the rx_buffer to the RX FIFO.
+/* Get the length of the payload in the received radio PDU. */
+static bool rx_pdu_length_get(const struct esb_radio_pdu *rx_pdu, uint8_t *length)
+{
+	if (esb_cfg.protocol == ESB_PROTOCOL_ESB_DPL) {
+		if (rx_pdu->type.dpl_pdu.length > CONFIG_ESB_MAX_PAYLOAD_LENGTH) {
+			return false;
+		}
+
+		*length = rx_pdu->type.dpl_pdu.length;
+	} else if (esb_cfg.mode == ESB_MODE_PTX) {
+		/* Received packet is an acknowledgment */
+		*length = 0;
+	} else {
+		*length = esb_cfg.payload_length;
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_ESB_RX_ZERO_COPY)
+static bool rx_fifo_full(void)
+{
+	return (rx_fifo.count >= CONFIG_ESB_RX_FIFO_SIZE) || (rx_pool_free == 0);
+}
+
+/*  Function to push the radio buffer to the RX FIFO.
  *
- *  The module will point the register NRF_RADIO->PACKETPTR to a buffer for
- *  receiving packets. After receiving a packet the module will call this
- *  function to copy the received data to the RX FIFO.
+ *  The radio buffer that the packet was received into is handed over to the
+ *  RX FIFO, and NRF_RADIO->PACKETPTR is pointed to a free buffer from the pool
+ *  for the next packet. In monitor mode, the radio restarts reception into the
+ *  same buffer through a shortcut, so the packet is copied into the free
+ *  buffer instead.
  *
  *  @param  pipe Pipe number to set for the packet.
  *  @param  pid  Packet ID.
@@ -1103,22 +1234,76 @@ static void tx_fifo_remove_last(void)
 static bool rx_fifo_push_rfbuf(uint8_t pipe, uint8_t pid)
 {
 	struct esb_radio_pdu *rx_pdu = (struct esb_radio_pdu *)rx_payload_buffer;
+	struct esb_rx_buf *buf = &rx_fifo.buf[rx_fifo.back];
+	uint8_t length;
+	uint8_t idx;
 
-	if (rx_fifo.count >= CONFIG_ESB_RX_FIFO_SIZE) {
+	if (rx_fifo_full() || !rx_pdu_length_get(rx_pdu, &length)) {
 		return false;
 	}
 
-	if (esb_cfg.protocol == ESB_PROTOCOL_ESB_DPL) {
-		if (rx_pdu->type.dpl_pdu.length > CONFIG_ESB_MAX_PAYLOAD_LENGTH) {
-			return false;
-		}
+	idx = u32_count_trailing_zeros(rx_pool_free);
+	rx_pool_free &= ~BIT(idx);
 
-		rx_fifo.payload[rx_fifo.back]->length = rx_pdu->type.dpl_pdu.length;
-	} else if (esb_cfg.mode == ESB_MODE_PTX) {
-		/* Received packet is an acknowledgment */
-		rx_fifo.payload[rx_fifo.back]->length = 0;
+	if (esb_cfg.mode == ESB_MODE_MONITOR) {
+		memcpy(rx_pool[idx], rx_pdu, sizeof(struct esb_radio_pdu) + length);
+		rx_pdu = (struct esb_radio_pdu *)rx_pool[idx];
 	} else {
-		rx_fifo.payload[rx_fifo.back]->length = esb_cfg.payload_length;
+		rx_payload_buffer = rx_pool[idx];
+	}
+
+	buf->data = rx_pdu->data;
+	buf->length = length;
+	buf->pipe = pipe;
+	buf->rssi = nrf_radio_rssi_sample_get(NRF_RADIO);
+	buf->pid = pid;
+	buf->noack = !rx_pdu->type.dpl_pdu.ack;
+
+	if (++rx_fifo.back >= CONFIG_ESB_RX_FIFO_SIZE) {
+		rx_fifo.back = 0;
+	}
+	rx_fifo.count++;
+
+	return true;
+}
+
+/* Get the index of the pool buffer holding the received payload. */
+static int rx_pool_idx_get(const struct esb_rx_buf *buf)
+{
+	ptrdiff_t offset = buf->data - &rx_pool[0][sizeof(struct esb_radio_pdu)];
+
+	if ((offset < 0) || (offset % RADIO_PDU_SIZE) ||
+	    (offset / RADIO_PDU_SIZE >= RX_POOL_SIZE)) {
+		return -EINVAL;
+	}
+
+	return offset / RADIO_PDU_SIZE;
+}
+#else
+static bool rx_fifo_full(void)
+{
+	return rx_fifo.count >= CONFIG_ESB_RX_FIFO_SIZE;
+}
+
+/*  Function to push the content of the rx_buffer to the RX FIFO.
+ *
+ *  The module will point the register NRF_RADIO->PACKETPTR to a buffer for
+ *  receiving packets. After receiving a packet the module will call this
+ *  function to copy the received data to the RX FIFO.
+ *
+ *  @param  pipe Pipe number to set for the packet.
+ *  @param  pid  Packet ID.
+ *
+ *  @retval true   Operation successful.
+ *  @retval false  Operation failed.
+ */
+static bool rx_fifo_push_rfbuf(uint8_t pipe, uint8_t pid)
+{
+	struct esb_radio_pdu *rx_pdu = (struct esb_radio_pdu *)rx_payload_buffer;
+
+	if (rx_fifo_full() ||
+	    !rx_pdu_length_get(rx_pdu, &rx_fifo.payload[rx_fifo.back]->length)) {
+		return false;
 	}
 
 	memcpy(rx_fifo.payload[rx_fifo.back]->data, rx_pdu->data,
@@ -1136,6 +1321,7 @@ static bool rx_fifo_push_rfbuf(uint8_t pipe, uint8_t pid)
 
 	return true;
 }
+#endif /* defined(CONFIG_ESB_RX_ZERO_COPY) */
 
 static void esb_timer_handler(nrf_timer_event_t event_type, void *context)
 {
@@ -1199,7 +1385,7 @@ static void start_tx_transaction(void)
 	struct esb_radio_pdu *pdu = (struct esb_radio_pdu *)tx_payload_buffer;
 	last_tx_attempts = 1;
 	/* Prepare the payload */
-	current_payload = tx_fifo.payload[tx_fifo.front];
+	current_payload = tx_fifo_front();
 
 	switch (esb_cfg.protocol) {
 	case ESB_PROTOCOL_ESB:
@@ -1612,10 +1798,10 @@ static void clear_events_restart_rx(void)
 	radio_start();
 }
 
-static void prepare_ack_pdu_dpl(bool retransmit_payload, struct pipe_info *pipe_info)
+static void prepare_ack_pdu_dpl(bool retransmit_payload, struct pipe_info *pipe_info,
+				const struct esb_radio_pdu *rx_pdu)
 {
 	struct esb_radio_pdu *tx_pdu = (struct esb_radio_pdu *)tx_payload_buffer;
-	struct esb_radio_pdu *rx_pdu = (struct esb_radio_pdu *)rx_payload_buffer;
 
 	uint32_t pipe = nrf_radio_rxmatch_get(NRF_RADIO);
 
@@ -1660,6 +1846,17 @@ static void prepare_ack_pdu_dpl(bool retransmit_payload, struct pipe_info *pipe_
 	tx_pdu->type.dpl_pdu.ack = rx_pdu->type.dpl_pdu.ack;
 }
 
+/* Push the new packet to the RX buffer and trigger a received event if the
+ * operation was successful.
+ */
+static void rx_packet_push(const struct pipe_info *pipe_info)
+{
+	if (rx_fifo_push_rfbuf(nrf_radio_rxmatch_get(NRF_RADIO), pipe_info->pid)) {
+		interrupt_flags |= INT_RX_DATA_RECEIVED_MSK;
+		set_evt_interrupt();
+	}
+}
+
 static void on_radio_disabled_rx(void)
 {
 	bool retransmit_payload = false;
@@ -1673,7 +1870,7 @@ static void on_radio_disabled_rx(void)
 		return;
 	}
 
-	if (rx_fifo.count >= CONFIG_ESB_RX_FIFO_SIZE) {
+	if (rx_fifo_full()) {
 		clear_events_restart_rx();
 		return;
 	}
@@ -1689,13 +1886,22 @@ static void on_radio_disabled_rx(void)
 	pipe_info->pid = rx_pdu->type.dpl_pdu.pid;
 	pipe_info->crc = nrf_radio_rxcrc_get(NRF_RADIO);
 
+#if defined(CONFIG_ESB_RX_ZERO_COPY)
+	/* The packet is queued before the radio is restarted, as pushing it
+	 * hands the radio a new buffer to receive into.
+	 */
+	if (send_rx_event) {
+		rx_packet_push(pipe_info);
+	}
+#endif
+
 	/* Check if an ack should be sent */
 	if ((esb_cfg.selective_auto_ack == false) || rx_pdu->type.dpl_pdu.ack) {
 		esb_fem_for_tx_ack();
 
 		switch (esb_cfg.protocol) {
 		case ESB_PROTOCOL_ESB_DPL:
-			prepare_ack_pdu_dpl(retransmit_payload, pipe_info);
+			prepare_ack_pdu_dpl(retransmit_payload, pipe_info, rx_pdu);
 			break;
 
 		case ESB_PROTOCOL_ESB:
@@ -1727,16 +1933,11 @@ static void on_radio_disabled_rx(void)
 		clear_events_restart_rx();
 	}
 
+#if !defined(CONFIG_ESB_RX_ZERO_COPY)
 	if (send_rx_event) {
-		/* Push the new packet to the RX buffer and trigger a received
-		 * event if the operation was
-		 * successful.
-		 */
-		if (rx_fifo_push_rfbuf(nrf_radio_rxmatch_get(NRF_RADIO), pipe_info->pid)) {
-			interrupt_flags |= INT_RX_DATA_RECEIVED_MSK;
-			set_evt_interrupt();
-		}
+		rx_packet_push(pipe_info);
 	}
+#endif
 }
 
 static void on_radio_disabled_rx_send_ack(void)
@@ -2196,7 +2397,7 @@ int esb_write_payload(const struct esb_payload *payload)
 
 	unsigned int key = irq_lock();
 
-	if (esb_cfg.mode == ESB_MODE_PTX) {
+	if (esb_cfg.mode == ESB_MODE_PTX && !tx_pipe_queues()) {
 		memcpy(tx_fifo.payload[tx_fifo.back], payload, sizeof(struct esb_payload));
 
 		pids[payload->pipe] = (pids[payload->pipe] + 1) % (PID_MAX + 1);
@@ -2243,6 +2444,103 @@ int esb_write_payload(const struct esb_payload *payload)
 	return 0;
 }
 
+#if defined(CONFIG_ESB_RX_ZERO_COPY)
+int esb_get_rx_buf(struct esb_rx_buf *buf)
+{
+	if (!esb_initialized) {
+		return -EACCES;
+	}
+	if (buf == NULL) {
+		return -EINVAL;
+	}
+
+	if (rx_fifo.count == 0) {
+		return -ENODATA;
+	}
+
+	unsigned int key = irq_lock();
+
+	*buf = rx_fifo.buf[rx_fifo.front];
+
+	if (++rx_fifo.front >= CONFIG_ESB_RX_FIFO_SIZE) {
+		rx_fifo.front = 0;
+	}
+
+	rx_fifo.count--;
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+int esb_release_rx_buf(const struct esb_rx_buf *buf)
+{
+	int idx;
+
+	if (!esb_initialized) {
+		return -EACCES;
+	}
+	if (buf == NULL) {
+		return -EINVAL;
+	}
+
+	idx = rx_pool_idx_get(buf);
+	if (idx < 0) {
+		return idx;
+	}
+
+	unsigned int key = irq_lock();
+
+	if (rx_pool_free & BIT(idx)) {
+		irq_unlock(key);
+		return -EALREADY;
+	}
+
+	rx_pool_free |= BIT(idx);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+int esb_read_rx_payload(struct esb_payload *payload)
+{
+	struct esb_rx_buf buf;
+	int err;
+
+	if (payload == NULL) {
+		return -EINVAL;
+	}
+
+	err = esb_get_rx_buf(&buf);
+	if (err) {
+		return err;
+	}
+
+	payload->length = buf.length;
+	payload->pipe = buf.pipe;
+	payload->rssi = buf.rssi;
+	payload->pid = buf.pid;
+	payload->noack = buf.noack;
+	memcpy(payload->data, buf.data, buf.length);
+
+	return esb_release_rx_buf(&buf);
+}
+#else
+int esb_get_rx_buf(struct esb_rx_buf *buf)
+{
+	ARG_UNUSED(buf);
+
+	return -ENOTSUP;
+}
+
+int esb_release_rx_buf(const struct esb_rx_buf *buf)
+{
+	ARG_UNUSED(buf);
+
+	return -ENOTSUP;
+}
+
 int esb_read_rx_payload(struct esb_payload *payload)
 {
 	if (!esb_initialized) {
@@ -2276,6 +2574,7 @@ int esb_read_rx_payload(struct esb_payload *payload)
 
 	return 0;
 }
+#endif /* defined(CONFIG_ESB_RX_ZERO_COPY) */
 
 int esb_start_tx(void)
 {
@@ -2373,16 +2672,43 @@ int esb_pop_tx(void)
 
 	unsigned int key = irq_lock();
 
-	if (++tx_fifo.back >= CONFIG_ESB_TX_FIFO_SIZE) {
-		tx_fifo.back = 0;
+	if (tx_pipe_queues()) {
+		/* The pipe of the last transmitted or failed payload, as the round-robin
+		 * selection has already moved on to the next pipe.
+		 */
+		if (ack_pl_wrap_pipe[tx_pipe] == NULL) {
+			irq_unlock(key);
+			return -ENODATA;
+		}
+
+		tx_queue_remove_first(tx_pipe);
+	} else {
+		if (++tx_fifo.back >= CONFIG_ESB_TX_FIFO_SIZE) {
+			tx_fifo.back = 0;
+		}
+		tx_fifo.count--;
 	}
-	tx_fifo.count--;
 
 	irq_unlock(key);
 
 	return 0;
 }
 
+int esb_set_pipe_priority(uint8_t pipe, uint8_t priority)
+{
+	if (!IS_ENABLED(CONFIG_ESB_TX_PIPE_QUEUES)) {
+		return -ENOTSUP;
+	}
+
+	if (pipe >= CONFIG_ESB_PIPE_COUNT) {
+		return -EINVAL;
+	}
+
+	pipe_priority[pipe] = priority;
+
+	return 0;
+}
+
 bool esb_tx_full(void)
 {
 	return tx_fifo.count >= CONFIG_ESB_TX_FIFO_SIZE;
@@ -2396,6 +2722,21 @@ int esb_flush_rx(void)
 
 	unsigned int key = irq_lock();
 
+#if defined(CONFIG_ESB_RX_ZERO_COPY)
+	/* Return the queued buffers to the pool. Buffers held by the
+	 * application must still be released by it.
+	 */
+	while (rx_fifo.count) {
+		rx_pool_free |= BIT(rx_pool_idx_get(&rx_fifo.buf[rx_fifo.front]));
+
+		if (++rx_fifo.front >= CONFIG_ESB_RX_FIFO_SIZE) {
+			rx_fifo.front = 0;
+		}
+
+		rx_fifo.count--;
+	}
+#endif
+
 	rx_fifo.count = 0;
 	rx_fifo.back = 0;
 	rx_fifo.front = 0;
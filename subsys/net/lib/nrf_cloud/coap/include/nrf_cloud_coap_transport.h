@@ -35,6 +35,10 @@ struct nrf_cloud_coap_client {
 };
 
 #define NRF_CLOUD_COAP_PROXY_RSC "proxy"
+#define COAP_D2C_RSC "msg/d2c"
+#define COAP_D2C_BULK_RSC COAP_D2C_RSC "/bulk"
+#define COAP_D2C_RAW_RSC COAP_D2C_RSC "/raw"
+#define COAP_D2C_BIN_RSC COAP_D2C_RSC "/bin"
 
 /**
  * @defgroup nrf_cloud_coap_transport nRF CoAP API
@@ -36,10 +36,6 @@ LOG_MODULE_REGISTER(nrf_cloud_coap, CONFIG_NRF_CLOUD_COAP_LOG_LEVEL);
 #define COAP_SHDW_RSC "state"
 #define COAP_SHDW_REP_RSC "state/reported"
 #define COAP_SHDW_DES_RSC "state/desired"
-#define COAP_D2C_RSC "msg/d2c"
-#define COAP_D2C_BULK_RSC COAP_D2C_RSC "/bulk"
-#define COAP_D2C_RAW_RSC COAP_D2C_RSC "/raw"
-#define COAP_D2C_BIN_RSC COAP_D2C_RSC "/bin"
 
 #define MAX_COAP_PAYLOAD_SIZE (CONFIG_COAP_CLIENT_BLOCK_SIZE - \
 			       CONFIG_COAP_CLIENT_MESSAGE_HEADER_SIZE)
@@ -272,16 +268,20 @@ int nrf_cloud_coap_obj_send(struct nrf_cloud_obj *const obj, bool confirmable)
 		return -EINVAL;
 	}
 
-	/* Only support sending of the CoAP CBOR or JSON type or a pre-encoded CBOR buffer. */
+	/* Only support sending of the CoAP CBOR, JSON or stream type or a pre-encoded buffer. */
 	if ((obj->type != NRF_CLOUD_OBJ_TYPE_COAP_CBOR) &&
 	    (obj->type != NRF_CLOUD_OBJ_TYPE_JSON) &&
+	    (obj->type != NRF_CLOUD_OBJ_TYPE_STREAM) &&
 	    (obj->enc_src != NRF_CLOUD_ENC_SRC_PRE_ENCODED)) {
 		return -ENOTSUP;
 	}
 
 	bool bulk = nrf_cloud_obj_bulk_check(obj);
+	bool cbor = (obj->type == NRF_CLOUD_OBJ_TYPE_COAP_CBOR) ||
+		    ((obj->type == NRF_CLOUD_OBJ_TYPE_STREAM) && obj->stream &&
+		     (obj->stream->fmt == NRF_CLOUD_OBJ_STREAM_FMT_CBOR));
 
-	if (bulk && (obj->type == NRF_CLOUD_OBJ_TYPE_COAP_CBOR)) {
+	if (bulk && cbor) {
 		return -ENOTSUP;
 	}
 
@@ -304,8 +304,8 @@ int nrf_cloud_coap_obj_send(struct nrf_cloud_obj *const obj, bool confirmable)
 
 	err = nrf_cloud_coap_post(resource, NULL,
 				  obj->encoded_data.ptr, obj->encoded_data.len,
-				  (obj->type == NRF_CLOUD_OBJ_TYPE_COAP_CBOR) ?
-				   COAP_CONTENT_FORMAT_APP_CBOR : COAP_CONTENT_FORMAT_APP_JSON,
+				  cbor ? COAP_CONTENT_FORMAT_APP_CBOR
+				       : COAP_CONTENT_FORMAT_APP_JSON,
 				  confirmable, NULL, NULL);
 	if (err) {
 		LOG_ERR("Failed to send POST request: %d", err);
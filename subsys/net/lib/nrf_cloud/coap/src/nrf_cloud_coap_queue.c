@@ -0,0 +1,670 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/sys/util.h>
+#include <date_time.h>
+#include <net/nrf_cloud.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_coap.h>
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE_FLASH)
+#include <zephyr/devicetree.h>
+#include <zephyr/fs/fcb.h>
+#include <zephyr/storage/flash_map.h>
+#endif
+#include "nrf_cloud_coap_transport.h"
+#include "coap_codec.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(nrf_cloud_coap, CONFIG_NRF_CLOUD_COAP_LOG_LEVEL);
+
+/* Space in front of the queued messages for the opening bracket of the JSON array, or for
+ * the record header when the messages are stored in flash. It keeps the messages aligned
+ * for flash writes.
+ */
+#define QUEUE_HEAD_SIZE 4
+/* Largest flash write block size that records can be padded to */
+#define QUEUE_ALIGN_MAX 16
+/* Room for the closing bracket of the JSON array after the messages */
+#define QUEUE_TAIL_SIZE 1
+#define QUEUE_BUF_SIZE ROUND_UP(QUEUE_HEAD_SIZE + CONFIG_NRF_CLOUD_COAP_QUEUE_SIZE + \
+				QUEUE_TAIL_SIZE, QUEUE_ALIGN_MAX)
+
+/* The queued messages are kept as the comma-separated contents of a JSON array, so they
+ * are sent to the bulk resource without being copied.
+ */
+static uint8_t queue_buf[QUEUE_BUF_SIZE] __aligned(4);
+static size_t queue_len;
+static uint16_t queue_cnt;
+/* The first messages of the queue while they are being sent, which are followed by the
+ * closing bracket. Messages queued meanwhile are added after the bracket.
+ */
+static size_t sending_len;
+static uint16_t sending_cnt;
+static bool queue_ready;
+/* Protects the queue. It is never held during network I/O. */
+static K_MUTEX_DEFINE(queue_mut);
+/* Serializes flushes, and protects the flash queue */
+static K_MUTEX_DEFINE(flush_mut);
+
+static K_THREAD_STACK_DEFINE(queue_stack, CONFIG_NRF_CLOUD_COAP_QUEUE_STACK_SIZE);
+static struct k_work_q queue_work_q;
+
+static void flush_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_fn);
+
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE_FLASH)
+#define QUEUE_FLASH_MAGIC 0x6e637171
+#define QUEUE_FLASH_AREA FIXED_PARTITION_ID(nrf_cloud_queue)
+#define QUEUE_FLASH_SECTOR_SIZE DT_PROP(DT_CHOSEN(zephyr_flash), erase_block_size)
+/* The FCB sector header, and the length and CRC of a record, each padded to the
+ * write block size.
+ */
+#define QUEUE_FCB_OVERHEAD (3 * QUEUE_ALIGN_MAX)
+
+BUILD_ASSERT(QUEUE_BUF_SIZE <= FCB_MAX_LEN,
+	     "CONFIG_NRF_CLOUD_COAP_QUEUE_SIZE is too large for an FCB record");
+BUILD_ASSERT(QUEUE_BUF_SIZE + QUEUE_FCB_OVERHEAD <= QUEUE_FLASH_SECTOR_SIZE,
+	     "CONFIG_NRF_CLOUD_COAP_QUEUE_SIZE does not fit into a flash sector");
+
+/* Each flash record holds the contents of a full RAM queue, or, if cnt is 0, the position
+ * of the last record that was sent.
+ */
+struct queue_record_hdr {
+	uint16_t cnt;
+	uint16_t len;
+};
+
+struct queue_sent_marker {
+	uint32_t sector_off;
+	uint32_t elem_off;
+};
+
+BUILD_ASSERT(sizeof(struct queue_record_hdr) <= QUEUE_HEAD_SIZE);
+
+static struct fcb fcb;
+static struct flash_sector fcb_sectors[CONFIG_NRF_CLOUD_COAP_QUEUE_FLASH_NUM_SECTORS];
+/* The last record that was sent. Older records are erased along with their sectors. */
+static struct fcb_entry last_sent;
+/* Records are read into their own buffer, as messages can be queued while they are sent */
+static uint8_t flash_buf[QUEUE_BUF_SIZE] __aligned(4);
+#endif /* CONFIG_NRF_CLOUD_COAP_QUEUE_FLASH */
+
+static void flush_schedule(k_timeout_t delay)
+{
+	(void)k_work_schedule_for_queue(&queue_work_q, &flush_work, delay);
+}
+
+static void flush_reschedule(k_timeout_t delay)
+{
+	(void)k_work_reschedule_for_queue(&queue_work_q, &flush_work, delay);
+}
+
+/* The server rejects invalid messages with a 4.xx code. Keeping them would block the queue,
+ * so they are dropped like sent ones.
+ */
+static bool batch_done(int err)
+{
+	return (err == 0) || ((err > 0) && (err < COAP_RESPONSE_CODE_INTERNAL_ERROR));
+}
+
+/* Send cnt messages of total length len as a JSON array. The messages start at
+ * QUEUE_HEAD_SIZE in buf, and buf has room for the closing bracket after them.
+ */
+static int bulk_send(uint8_t *const buf, uint16_t cnt, size_t len, bool confirmable)
+{
+	int err;
+
+	buf[QUEUE_HEAD_SIZE - 1] = '[';
+	buf[QUEUE_HEAD_SIZE + len] = ']';
+
+	LOG_DBG("Sending %u queued messages, %zu bytes", cnt, len);
+
+	err = nrf_cloud_coap_post(COAP_D2C_BULK_RSC, NULL, &buf[QUEUE_HEAD_SIZE - 1], len + 2,
+				  COAP_CONTENT_FORMAT_APP_JSON, confirmable, NULL, NULL);
+	if (err < 0) {
+		LOG_ERR("Failed to send POST request: %d", err);
+	} else if (err > 0) {
+		LOG_RESULT_CODE_ERR("Error from server:", err);
+	}
+
+	return err;
+}
+
+/* Send the messages in RAM. Called with flush_mut held. */
+static int ram_flush(bool confirmable)
+{
+	int err;
+
+	k_mutex_lock(&queue_mut, K_FOREVER);
+
+	if (queue_cnt == 0) {
+		k_mutex_unlock(&queue_mut);
+		return 0;
+	}
+
+	sending_len = queue_len;
+	sending_cnt = queue_cnt;
+
+	/* Messages queued from now on are added after the closing bracket */
+	k_mutex_unlock(&queue_mut);
+
+	err = bulk_send(queue_buf, sending_cnt, sending_len, confirmable);
+
+	k_mutex_lock(&queue_mut, K_FOREVER);
+
+	if (batch_done(err)) {
+		size_t rest = queue_len - sending_len;
+
+		/* Move the messages that were queued during the request to the front */
+		if (rest) {
+			memmove(&queue_buf[QUEUE_HEAD_SIZE],
+				&queue_buf[QUEUE_HEAD_SIZE + sending_len + 1], rest - 1);
+			rest--;
+		}
+
+		queue_len = rest;
+		queue_cnt -= sending_cnt;
+	} else if (queue_len > sending_len) {
+		/* Join the messages again by replacing the closing bracket */
+		queue_buf[QUEUE_HEAD_SIZE + sending_len] = ',';
+	}
+
+	sending_len = 0;
+	sending_cnt = 0;
+
+	k_mutex_unlock(&queue_mut);
+
+	return err;
+}
+
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE_FLASH)
+static int marker_read(const struct fcb_entry *entry, struct queue_sent_marker *marker)
+{
+	uint8_t buf[QUEUE_HEAD_SIZE + sizeof(*marker)];
+	struct queue_record_hdr hdr;
+	int err;
+
+	if (entry->fe_data_len < sizeof(buf)) {
+		return -ENOMSG;
+	}
+
+	err = flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF(*entry), buf, sizeof(buf));
+	if (err) {
+		return err;
+	}
+
+	memcpy(&hdr, buf, sizeof(hdr));
+	if (hdr.cnt != 0) {
+		return -ENOMSG;
+	}
+
+	memcpy(marker, &buf[QUEUE_HEAD_SIZE], sizeof(*marker));
+
+	return 0;
+}
+
+/* Find the last sent record from the newest marker, so it is not sent again after a reset */
+static void last_sent_restore(void)
+{
+	struct queue_sent_marker marker;
+	struct queue_sent_marker newest = { 0 };
+	struct fcb_entry entry = { 0 };
+	bool found = false;
+
+	while (fcb_getnext(&fcb, &entry) == 0) {
+		if (marker_read(&entry, &marker) == 0) {
+			newest = marker;
+			found = true;
+		}
+	}
+
+	memset(&last_sent, 0, sizeof(last_sent));
+
+	if (!found) {
+		return;
+	}
+
+	/* If the record was erased, all the remaining ones are newer */
+	memset(&entry, 0, sizeof(entry));
+	while (fcb_getnext(&fcb, &entry) == 0) {
+		if ((entry.fe_sector->fs_off == newest.sector_off) &&
+		    (entry.fe_elem_off == newest.elem_off)) {
+			last_sent = entry;
+			break;
+		}
+	}
+}
+
+static int flash_init(void)
+{
+	uint32_t sector_cnt = ARRAY_SIZE(fcb_sectors);
+	int err;
+
+	err = flash_area_get_sectors(QUEUE_FLASH_AREA, &sector_cnt, fcb_sectors);
+	if (err) {
+		return err;
+	}
+
+	fcb.f_magic = QUEUE_FLASH_MAGIC;
+	fcb.f_sectors = fcb_sectors;
+	fcb.f_sector_cnt = (uint8_t)sector_cnt;
+
+	err = fcb_init(QUEUE_FLASH_AREA, &fcb);
+	if (err) {
+		return err;
+	}
+
+	if (fcb.f_align > QUEUE_ALIGN_MAX) {
+		LOG_ERR("Unsupported flash write block size: %u", fcb.f_align);
+		return -ENOTSUP;
+	}
+
+	if (!fcb_is_empty(&fcb)) {
+		LOG_INF("Found queued messages in flash");
+		last_sent_restore();
+	}
+
+	return 0;
+}
+
+static bool flash_empty(void)
+{
+	return fcb_is_empty(&fcb);
+}
+
+/* Erase the oldest sector, forgetting the last sent record if it was in it */
+static int flash_rotate(void)
+{
+	struct flash_sector *const erased = fcb.f_oldest;
+	int err;
+
+	err = fcb_rotate(&fcb);
+	if (!err && (last_sent.fe_sector == erased)) {
+		memset(&last_sent, 0, sizeof(last_sent));
+	}
+
+	return err;
+}
+
+static int flash_append(const uint8_t *const data, size_t len)
+{
+	struct fcb_entry entry;
+	int err;
+
+	err = fcb_append(&fcb, len, &entry);
+	if (err == -ENOSPC) {
+		LOG_WRN("Flash queue full, erasing the oldest messages");
+
+		err = flash_rotate();
+		if (!err) {
+			err = fcb_append(&fcb, len, &entry);
+		}
+	}
+
+	if (!err) {
+		err = flash_area_write(fcb.fap, FCB_ENTRY_FA_DATA_OFF(entry), data, len);
+	}
+
+	if (!err) {
+		err = fcb_append_finish(&fcb, &entry);
+	}
+
+	return err;
+}
+
+/* Move the RAM queue into a new flash record. Called with flush_mut and queue_mut held. */
+static int flash_spill(void)
+{
+	struct queue_record_hdr *const hdr = (struct queue_record_hdr *)queue_buf;
+	int err;
+
+	hdr->cnt = queue_cnt;
+	hdr->len = queue_len;
+
+	err = flash_append(queue_buf, ROUND_UP(QUEUE_HEAD_SIZE + queue_len, fcb.f_align));
+	if (err) {
+		LOG_ERR("Failed to store queued messages in flash: %d", err);
+		return err;
+	}
+
+	LOG_DBG("Stored %u queued messages in flash", queue_cnt);
+	queue_len = 0;
+	queue_cnt = 0;
+
+	return 0;
+}
+
+/* Record the position of the last sent record in flash */
+static int sent_mark(void)
+{
+	uint8_t buf[ROUND_UP(QUEUE_HEAD_SIZE + sizeof(struct queue_sent_marker),
+			     QUEUE_ALIGN_MAX)] __aligned(4) = { 0 };
+	struct queue_sent_marker marker = {
+		.sector_off = last_sent.fe_sector->fs_off,
+		.elem_off = last_sent.fe_elem_off,
+	};
+
+	memcpy(&buf[QUEUE_HEAD_SIZE], &marker, sizeof(marker));
+
+	return flash_append(buf, ROUND_UP(QUEUE_HEAD_SIZE + sizeof(marker), fcb.f_align));
+}
+
+/* Send the flash records oldest first. Called with flush_mut held. */
+static int flash_flush(bool confirmable)
+{
+	struct queue_record_hdr *const hdr = (struct queue_record_hdr *)flash_buf;
+	struct fcb_entry entry = last_sent;
+	int err;
+
+	if (flash_empty()) {
+		return 0;
+	}
+
+	while ((err = fcb_getnext(&fcb, &entry)) == 0) {
+		if (entry.fe_data_len > (sizeof(flash_buf) - QUEUE_TAIL_SIZE)) {
+			LOG_WRN("Skipping invalid flash record");
+			last_sent = entry;
+			continue;
+		}
+
+		err = flash_area_read(fcb.fap, FCB_ENTRY_FA_DATA_OFF(entry), flash_buf,
+				      entry.fe_data_len);
+		if (err) {
+			break;
+		}
+
+		if (hdr->cnt == 0) {
+			/* Sent marker */
+			continue;
+		}
+
+		if (hdr->len <= (entry.fe_data_len - QUEUE_HEAD_SIZE)) {
+			err = bulk_send(flash_buf, hdr->cnt, hdr->len, confirmable);
+			if (!batch_done(err)) {
+				break;
+			}
+		} else {
+			LOG_WRN("Skipping invalid flash record");
+		}
+
+		last_sent = entry;
+		err = 0;
+
+		while (!err && (fcb.f_oldest != last_sent.fe_sector)) {
+			err = flash_rotate();
+		}
+
+		/* Without the marker, the rest of the oldest sector is sent again after a reset */
+		if (!err) {
+			err = sent_mark();
+		}
+
+		if (err) {
+			break;
+		}
+
+		/* The marker can rotate out the sector of the sent record */
+		entry = last_sent;
+	}
+
+	if (err == -ENOTSUP) {
+		/* All records were sent */
+		memset(&last_sent, 0, sizeof(last_sent));
+		err = fcb_clear(&fcb);
+	}
+
+	return err;
+}
+#else
+static bool flash_empty(void)
+{
+	return true;
+}
+#endif /* CONFIG_NRF_CLOUD_COAP_QUEUE_FLASH */
+
+/* Called with queue_mut held */
+static int queue_init(void)
+{
+	static const struct k_work_queue_config queue_config = {
+		.name = "nrf_cloud_coap_queue",
+	};
+
+	if (queue_ready) {
+		return 0;
+	}
+
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE_FLASH)
+	/* Nothing is flushed before the queue is ready, so flush_mut is not needed */
+	int err = flash_init();
+
+	if (err) {
+		LOG_ERR("Failed to initialize flash queue: %d", err);
+		return err;
+	}
+#endif
+
+	/* Flushes block on CoAP requests, so they run on their own work queue */
+	k_work_queue_start(&queue_work_q, queue_stack, K_THREAD_STACK_SIZEOF(queue_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, &queue_config);
+
+	if (!flash_empty() && (CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_INTERVAL > 0)) {
+		flush_schedule(K_SECONDS(CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_INTERVAL));
+	}
+
+	queue_ready = true;
+
+	return 0;
+}
+
+/* Messages are separated by a comma, or follow the closing bracket of the messages
+ * being sent. Called with queue_mut held.
+ */
+static bool queue_fits(size_t len)
+{
+	size_t sep = (queue_len > 0) ? 1 : 0;
+
+	return (queue_len + sep + len) <= CONFIG_NRF_CLOUD_COAP_QUEUE_SIZE;
+}
+
+/* Called with queue_mut held */
+static void queue_append(const uint8_t *msg, size_t len)
+{
+	if (queue_len > 0) {
+		if (!(sending_cnt && (queue_len == sending_len))) {
+			queue_buf[QUEUE_HEAD_SIZE + queue_len] = ',';
+		}
+		queue_len++;
+	}
+
+	memcpy(&queue_buf[QUEUE_HEAD_SIZE + queue_len], msg, len);
+	queue_len += len;
+	queue_cnt++;
+
+	if ((CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_SIZE > 0) &&
+	    (queue_len >= CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_SIZE)) {
+		flush_reschedule(K_NO_WAIT);
+	} else if (CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_INTERVAL > 0) {
+		/* Does nothing if a flush is already scheduled for older messages */
+		flush_schedule(K_SECONDS(CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_INTERVAL));
+	}
+}
+
+/* Make room by sending the queue, or by moving it to flash, and then add the message */
+static int queue_add_full(const uint8_t *msg, size_t len)
+{
+	int err = 0;
+
+	k_mutex_lock(&flush_mut, K_FOREVER);
+
+	if (nrf_cloud_coap_is_connected()) {
+		(void)ram_flush(true);
+	}
+
+	k_mutex_lock(&queue_mut, K_FOREVER);
+
+	/* No messages are being sent while flush_mut is held */
+	if (!queue_fits(len)) {
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE_FLASH)
+		err = flash_spill();
+#else
+		LOG_WRN("Message queue full");
+		err = -ENOBUFS;
+#endif
+	}
+
+	if (!err) {
+		queue_append(msg, len);
+	}
+
+	k_mutex_unlock(&queue_mut);
+	k_mutex_unlock(&flush_mut);
+
+	return err;
+}
+
+static int queue_add(const uint8_t *msg, size_t len)
+{
+	int err;
+
+	if (len > CONFIG_NRF_CLOUD_COAP_QUEUE_SIZE) {
+		return -E2BIG;
+	}
+
+	k_mutex_lock(&queue_mut, K_FOREVER);
+
+	err = queue_init();
+	if (err) {
+		k_mutex_unlock(&queue_mut);
+		return err;
+	}
+
+	if (queue_fits(len)) {
+		queue_append(msg, len);
+		k_mutex_unlock(&queue_mut);
+		return 0;
+	}
+
+	k_mutex_unlock(&queue_mut);
+
+	return queue_add_full(msg, len);
+}
+
+/* Queued messages use the JSON device message format of the bulk resource */
+static int queue_msg_add(const char *app_id, double value, const char *str_val, int64_t ts_ms)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(msg_obj);
+	int err;
+
+	/* Queued messages are received later, so they always need a timestamp */
+	if (ts_ms == NRF_CLOUD_NO_TIMESTAMP) {
+		err = date_time_now(&ts_ms);
+		if (err) {
+			LOG_ERR("Error getting time: %d", err);
+			return err;
+		}
+	}
+
+	err = nrf_cloud_obj_msg_init(&msg_obj, app_id, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	if (!err) {
+		err = str_val ? nrf_cloud_obj_str_add(&msg_obj, NRF_CLOUD_JSON_DATA_KEY, str_val,
+						      false)
+			      : nrf_cloud_obj_num_add(&msg_obj, NRF_CLOUD_JSON_DATA_KEY, value,
+						      false);
+	}
+	if (!err) {
+		err = nrf_cloud_obj_ts_add(&msg_obj, ts_ms);
+	}
+	if (!err) {
+		err = nrf_cloud_obj_cloud_encode(&msg_obj);
+	}
+
+	if (err) {
+		LOG_ERR("Unable to encode message: %d", err);
+	} else {
+		err = queue_add(msg_obj.encoded_data.ptr, msg_obj.encoded_data.len);
+		(void)nrf_cloud_obj_cloud_encoded_free(&msg_obj);
+	}
+
+	(void)nrf_cloud_obj_free(&msg_obj);
+
+	return err;
+}
+
+int nrf_cloud_coap_sensor_queue(const char *app_id, double value, int64_t ts_ms)
+{
+	__ASSERT_NO_MSG(app_id != NULL);
+
+	return queue_msg_add(app_id, value, NULL, ts_ms);
+}
+
+int nrf_cloud_coap_message_queue(const char *app_id, const char *message, int64_t ts_ms)
+{
+	__ASSERT_NO_MSG(app_id != NULL);
+	__ASSERT_NO_MSG(message != NULL);
+
+	return queue_msg_add(app_id, 0, message, ts_ms);
+}
+
+int nrf_cloud_coap_queue_flush(bool confirmable)
+{
+	bool empty;
+	int err;
+
+	if (!nrf_cloud_coap_is_connected()) {
+		return -EACCES;
+	}
+
+	k_mutex_lock(&queue_mut, K_FOREVER);
+	err = queue_init();
+	k_mutex_unlock(&queue_mut);
+
+	if (err) {
+		return err;
+	}
+
+	k_mutex_lock(&flush_mut, K_FOREVER);
+
+	err = ram_flush(confirmable);
+
+#if defined(CONFIG_NRF_CLOUD_COAP_QUEUE_FLASH)
+	if (!err) {
+		err = flash_flush(confirmable);
+	}
+#endif
+
+	k_mutex_lock(&queue_mut, K_FOREVER);
+
+	empty = (queue_cnt == 0) && flash_empty();
+	if (empty) {
+		(void)k_work_cancel_delayable(&flush_work);
+	} else if (CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_INTERVAL > 0) {
+		/* Retry the remaining messages later */
+		flush_schedule(K_SECONDS(CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_INTERVAL));
+	}
+
+	k_mutex_unlock(&queue_mut);
+	k_mutex_unlock(&flush_mut);
+
+	return err;
+}
+
+static void flush_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	int err = nrf_cloud_coap_queue_flush(true);
+
+	if ((err == -EACCES) && (CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_INTERVAL > 0)) {
+		LOG_DBG("Not connected, flushing the queue later");
+		flush_schedule(K_SECONDS(CONFIG_NRF_CLOUD_COAP_QUEUE_FLUSH_INTERVAL));
+	} else if (err) {
+		LOG_ERR("Failed to flush the message queue: %d", err);
+	}
+}
@@ -60,16 +60,22 @@ struct cc_xfer_data {
 	coap_client_response_cb_t cb;
 	void *user_data;
 	int result_code;
-	struct k_sem *sem;
+	/* Given when the transfer is complete */
+	struct k_sem sem;
 	atomic_t used;
 };
 
-/* Semaphore to be used with internal coap_client requests */
-static K_SEM_DEFINE(cb_sem, 0, 1);
-/* Semaphore to be used when doing authorization with an external coap_client */
-static K_SEM_DEFINE(ext_cc_sem, 0, 1);
-/* Mutex to be used when using the internal coap_client */
+/* Mutex to be used when changing the state of the internal coap_client */
 static K_MUTEX_DEFINE(internal_transfer_mut);
+/* Requests on the internal coap_client run concurrently, up to the size of this window.
+ * Operations that change the client's state take the whole window, so they do not
+ * overlap with requests.
+ */
+static K_SEM_DEFINE(transfer_window_sem, CONFIG_NRF_CLOUD_COAP_MAX_CONCURRENT_REQUESTS,
+		    CONFIG_NRF_CLOUD_COAP_MAX_CONCURRENT_REQUESTS);
+/* Thread holding the whole window, and how many times it has locked it */
+static k_tid_t state_owner;
+static int state_lock_cnt;
 
 static struct nrf_cloud_coap_client internal_cc = {0};
 
@@ -144,8 +150,7 @@ static void xfer_ctx_release(struct cc_xfer_data *ctx)
 
 static struct cc_xfer_data *xfer_data_init(struct nrf_cloud_coap_client *cc,
 					   coap_client_response_cb_t cb,
-					   void *user,
-					   struct k_sem *sem)
+					   void *user)
 {
 	struct cc_xfer_data *xfer = xfer_ctx_take();
 
@@ -157,10 +162,42 @@ static struct cc_xfer_data *xfer_data_init(struct nrf_cloud_coap_client *cc,
 	xfer->cb = cb;
 	xfer->user_data = user;
 	xfer->result_code = -ECANCELED;
-	xfer->sem = sem;
+	k_sem_init(&xfer->sem, 0, 1);
 	return xfer;
 }
 
+static bool state_owned(void)
+{
+	return state_owner == k_current_get();
+}
+
+/* Lock the state of the internal client, waiting for ongoing requests to complete */
+static void state_lock(void)
+{
+	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
+
+	if (state_lock_cnt++ == 0) {
+		for (int i = 0; i < CONFIG_NRF_CLOUD_COAP_MAX_CONCURRENT_REQUESTS; i++) {
+			(void)k_sem_take(&transfer_window_sem, K_FOREVER);
+		}
+
+		state_owner = k_current_get();
+	}
+}
+
+static void state_unlock(void)
+{
+	if (--state_lock_cnt == 0) {
+		state_owner = NULL;
+
+		for (int i = 0; i < CONFIG_NRF_CLOUD_COAP_MAX_CONCURRENT_REQUESTS; i++) {
+			k_sem_give(&transfer_window_sem);
+		}
+	}
+
+	k_mutex_unlock(&internal_transfer_mut);
+}
+
 bool nrf_cloud_coap_is_connected(void)
 {
 	return internal_cc.authenticated && !internal_cc.paused;
@@ -192,7 +229,7 @@ int nrf_cloud_coap_init(void)
 	int err = 0;
 
 	(void)nrf_cloud_print_details();
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
+	state_lock();
 
 	internal_cc.authenticated = false;
 
@@ -217,7 +254,7 @@ int nrf_cloud_coap_init(void)
 	}
 
 exit:
-	k_mutex_unlock(&internal_transfer_mut);
+	state_unlock();
 	return err;
 }
 
@@ -318,7 +355,7 @@ int nrf_cloud_coap_connect(const char * const app_ver)
 		return -EACCES;
 	}
 
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
+	state_lock();
 
 	err = nrf_cloud_coap_transport_connect(&internal_cc);
 	if (err < 0) {
@@ -343,7 +380,7 @@ int nrf_cloud_coap_connect(const char * const app_ver)
 	nrf_cloud_coap_transport_disconnect(&internal_cc);
 
 exit:
-	k_mutex_unlock(&internal_transfer_mut);
+	state_unlock();
 	return err;
 }
 
@@ -351,9 +388,9 @@ int nrf_cloud_coap_pause(void)
 {
 	int err = 0;
 
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
+	state_lock();
 	err = nrf_cloud_coap_transport_pause(&internal_cc);
-	k_mutex_unlock(&internal_transfer_mut);
+	state_unlock();
 
 	return err;
 }
@@ -362,9 +399,9 @@ int nrf_cloud_coap_resume(void)
 {
 	int err = 0;
 
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
+	state_lock();
 	err = nrf_cloud_coap_transport_resume(&internal_cc);
-	k_mutex_unlock(&internal_transfer_mut);
+	state_unlock();
 
 	return err;
 }
@@ -403,9 +440,7 @@ static void client_callback(int16_t result_code, size_t offset, const uint8_t *p
 	}
 	if (last_block || (result_code >= COAP_RESPONSE_CODE_BAD_REQUEST)) {
 		LOG_DBG("End of client transfer");
-		if (xfer->sem) {
-			k_sem_give(xfer->sem);
-		}
+		k_sem_give(&xfer->sem);
 	}
 }
 
@@ -471,7 +506,6 @@ static int client_transfer(enum coap_method method,
 #endif /* CONFIG_NRF_CLOUD_COAP_LOG_LEVEL_DBG */
 
 	retry = 0;
-	k_sem_reset(xfer->sem);
 	while ((xfer->nrfc_cc->sock >= 0) &&
 	       (err = coap_client_req(cc, xfer->nrfc_cc->sock, NULL, &request, NULL)) == -EAGAIN) {
 		if (!nrf_cloud_coap_is_connected()) {
@@ -506,7 +540,7 @@ static int client_transfer(enum coap_method method,
 		/* Wait for coap_client to exhaust retries when reliable transfer selected,
 		 * otherwise wait a finite time because response might never come.
 		 */
-		err = k_sem_take(xfer->sem, reliable ? K_FOREVER : K_SECONDS(NON_RESP_WAIT_S));
+		err = k_sem_take(&xfer->sem, reliable ? K_FOREVER : K_SECONDS(NON_RESP_WAIT_S));
 		if (!err) {
 			LOG_DBG("Got callback");
 		} else {
@@ -524,11 +558,50 @@ static int client_transfer(enum coap_method method,
 	}
 
 transfer_end:
-	xfer_ctx_release(xfer);
+	/* Cancel before releasing the context, so a concurrent request that takes the
+	 * context does not have its request cancelled.
+	 */
 	coap_client_cancel_request(cc, &request);
+	xfer_ctx_release(xfer);
+	return err;
+}
+
+static void transfer_failed(int err)
+{
 	if (err == -ETIMEDOUT && IS_ENABLED(CONFIG_NRF_CLOUD_COAP_DISCONNECT_ON_FAILED_REQUEST)) {
 		nrf_cloud_coap_disconnect();
 	}
+}
+
+static int internal_transfer(enum coap_method method,
+			     const char *resource, const char *query,
+			     const uint8_t *buf, size_t buf_len,
+			     enum coap_content_format fmt_out,
+			     enum coap_content_format fmt_in,
+			     bool response_expected,
+			     bool reliable,
+			     coap_client_response_cb_t cb, void *user)
+{
+	/* Requests made while the state is locked, such as the shadow updates made while
+	 * connecting, already own the whole window.
+	 */
+	bool windowed = !state_owned();
+	int err;
+
+	if (windowed) {
+		(void)k_sem_take(&transfer_window_sem, K_FOREVER);
+	}
+
+	err = client_transfer(method, resource, query, buf, buf_len, fmt_out, fmt_in,
+			      response_expected, reliable,
+			      xfer_data_init(&internal_cc, cb, user));
+
+	if (windowed) {
+		k_sem_give(&transfer_window_sem);
+	}
+
+	transfer_failed(err);
+
 	return err;
 }
 
@@ -538,16 +611,8 @@ int nrf_cloud_coap_get(const char *resource, const char *query,
 		       enum coap_content_format fmt_in, bool reliable,
 		       coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_GET, resource, query,
-			      buf, len, fmt_out, fmt_in, true, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return internal_transfer(COAP_METHOD_GET, resource, query,
+				 buf, len, fmt_out, fmt_in, true, reliable, cb, user);
 }
 
 int nrf_cloud_coap_post(const char *resource, const char *query,
@@ -555,16 +620,8 @@ int nrf_cloud_coap_post(const char *resource, const char *query,
 			enum coap_content_format fmt, bool reliable,
 			coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_POST, resource, query,
-			      buf, len, fmt, fmt, false, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return internal_transfer(COAP_METHOD_POST, resource, query,
+				 buf, len, fmt, fmt, false, reliable, cb, user);
 }
 
 int nrf_cloud_coap_put(const char *resource, const char *query,
@@ -572,16 +629,8 @@ int nrf_cloud_coap_put(const char *resource, const char *query,
 		       enum coap_content_format fmt, bool reliable,
 		       coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_PUT, resource, query,
-			      buf, len, fmt, fmt, false, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return internal_transfer(COAP_METHOD_PUT, resource, query,
+				 buf, len, fmt, fmt, false, reliable, cb, user);
 }
 
 int nrf_cloud_coap_delete(const char *resource, const char *query,
@@ -589,16 +638,8 @@ int nrf_cloud_coap_delete(const char *resource, const char *query,
 			  enum coap_content_format fmt, bool reliable,
 			  coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_DELETE, resource, query,
-			      buf, len, fmt, fmt, false, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return internal_transfer(COAP_METHOD_DELETE, resource, query,
+				 buf, len, fmt, fmt, false, reliable, cb, user);
 }
 
 int nrf_cloud_coap_fetch(const char *resource, const char *query,
@@ -607,16 +648,8 @@ int nrf_cloud_coap_fetch(const char *resource, const char *query,
 			 enum coap_content_format fmt_in, bool reliable,
 			 coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_FETCH, resource, query,
-			      buf, len, fmt_out, fmt_in, true, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return internal_transfer(COAP_METHOD_FETCH, resource, query,
+				 buf, len, fmt_out, fmt_in, true, reliable, cb, user);
 }
 
 int nrf_cloud_coap_patch(const char *resource, const char *query,
@@ -624,16 +657,8 @@ int nrf_cloud_coap_patch(const char *resource, const char *query,
 			 enum coap_content_format fmt, bool reliable,
 			 coap_client_response_cb_t cb, void *user)
 {
-	int err = 0;
-
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
-	void *xfer = xfer_data_init(&internal_cc, cb, user, &cb_sem);
-
-	err = client_transfer(COAP_METHOD_PATCH, resource, query,
-			      buf, len, fmt, fmt, false, reliable, xfer);
-	k_mutex_unlock(&internal_transfer_mut);
-
-	return err;
+	return internal_transfer(COAP_METHOD_PATCH, resource, query,
+				 buf, len, fmt, fmt, false, reliable, cb, user);
 }
 
 static void auth_cb(int16_t result_code, size_t offset, const uint8_t *payload, size_t len,
@@ -652,22 +677,25 @@ static int nrf_cloud_coap_auth_post(struct nrf_cloud_coap_client *const client,
 			     const uint8_t *jwt, size_t jwt_len)
 {
 	/* Use the nrf_cloud_coap_client as the user data so the auth flag can be set */
-	void *xfer = xfer_data_init(client, auth_cb, client,
-				    is_internal(client) ? &cb_sem : &ext_cc_sem);
+	void *xfer = xfer_data_init(client, auth_cb, client);
+	int err;
+
+	err = client_transfer(COAP_METHOD_POST, NRF_CLOUD_COAP_AUTH_RSC,
+			      ver_string, jwt, jwt_len,
+			      COAP_CONTENT_FORMAT_TEXT_PLAIN, COAP_CONTENT_FORMAT_TEXT_PLAIN,
+			      false, true, xfer);
+	transfer_failed(err);
 
-	return client_transfer(COAP_METHOD_POST, NRF_CLOUD_COAP_AUTH_RSC,
-			       ver_string, jwt, jwt_len,
-			       COAP_CONTENT_FORMAT_TEXT_PLAIN, COAP_CONTENT_FORMAT_TEXT_PLAIN,
-			       false, true, xfer);
+	return err;
 }
 
 int nrf_cloud_coap_disconnect(void)
 {
 	int err = 0;
 
-	k_mutex_lock(&internal_transfer_mut, K_FOREVER);
+	state_lock();
 	err = nrf_cloud_coap_transport_disconnect(&internal_cc);
-	k_mutex_unlock(&internal_transfer_mut);
+	state_unlock();
 
 	return err;
 }
@@ -38,6 +38,28 @@ void *nrf_cloud_malloc(size_t size);
  */
 void nrf_cloud_free(void *memory);
 
+#if defined(CONFIG_NRF_CLOUD_MEM_ARENA)
+/** @brief Allocate memory for cJSON from the message arena.
+ *
+ * Used as the cJSON malloc hook, so only the nodes and strings of messages being
+ * encoded or decoded come from the arena. The arena is rewound once all of them
+ * are freed. Other allocations of the library use the heap.
+ *
+ * @param[in] size Size of memory requested.
+ *
+ * @retval A valid pointer on SUCCESS, else, NULL.
+ */
+void *nrf_cloud_arena_malloc(size_t size);
+
+/** @brief Free memory allocated by nrf_cloud_arena_malloc().
+ *
+ * Used as the cJSON free hook. nrf_cloud_free() also accepts memory from the arena.
+ *
+ * @param[in] memory Memory to be freed.
+ */
+void nrf_cloud_arena_free(void *memory);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_CLOUD_OBJ_STREAM_H_
+#define NRF_CLOUD_OBJ_STREAM_H_
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <net/nrf_cloud_codec.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Encoder of NRF_CLOUD_OBJ_TYPE_STREAM objects.
+ *
+ * All functions leave the stream unchanged if they fail, so a message that does not
+ * fit into the buffer can still be completed without the failed value.
+ *
+ * CBOR streams are encoded as the message_out type of nrf_cloud_coap_device_msg.cddl,
+ * so they only accept its members and fail with -ENOTSUP otherwise.
+ */
+
+#if defined(CONFIG_NRF_CLOUD_OBJ_STREAM)
+
+/** @brief Start an empty object, or an array if bulk is true. */
+int nrf_cloud_obj_stream_init(struct nrf_cloud_obj_stream *const stream, const bool bulk);
+
+/** @brief Start an object containing the app ID and, if not NULL, the message type. */
+int nrf_cloud_obj_stream_msg_init(struct nrf_cloud_obj_stream *const stream,
+				  const char *const app_id, const char *const msg_type);
+
+/** @brief Discard the encoded data, keeping the buffer and format. */
+void nrf_cloud_obj_stream_reset(struct nrf_cloud_obj_stream *const stream);
+
+/** @brief Check if the stream was started as a bulk array. */
+bool nrf_cloud_obj_stream_bulk_check(const struct nrf_cloud_obj_stream *const stream);
+
+/** @brief Complete the stream and append it to a bulk stream, then reset it. */
+int nrf_cloud_obj_stream_bulk_add(struct nrf_cloud_obj_stream *const bulk,
+				  struct nrf_cloud_obj_stream *const stream);
+
+int nrf_cloud_obj_stream_num_add(struct nrf_cloud_obj_stream *const stream,
+				 const char *const key, const double val, const bool data_child);
+
+int nrf_cloud_obj_stream_str_add(struct nrf_cloud_obj_stream *const stream,
+				 const char *const key, const char *const val,
+				 const bool data_child);
+
+int nrf_cloud_obj_stream_bool_add(struct nrf_cloud_obj_stream *const stream,
+				  const char *const key, const bool val, const bool data_child);
+
+int nrf_cloud_obj_stream_null_add(struct nrf_cloud_obj_stream *const stream,
+				  const char *const key, const bool data_child);
+
+int nrf_cloud_obj_stream_int_array_add(struct nrf_cloud_obj_stream *const stream,
+				       const char *const key, const uint32_t ints[],
+				       const uint32_t ints_cnt, const bool data_child);
+
+int nrf_cloud_obj_stream_str_array_add(struct nrf_cloud_obj_stream *const stream,
+				       const char *const key, const char *const strs[],
+				       const uint32_t strs_cnt, const bool data_child);
+
+/** @brief Add the PVT members to the "data" child, all of them or none. */
+int nrf_cloud_obj_stream_pvt_add(struct nrf_cloud_obj_stream *const stream,
+				 const struct nrf_cloud_gnss_pvt *const pvt);
+
+/** @brief Close all open containers and point the output to the encoded data.
+ *
+ * JSON output is null-terminated; the terminator is not included in the length.
+ */
+int nrf_cloud_obj_stream_encode(struct nrf_cloud_obj_stream *const stream,
+				struct nrf_cloud_data *const output);
+
+#else /* CONFIG_NRF_CLOUD_OBJ_STREAM */
+
+static inline int nrf_cloud_obj_stream_init(struct nrf_cloud_obj_stream *const stream,
+					    const bool bulk)
+{
+	return -ENOTSUP;
+}
+
+static inline int nrf_cloud_obj_stream_msg_init(struct nrf_cloud_obj_stream *const stream,
+						const char *const app_id,
+						const char *const msg_type)
+{
+	return -ENOTSUP;
+}
+
+static inline void nrf_cloud_obj_stream_reset(struct nrf_cloud_obj_stream *const stream)
+{
+}
+
+static inline bool nrf_cloud_obj_stream_bulk_check(
+	const struct nrf_cloud_obj_stream *const stream)
+{
+	return false;
+}
+
+static inline int nrf_cloud_obj_stream_bulk_add(struct nrf_cloud_obj_stream *const bulk,
+						struct nrf_cloud_obj_stream *const stream)
+{
+	return -ENOTSUP;
+}
+
+static inline int nrf_cloud_obj_stream_num_add(struct nrf_cloud_obj_stream *const stream,
+					       const char *const key, const double val,
+					       const bool data_child)
+{
+	return -ENOTSUP;
+}
+
+static inline int nrf_cloud_obj_stream_str_add(struct nrf_cloud_obj_stream *const stream,
+					       const char *const key, const char *const val,
+					       const bool data_child)
+{
+	return -ENOTSUP;
+}
+
+static inline int nrf_cloud_obj_stream_bool_add(struct nrf_cloud_obj_stream *const stream,
+						const char *const key, const bool val,
+						const bool data_child)
+{
+	return -ENOTSUP;
+}
+
+static inline int nrf_cloud_obj_stream_null_add(struct nrf_cloud_obj_stream *const stream,
+						const char *const key, const bool data_child)
+{
+	return -ENOTSUP;
+}
+
+static inline int nrf_cloud_obj_stream_int_array_add(struct nrf_cloud_obj_stream *const stream,
+						     const char *const key,
+						     const uint32_t ints[],
+						     const uint32_t ints_cnt,
+						     const bool data_child)
+{
+	return -ENOTSUP;
+}
+
+static inline int nrf_cloud_obj_stream_str_array_add(struct nrf_cloud_obj_stream *const stream,
+						     const char *const key,
+						     const char *const strs[],
+						     const uint32_t strs_cnt,
+						     const bool data_child)
+{
+	return -ENOTSUP;
+}
+
+static inline int nrf_cloud_obj_stream_pvt_add(struct nrf_cloud_obj_stream *const stream,
+					       const struct nrf_cloud_gnss_pvt *const pvt)
+{
+	return -ENOTSUP;
+}
+
+static inline int nrf_cloud_obj_stream_encode(struct nrf_cloud_obj_stream *const stream,
+					      struct nrf_cloud_data *const output)
+{
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_NRF_CLOUD_OBJ_STREAM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_CLOUD_OBJ_STREAM_H_ */
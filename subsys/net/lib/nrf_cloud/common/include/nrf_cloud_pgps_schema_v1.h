@@ -46,6 +46,18 @@ struct nrf_cloud_pgps_header {
 	 */
 } __packed;
 
+/* Start of each prediction in the download, up to the first ephemeris.
+ * The schema version and sentinel of struct nrf_cloud_pgps_prediction
+ * are not part of the download.
+ */
+struct pgps_prediction_dl_head {
+	uint8_t time_type;
+	uint16_t time_count;
+	struct nrf_cloud_pgps_system_time time;
+	uint8_t ephemeris_type;
+	uint16_t ephemeris_count;
+} __packed;
+
 struct agnss_header {
 	uint8_t type;
 	uint16_t count;
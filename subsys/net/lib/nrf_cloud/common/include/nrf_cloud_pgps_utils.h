@@ -38,6 +38,19 @@ struct gps_location {
 	int64_t gps_sec;
 };
 
+/* Location and CRC of each prediction in a stored set, so the set can be restored
+ * after a reset without reading every prediction.
+ */
+#define INDEX_NO_BLOCK 0xFFU
+
+struct npgps_index_record {
+	/* GPS time of the first prediction, identifying the set */
+	int64_t start_sec;
+	uint16_t count;
+	uint8_t block[NUM_PREDICTIONS];
+	uint32_t crc[NUM_PREDICTIONS];
+};
+
 struct nrf_cloud_pgps_header;
 
 typedef int (*npgps_buffer_handler_t)(uint8_t *buf, size_t len);
@@ -51,6 +64,9 @@ void npgps_download_unlock(void);
 /* settings functions */
 int npgps_save_header(struct nrf_cloud_pgps_header *header);
 const struct nrf_cloud_pgps_header *npgps_get_saved_header(void);
+int npgps_save_index(const struct npgps_index_record *record);
+int npgps_clear_index(void);
+const struct npgps_index_record *npgps_get_saved_index(void);
 const struct gps_location *npgps_get_saved_location(void);
 int npgps_settings_init(void);
 
@@ -8,6 +8,7 @@
 #include <net/nrf_cloud_codec.h>
 #include "nrf_cloud_mem.h"
 #include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_obj_stream.h"
 #if defined(CONFIG_NRF_CLOUD_COAP)
 #include <zephyr/net/coap.h>
 #include "coap_codec.h"
@@ -244,6 +245,13 @@ int nrf_cloud_obj_msg_init(struct nrf_cloud_obj *const obj, const char *const ap
 
 		return 0;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_msg_init(obj->stream, app_id, msg_type);
+	}
 	default:
 		break;
 	}
@@ -266,6 +274,13 @@ int nrf_cloud_obj_init(struct nrf_cloud_obj *const obj)
 		obj->json = cJSON_CreateObject();
 		return obj->json ? 0 : -ENOMEM;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_init(obj->stream, false);
+	}
 	default:
 		break;
 	}
@@ -284,6 +299,12 @@ int nrf_cloud_obj_reset(struct nrf_cloud_obj *const obj)
 		obj->json = NULL;
 		break;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (obj->stream) {
+			nrf_cloud_obj_stream_reset(obj->stream);
+		}
+		break;
+	}
 	default:
 		return -ENOTSUP;
 	}
@@ -311,6 +332,13 @@ int nrf_cloud_obj_bulk_init(struct nrf_cloud_obj *const bulk)
 		bulk->json = cJSON_CreateArray();
 		return bulk->json ? 0 : -ENOMEM;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!bulk->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_init(bulk->stream, true);
+	}
 	default:
 		break;
 	}
@@ -349,6 +377,13 @@ int nrf_cloud_obj_cloud_encoded_free(struct nrf_cloud_obj *const obj)
 		obj->enc_src = NRF_CLOUD_ENC_SRC_NONE;
 		return 0;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		/* The encoded data is the stream's buffer, which belongs to the caller */
+		obj->encoded_data.ptr = NULL;
+		obj->encoded_data.len = 0;
+		obj->enc_src = NRF_CLOUD_ENC_SRC_NONE;
+		return 0;
+	}
 	default:
 		break;
 	}
@@ -392,6 +427,12 @@ int nrf_cloud_obj_free(struct nrf_cloud_obj *const obj)
 		}
 		return 0;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (obj->stream) {
+			nrf_cloud_obj_stream_reset(obj->stream);
+		}
+		return 0;
+	}
 	default:
 		break;
 	}
@@ -401,6 +442,10 @@ int nrf_cloud_obj_free(struct nrf_cloud_obj *const obj)
 
 bool nrf_cloud_obj_bulk_check(struct nrf_cloud_obj *const obj)
 {
+	if (obj && (obj->type == NRF_CLOUD_OBJ_TYPE_STREAM)) {
+		return obj->stream && nrf_cloud_obj_stream_bulk_check(obj->stream);
+	}
+
 	return (obj && (obj->type == NRF_CLOUD_OBJ_TYPE_JSON) && cJSON_IsArray(obj->json));
 }
 
@@ -422,6 +467,17 @@ int nrf_cloud_obj_bulk_add(struct nrf_cloud_obj *const bulk, struct nrf_cloud_ob
 
 		return cJSON_AddItemToArray(bulk->json, obj->json) ? 0 : -EIO;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (bulk->type != NRF_CLOUD_OBJ_TYPE_STREAM) {
+			return -ENODEV;
+		}
+
+		if (!bulk->stream || !obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_bulk_add(bulk->stream, obj->stream);
+	}
 	default:
 		break;
 	}
@@ -454,6 +510,14 @@ int nrf_cloud_obj_ts_add(struct nrf_cloud_obj *const obj, const int64_t time_ms)
 		obj->coap_cbor->ts = time_ms;
 		return 0;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_num_add(obj->stream, NRF_CLOUD_MSG_TIMESTAMP_KEY,
+						    time_ms, false);
+	}
 	default:
 		break;
 	}
@@ -513,6 +577,13 @@ int nrf_cloud_obj_num_add(struct nrf_cloud_obj *const obj, const char *const key
 
 		return 0;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_num_add(obj->stream, key, val, data_child);
+	}
 	default:
 		break;
 	}
@@ -562,6 +633,17 @@ int nrf_cloud_obj_str_add(struct nrf_cloud_obj *const obj, const char *const key
 
 		return 0;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!key) {
+			return -EINVAL;
+		}
+
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_str_add(obj->stream, key, val, data_child);
+	}
 	default:
 		break;
 	}
@@ -584,6 +666,13 @@ int nrf_cloud_obj_bool_add(struct nrf_cloud_obj *const obj, const char *const ke
 		return cJSON_AddBoolToObjectCS(dest_json_get(obj, data_child), key, val) ? 0
 											 : -ENOMEM;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_bool_add(obj->stream, key, val, data_child);
+	}
 	default:
 		break;
 	}
@@ -605,6 +694,13 @@ int nrf_cloud_obj_null_add(struct nrf_cloud_obj *const obj, const char *const ke
 		}
 		return cJSON_AddNullToObjectCS(dest_json_get(obj, data_child), key) ? 0 : -ENOMEM;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_null_add(obj->stream, key, data_child);
+	}
 	default:
 		break;
 	}
@@ -656,6 +752,14 @@ int nrf_cloud_obj_int_array_add(struct nrf_cloud_obj *const obj, const char *con
 			       ? 0
 			       : -ENOMEM;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_int_array_add(obj->stream, key, ints, ints_cnt,
+							  data_child);
+	}
 	default:
 		break;
 	}
@@ -670,18 +774,27 @@ int nrf_cloud_obj_str_array_add(struct nrf_cloud_obj *const obj, const char *con
 	if (!obj || !key || !strs || !strs_cnt) {
 		return -EINVAL;
 	}
-	if (!obj->json) {
-		return -ENOENT;
-	}
 
 	switch (obj->type) {
 	case NRF_CLOUD_OBJ_TYPE_JSON: {
+		if (!obj->json) {
+			return -ENOENT;
+		}
+
 		cJSON *array = cJSON_CreateStringArray(strs, strs_cnt);
 
 		return cJSON_AddItemToObjectCS(dest_json_get(obj, data_child), key, array)
 			       ? 0
 			       : -ENOMEM;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_str_array_add(obj->stream, key, strs, strs_cnt,
+							  data_child);
+	}
 	default:
 		break;
 	}
@@ -738,6 +851,19 @@ int nrf_cloud_obj_cloud_encode(struct nrf_cloud_obj *const obj)
 		return -ENOSYS;
 #endif
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		int ret = nrf_cloud_obj_stream_encode(obj->stream, &obj->encoded_data);
+
+		if (!ret) {
+			obj->enc_src = NRF_CLOUD_ENC_SRC_CLOUD_ENCODED;
+		}
+
+		return ret;
+	}
 	default:
 		break;
 	}
@@ -745,6 +871,13 @@ int nrf_cloud_obj_cloud_encode(struct nrf_cloud_obj *const obj)
 	return -ENOTSUP;
 }
 
+static bool obj_cbor_check(const struct nrf_cloud_obj *const obj)
+{
+	return (obj->type == NRF_CLOUD_OBJ_TYPE_COAP_CBOR) ||
+	       ((obj->type == NRF_CLOUD_OBJ_TYPE_STREAM) && obj->stream &&
+		(obj->stream->fmt == NRF_CLOUD_OBJ_STREAM_FMT_CBOR));
+}
+
 int nrf_cloud_obj_gnss_msg_create(struct nrf_cloud_obj *const obj,
 				  const struct nrf_cloud_gnss_data *const gnss)
 {
@@ -762,7 +895,7 @@ int nrf_cloud_obj_gnss_msg_create(struct nrf_cloud_obj *const obj,
 
 	/* Add the app ID, message type, and timestamp */
 	msg_type =
-		(IS_ENABLED(CONFIG_NRF_CLOUD_COAP) && (obj->type == NRF_CLOUD_OBJ_TYPE_COAP_CBOR))
+		(IS_ENABLED(CONFIG_NRF_CLOUD_COAP) && obj_cbor_check(obj))
 			? NULL
 			: NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA;
 
@@ -787,6 +920,14 @@ int nrf_cloud_obj_gnss_msg_create(struct nrf_cloud_obj *const obj,
 			goto cleanup;
 		}
 		return nrf_cloud_obj_pvt_add(obj, &gnss->pvt);
+	} else if (obj->type == NRF_CLOUD_OBJ_TYPE_STREAM) {
+		/* Stream objects cannot be nested, so PVT data is written to the data child */
+		if (gnss->type == NRF_CLOUD_GNSS_TYPE_PVT) {
+			return nrf_cloud_obj_pvt_add(obj, &gnss->pvt);
+		} else if (gnss->type == NRF_CLOUD_GNSS_TYPE_MODEM_PVT) {
+			ret = -ENOTSUP;
+			goto cleanup;
+		}
 	} else if (obj->type != NRF_CLOUD_OBJ_TYPE_JSON) {
 		ret = -ENOTSUP;
 		goto cleanup;
@@ -911,6 +1052,13 @@ int nrf_cloud_obj_pvt_add(struct nrf_cloud_obj *const obj,
 
 		return 0;
 	}
+	case NRF_CLOUD_OBJ_TYPE_STREAM: {
+		if (!obj->stream) {
+			return -ENOENT;
+		}
+
+		return nrf_cloud_obj_stream_pvt_add(obj->stream, pvt);
+	}
 	default:
 		break;
 	}
@@ -130,6 +130,16 @@ const char *nrf_cloud_get_sensor_type_str_internal(enum nrf_cloud_sensor type)
 int nrf_cloud_codec_init(struct nrf_cloud_os_mem_hooks *hooks)
 {
 	if (!initialized) {
+#if defined(CONFIG_NRF_CLOUD_MEM_ARENA)
+		/* Messages come from the arena, which falls back to the memory hooks */
+		cJSON_Hooks cjson_hooks = {
+			.free_fn = nrf_cloud_arena_free,
+			.malloc_fn = nrf_cloud_arena_malloc,
+		};
+
+		ARG_UNUSED(hooks);
+		cJSON_InitHooks(&cjson_hooks);
+#else
 		if (hooks == NULL) {
 			/* Use OS defaults */
 			cJSON_Init();
@@ -141,6 +151,7 @@ int nrf_cloud_codec_init(struct nrf_cloud_os_mem_hooks *hooks)
 
 			cJSON_InitHooks(&cjson_hooks);
 		}
+#endif
 #if defined(CONFIG_MODEM_INFO)
 		init_modem_info();
 #endif
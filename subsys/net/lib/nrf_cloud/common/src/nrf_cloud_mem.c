@@ -9,12 +9,31 @@
 #include <zephyr/logging/log.h>
 
 #include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_mem.h"
 
 LOG_MODULE_REGISTER(nrf_cloud_mem, CONFIG_NRF_CLOUD_LOG_LEVEL);
 
 static struct nrf_cloud_os_mem_hooks used_hooks = {
 	.malloc_fn = k_malloc, .calloc_fn = k_calloc, .free_fn = k_free};
 
+#if defined(CONFIG_NRF_CLOUD_MEM_ARENA)
+#define ARENA_ALIGN sizeof(long long)
+
+static uint8_t arena[CONFIG_NRF_CLOUD_MEM_ARENA_SIZE] __aligned(ARENA_ALIGN);
+static struct k_spinlock arena_lock;
+/* Offset of the first free byte */
+static size_t arena_top;
+/* Number of blocks allocated from the arena that have not been freed */
+static size_t arena_blocks;
+/* Most recent block, which can be returned to the arena when it is freed first */
+static void *arena_last;
+
+static bool arena_owns(const void *ptr)
+{
+	return ((const uint8_t *)ptr >= arena) && ((const uint8_t *)ptr < &arena[sizeof(arena)]);
+}
+#endif /* CONFIG_NRF_CLOUD_MEM_ARENA */
+
 void *nrf_cloud_calloc(size_t count, size_t size)
 {
 	return used_hooks.calloc_fn(count, size);
@@ -27,6 +46,14 @@ void *nrf_cloud_malloc(size_t size)
 
 void nrf_cloud_free(void *ptr)
 {
+#if defined(CONFIG_NRF_CLOUD_MEM_ARENA)
+	/* Strings printed by cJSON are often freed with this function */
+	if (arena_owns(ptr)) {
+		nrf_cloud_arena_free(ptr);
+		return;
+	}
+#endif
+
 	if (ptr) {
 		used_hooks.free_fn(ptr);
 	}
@@ -45,3 +72,61 @@ void nrf_cloud_os_mem_hooks_init(struct nrf_cloud_os_mem_hooks *hooks)
 	/* Codec hooks need to be the same */
 	(void)nrf_cloud_codec_init(hooks);
 }
+
+#if defined(CONFIG_NRF_CLOUD_MEM_ARENA)
+void *nrf_cloud_arena_malloc(size_t size)
+{
+	size_t block_size = MAX(ROUND_UP(size, ARENA_ALIGN), ARENA_ALIGN);
+	void *ptr = NULL;
+	k_spinlock_key_t key;
+
+	if (size <= CONFIG_NRF_CLOUD_MEM_ARENA_ALLOC_MAX) {
+		key = k_spin_lock(&arena_lock);
+
+		if (block_size <= sizeof(arena) - arena_top) {
+			ptr = &arena[arena_top];
+			arena_top += block_size;
+			arena_blocks++;
+			arena_last = ptr;
+		}
+
+		k_spin_unlock(&arena_lock, key);
+	}
+
+	if (!ptr) {
+		LOG_DBG("Allocating %zu bytes outside the arena", size);
+		ptr = used_hooks.malloc_fn(size);
+	}
+
+	return ptr;
+}
+
+void nrf_cloud_arena_free(void *ptr)
+{
+	k_spinlock_key_t key;
+
+	if (!ptr) {
+		return;
+	}
+
+	if (!arena_owns(ptr)) {
+		used_hooks.free_fn(ptr);
+		return;
+	}
+
+	key = k_spin_lock(&arena_lock);
+
+	__ASSERT_NO_MSG(arena_blocks > 0);
+
+	if (--arena_blocks == 0) {
+		/* The last message was freed, so the whole arena is available again */
+		arena_top = 0;
+		arena_last = NULL;
+	} else if (ptr == arena_last) {
+		arena_top = (uint8_t *)ptr - arena;
+		arena_last = NULL;
+	}
+
+	k_spin_unlock(&arena_lock, key);
+}
+#endif /* CONFIG_NRF_CLOUD_MEM_ARENA */
@@ -0,0 +1,904 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <net/nrf_cloud_defs.h>
+#include "nrf_cloud_obj_stream.h"
+
+/* CBOR initial bytes, major type in the upper three bits */
+#define CBOR_UINT		0x00
+#define CBOR_NINT		0x20
+#define CBOR_TSTR		0x60
+#define CBOR_ARRAY		0x80
+#define CBOR_MAP		0xA0
+#define CBOR_FLOAT64		0xFB
+
+/* Largest argument stored in the initial byte, and the codes of the longer arguments */
+#define CBOR_ARG_IMMEDIATE_MAX	23
+#define CBOR_ARG_1		24
+#define CBOR_ARG_2		25
+#define CBOR_ARG_4		26
+#define CBOR_ARG_8		27
+
+/* Integer keys of the CoAP message_out schema, see nrf_cloud_coap_device_msg.cddl */
+#define MSG_KEY_APP_ID		1
+#define MSG_KEY_DATA		2
+#define MSG_KEY_TS		3
+#define MSG_KEY_PVT_LAT		4
+#define MSG_KEY_PVT_LNG		5
+#define MSG_KEY_PVT_ACC		6
+#define MSG_KEY_PVT_SPD		7
+#define MSG_KEY_PVT_HDG		8
+#define MSG_KEY_PVT_ALT		9
+
+#define MSG_KEYS_REQUIRED	(BIT(MSG_KEY_APP_ID) | BIT(MSG_KEY_DATA))
+#define MSG_KEYS_PVT_REQUIRED	(BIT(MSG_KEY_PVT_LAT) | BIT(MSG_KEY_PVT_LNG) | BIT(MSG_KEY_PVT_ACC))
+
+/* Integral JSON numbers below this are printed without exponent, like cJSON does */
+#define JSON_INT_LIMIT		1e15
+#define JSON_NUM_LEN_MAX	26
+
+struct cbor_key {
+	const char *name;
+	uint8_t id;
+};
+
+static const struct cbor_key msg_keys[] = {
+	{ NRF_CLOUD_JSON_APPID_KEY, MSG_KEY_APP_ID },
+	{ NRF_CLOUD_JSON_DATA_KEY, MSG_KEY_DATA },
+	{ NRF_CLOUD_MSG_TIMESTAMP_KEY, MSG_KEY_TS },
+};
+
+static const struct cbor_key pvt_keys[] = {
+	{ NRF_CLOUD_JSON_GNSS_PVT_KEY_LAT, MSG_KEY_PVT_LAT },
+	{ NRF_CLOUD_JSON_GNSS_PVT_KEY_LON, MSG_KEY_PVT_LNG },
+	{ NRF_CLOUD_JSON_GNSS_PVT_KEY_ACCURACY, MSG_KEY_PVT_ACC },
+	{ NRF_CLOUD_JSON_GNSS_PVT_KEY_SPEED, MSG_KEY_PVT_SPD },
+	{ NRF_CLOUD_JSON_GNSS_PVT_KEY_HEADING, MSG_KEY_PVT_HDG },
+	{ NRF_CLOUD_JSON_GNSS_PVT_KEY_ALTITUDE, MSG_KEY_PVT_ALT },
+};
+
+static bool is_cbor(const struct nrf_cloud_obj_stream *const stream)
+{
+	return stream->fmt == NRF_CLOUD_OBJ_STREAM_FMT_CBOR;
+}
+
+/* CBOR messages follow the message_out schema, so only its members have a key */
+static int cbor_key_id_get(const char *const key, const bool data_child)
+{
+	const struct cbor_key *keys = data_child ? pvt_keys : msg_keys;
+	size_t cnt = data_child ? ARRAY_SIZE(pvt_keys) : ARRAY_SIZE(msg_keys);
+
+	for (size_t i = 0; i < cnt; i++) {
+		if (strcmp(keys[i].name, key) == 0) {
+			return keys[i].id;
+		}
+	}
+
+	return -ENOTSUP;
+}
+
+static size_t cbor_head_len(const uint64_t arg)
+{
+	if (arg <= CBOR_ARG_IMMEDIATE_MAX) {
+		return 1;
+	} else if (arg <= UINT8_MAX) {
+		return 2;
+	} else if (arg <= UINT16_MAX) {
+		return 3;
+	} else if (arg <= UINT32_MAX) {
+		return 5;
+	}
+
+	return 9;
+}
+
+/* Room kept free for the timestamp, which is written last like in message_out */
+static size_t reserved_len(const struct nrf_cloud_obj_stream *const stream)
+{
+	return stream->ts_pending ? 1 + cbor_head_len(stream->ts) : 0;
+}
+
+static int put(struct nrf_cloud_obj_stream *const stream, const void *const data,
+	       const size_t len)
+{
+	if (len + reserved_len(stream) > stream->size - stream->len) {
+		return -ENOMEM;
+	}
+
+	memcpy(&stream->buf[stream->len], data, len);
+	stream->len += len;
+
+	return 0;
+}
+
+static int put_byte(struct nrf_cloud_obj_stream *const stream, const uint8_t byte)
+{
+	return put(stream, &byte, 1);
+}
+
+static int cbor_head_put(struct nrf_cloud_obj_stream *const stream, const uint8_t major,
+			 const uint64_t arg)
+{
+	uint8_t head[9];
+	size_t len;
+
+	if (arg <= CBOR_ARG_IMMEDIATE_MAX) {
+		head[0] = major | arg;
+		len = 1;
+	} else if (arg <= UINT8_MAX) {
+		head[0] = major | CBOR_ARG_1;
+		head[1] = arg;
+		len = 2;
+	} else if (arg <= UINT16_MAX) {
+		head[0] = major | CBOR_ARG_2;
+		sys_put_be16(arg, &head[1]);
+		len = 3;
+	} else if (arg <= UINT32_MAX) {
+		head[0] = major | CBOR_ARG_4;
+		sys_put_be32(arg, &head[1]);
+		len = 5;
+	} else {
+		head[0] = major | CBOR_ARG_8;
+		sys_put_be64(arg, &head[1]);
+		len = 9;
+	}
+
+	return put(stream, head, len);
+}
+
+static int json_str_put(struct nrf_cloud_obj_stream *const stream, const char *str)
+{
+	const char *run = str;
+	char esc[7];
+	int len;
+	int err;
+
+	err = put_byte(stream, '"');
+
+	/* Copy runs of plain characters at once, escaping what cJSON escapes */
+	for (; !err && *str; str++) {
+		uint8_t c = *str;
+
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+
+		err = put(stream, run, str - run);
+		if (err) {
+			break;
+		}
+
+		run = str + 1;
+
+		switch (c) {
+		case '"':
+		case '\\':
+			esc[1] = c;
+			break;
+		case '\b':
+			esc[1] = 'b';
+			break;
+		case '\f':
+			esc[1] = 'f';
+			break;
+		case '\n':
+			esc[1] = 'n';
+			break;
+		case '\r':
+			esc[1] = 'r';
+			break;
+		case '\t':
+			esc[1] = 't';
+			break;
+		default:
+			len = snprintf(esc, sizeof(esc), "\\u%04x", c);
+			err = put(stream, esc, len);
+			continue;
+		}
+
+		esc[0] = '\\';
+		err = put(stream, esc, 2);
+	}
+
+	if (!err) {
+		err = put(stream, run, str - run);
+	}
+
+	return err ? err : put_byte(stream, '"');
+}
+
+static int str_put(struct nrf_cloud_obj_stream *const stream, const char *const str)
+{
+	size_t len;
+	int err;
+
+	if (!is_cbor(stream)) {
+		return json_str_put(stream, str);
+	}
+
+	len = strlen(str);
+	err = cbor_head_put(stream, CBOR_TSTR, len);
+
+	return err ? err : put(stream, str, len);
+}
+
+static int cbor_float64_put(struct nrf_cloud_obj_stream *const stream, const double val)
+{
+	uint8_t head[9];
+	uint64_t bits;
+
+	memcpy(&bits, &val, sizeof(bits));
+	head[0] = CBOR_FLOAT64;
+	sys_put_be64(bits, &head[1]);
+
+	return put(stream, head, sizeof(head));
+}
+
+/* Numbers are written with the types that the message_out schema gives the key */
+static int cbor_num_put(struct nrf_cloud_obj_stream *const stream, const int key_id,
+			const double val)
+{
+	switch (key_id) {
+	case MSG_KEY_APP_ID:
+		return -EINVAL;
+	case MSG_KEY_DATA:
+		if ((floor(val) == val) && (val >= INT32_MIN) && (val <= INT32_MAX)) {
+			int32_t num = (int32_t)val;
+
+			return (num < 0) ? cbor_head_put(stream, CBOR_NINT, -1 - (int64_t)num)
+					 : cbor_head_put(stream, CBOR_UINT, num);
+		}
+
+		return cbor_float64_put(stream, val);
+	default:
+		/* PVT members are all floats */
+		return cbor_float64_put(stream, val);
+	}
+}
+
+static int json_num_put(struct nrf_cloud_obj_stream *const stream, const double val)
+{
+	char num[JSON_NUM_LEN_MAX];
+	int len;
+
+	if (isnan(val) || isinf(val)) {
+		return put(stream, "null", 4);
+	}
+
+	if ((floor(val) == val) && (fabs(val) < JSON_INT_LIMIT)) {
+		len = snprintf(num, sizeof(num), "%lld", (long long)val);
+	} else {
+		/* Use the shortest precision that reads back as the same value */
+		len = snprintf(num, sizeof(num), "%1.15g", val);
+		if (strtod(num, NULL) != val) {
+			len = snprintf(num, sizeof(num), "%1.17g", val);
+		}
+	}
+
+	return put(stream, num, len);
+}
+
+static int json_bool_put(struct nrf_cloud_obj_stream *const stream, const bool val)
+{
+	return val ? put(stream, "true", 4) : put(stream, "false", 5);
+}
+
+static int json_null_put(struct nrf_cloud_obj_stream *const stream)
+{
+	return put(stream, "null", 4);
+}
+
+static int container_open(struct nrf_cloud_obj_stream *const stream, const bool map)
+{
+	int err;
+
+	if (stream->depth == ARRAY_SIZE(stream->level)) {
+		return -E2BIG;
+	}
+
+	stream->level[stream->depth].offset = stream->len;
+	stream->level[stream->depth].count = 0;
+	stream->level[stream->depth].map = map;
+
+	/* CBOR containers start with a one-byte head that is completed when closing */
+	if (is_cbor(stream)) {
+		err = put_byte(stream, map ? CBOR_MAP : CBOR_ARRAY);
+	} else {
+		err = put_byte(stream, map ? '{' : '[');
+	}
+
+	if (!err) {
+		stream->depth++;
+	}
+
+	return err;
+}
+
+static uint8_t cbor_container_major(const struct nrf_cloud_obj_stream *const stream,
+				    const uint8_t level)
+{
+	return stream->level[level].map ? CBOR_MAP : CBOR_ARRAY;
+}
+
+static size_t cbor_head_extra(const uint16_t count)
+{
+	if (count <= CBOR_ARG_IMMEDIATE_MAX) {
+		return 0;
+	}
+
+	return (count <= UINT8_MAX) ? 1 : 2;
+}
+
+static int container_close(struct nrf_cloud_obj_stream *const stream)
+{
+	uint8_t level = stream->depth - 1;
+	size_t offset = stream->level[level].offset;
+	uint16_t count = stream->level[level].count;
+	uint8_t major;
+	size_t extra;
+
+	if (!is_cbor(stream)) {
+		stream->depth--;
+		return put_byte(stream, stream->level[level].map ? '}' : ']');
+	}
+
+	major = cbor_container_major(stream, level);
+	extra = cbor_head_extra(count);
+
+	/* If the count does not fit into the head, the contents are moved to make room */
+	if (extra) {
+		if (extra > stream->size - stream->len) {
+			return -ENOMEM;
+		}
+
+		memmove(&stream->buf[offset + 1 + extra], &stream->buf[offset + 1],
+			stream->len - offset - 1);
+		stream->len += extra;
+	}
+
+	if (extra == 0) {
+		stream->buf[offset] = major | count;
+	} else if (extra == 1) {
+		stream->buf[offset] = major | CBOR_ARG_1;
+		stream->buf[offset + 1] = count;
+	} else {
+		stream->buf[offset] = major | CBOR_ARG_2;
+		sys_put_be16(count, &stream->buf[offset + 1]);
+	}
+
+	stream->depth--;
+
+	return 0;
+}
+
+static int element_begin(struct nrf_cloud_obj_stream *const stream)
+{
+	uint16_t *count = &stream->level[stream->depth - 1].count;
+
+	if (*count == UINT16_MAX) {
+		return -E2BIG;
+	}
+
+	if (!is_cbor(stream) && *count) {
+		int err = put_byte(stream, ',');
+
+		if (err) {
+			return err;
+		}
+	}
+
+	(*count)++;
+
+	return 0;
+}
+
+/* Write a member key, returning the message_out key ID of CBOR members */
+static int key_put(struct nrf_cloud_obj_stream *const stream, const char *const key)
+{
+	int id;
+	int err;
+
+	if (!is_cbor(stream)) {
+		err = json_str_put(stream, key);
+		return err ? err : put_byte(stream, ':');
+	}
+
+	id = cbor_key_id_get(key, stream->data_open);
+	if (id < 0) {
+		return id;
+	}
+
+	if (stream->cbor_keys & BIT(id)) {
+		return -EEXIST;
+	}
+
+	err = cbor_head_put(stream, CBOR_UINT, id);
+	if (err) {
+		return err;
+	}
+
+	stream->cbor_keys |= BIT(id);
+
+	return id;
+}
+
+static int data_child_set(struct nrf_cloud_obj_stream *const stream, const bool data_child)
+{
+	int err;
+
+	if (data_child == stream->data_open) {
+		return 0;
+	}
+
+	if (!data_child) {
+		/* A PVT value of message_out must have its mandatory members */
+		if (is_cbor(stream) &&
+		    ((stream->cbor_keys & MSG_KEYS_PVT_REQUIRED) != MSG_KEYS_PVT_REQUIRED)) {
+			return -ENODATA;
+		}
+
+		err = container_close(stream);
+		if (!err) {
+			stream->data_open = false;
+			stream->data_done = true;
+		}
+
+		return err;
+	}
+
+	/* The data child must be written in one piece, it cannot be reopened */
+	if (stream->data_done) {
+		return -EPERM;
+	}
+
+	err = element_begin(stream);
+	if (!err) {
+		err = key_put(stream, NRF_CLOUD_JSON_DATA_KEY);
+	}
+	if (err >= 0) {
+		err = container_open(stream, true);
+	}
+
+	stream->data_open = true;
+
+	return err;
+}
+
+/* Begin a member, returning its message_out key ID in CBOR and 0 in JSON */
+static int member_begin(struct nrf_cloud_obj_stream *const stream, const char *const key,
+			const bool data_child)
+{
+	int err;
+
+	if (!stream->depth) {
+		return -ENOENT;
+	}
+
+	if (!stream->level[0].map) {
+		return -ENODEV;
+	}
+
+	err = data_child_set(stream, data_child);
+	if (!err) {
+		err = element_begin(stream);
+	}
+
+	return err ? err : key_put(stream, key);
+}
+
+/* Restore the state from before a failed operation */
+static int finish(struct nrf_cloud_obj_stream *const stream,
+		  const struct nrf_cloud_obj_stream *const saved, const int err)
+{
+	size_t offset;
+	size_t extra;
+
+	if (!err) {
+		return 0;
+	}
+
+	/* The "data" child is the only container that an operation can close before
+	 * failing, so only its contents can have been moved to widen its head.
+	 */
+	if (is_cbor(stream) && saved->data_open && !stream->data_open) {
+		offset = saved->level[1].offset;
+		extra = cbor_head_extra(saved->level[1].count);
+
+		if (extra) {
+			memmove(&stream->buf[offset + 1], &stream->buf[offset + 1 + extra],
+				saved->len - offset - 1);
+		}
+	}
+
+	*stream = *saved;
+
+	return err;
+}
+
+static int cbor_ts_put(struct nrf_cloud_obj_stream *const stream)
+{
+	int err;
+
+	stream->ts_pending = false;
+
+	err = element_begin(stream);
+	if (!err) {
+		err = key_put(stream, NRF_CLOUD_MSG_TIMESTAMP_KEY);
+	}
+
+	return (err < 0) ? err : cbor_head_put(stream, CBOR_UINT, stream->ts);
+}
+
+static int complete(struct nrf_cloud_obj_stream *const stream)
+{
+	int err;
+
+	err = data_child_set(stream, false);
+
+	if (!err && is_cbor(stream) && stream->ts_pending) {
+		err = cbor_ts_put(stream);
+	}
+
+	if (!err && is_cbor(stream) &&
+	    ((stream->cbor_keys & MSG_KEYS_REQUIRED) != MSG_KEYS_REQUIRED)) {
+		err = -ENODATA;
+	}
+
+	while (!err && stream->depth) {
+		err = container_close(stream);
+	}
+
+	return err;
+}
+
+int nrf_cloud_obj_stream_init(struct nrf_cloud_obj_stream *const stream, const bool bulk)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+
+	if (stream->len) {
+		return -ENOTEMPTY;
+	}
+
+	/* The CoAP bulk resource only takes JSON */
+	if (bulk && is_cbor(stream)) {
+		return -ENOTSUP;
+	}
+
+	stream->bulk = bulk;
+	stream->data_open = false;
+	stream->data_done = false;
+	stream->ts_pending = false;
+	stream->cbor_keys = 0;
+
+	return finish(stream, &saved, container_open(stream, !bulk));
+}
+
+int nrf_cloud_obj_stream_msg_init(struct nrf_cloud_obj_stream *const stream,
+				  const char *const app_id, const char *const msg_type)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+	int err;
+
+	err = nrf_cloud_obj_stream_init(stream, false);
+	if (err) {
+		return err;
+	}
+
+	err = member_begin(stream, NRF_CLOUD_JSON_APPID_KEY, false);
+	if (err >= 0) {
+		err = str_put(stream, app_id);
+	}
+
+	/* The message type is not part of the CoAP message_out schema */
+	if (!err && msg_type && !is_cbor(stream)) {
+		err = member_begin(stream, NRF_CLOUD_JSON_MSG_TYPE_KEY, false);
+		if (!err) {
+			err = str_put(stream, msg_type);
+		}
+	}
+
+	return finish(stream, &saved, err);
+}
+
+void nrf_cloud_obj_stream_reset(struct nrf_cloud_obj_stream *const stream)
+{
+	stream->len = 0;
+	stream->depth = 0;
+	stream->bulk = false;
+	stream->data_open = false;
+	stream->data_done = false;
+	stream->ts_pending = false;
+	stream->cbor_keys = 0;
+}
+
+bool nrf_cloud_obj_stream_bulk_check(const struct nrf_cloud_obj_stream *const stream)
+{
+	return stream->len && stream->bulk;
+}
+
+int nrf_cloud_obj_stream_bulk_add(struct nrf_cloud_obj_stream *const bulk,
+				  struct nrf_cloud_obj_stream *const stream)
+{
+	const struct nrf_cloud_obj_stream saved_bulk = *bulk;
+	const struct nrf_cloud_obj_stream saved = *stream;
+	int err;
+
+	if (bulk->fmt != stream->fmt) {
+		return -EINVAL;
+	}
+
+	if (!bulk->depth || !stream->len) {
+		return -ENOENT;
+	}
+
+	if (!bulk->bulk || stream->bulk) {
+		return -ENODEV;
+	}
+
+	err = complete(stream);
+	if (!err) {
+		err = element_begin(bulk);
+	}
+	if (!err) {
+		err = put(bulk, stream->buf, stream->len);
+	}
+
+	if (err) {
+		(void)finish(stream, &saved, err);
+		return finish(bulk, &saved_bulk, err);
+	}
+
+	nrf_cloud_obj_stream_reset(stream);
+
+	return 0;
+}
+
+/* The timestamp is written when the message is completed, as the last message_out member */
+static int cbor_ts_set(struct nrf_cloud_obj_stream *const stream, const double val)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+
+	if (!stream->depth) {
+		return -ENOENT;
+	}
+
+	if ((val < 0) || (floor(val) != val) || (val >= 0x1p64)) {
+		return -EINVAL;
+	}
+
+	if (stream->ts_pending || (stream->cbor_keys & BIT(MSG_KEY_TS))) {
+		return -EEXIST;
+	}
+
+	stream->ts = (uint64_t)val;
+	stream->ts_pending = true;
+
+	/* Fail now rather than when encoding if there is no room left for it */
+	if (reserved_len(stream) > stream->size - stream->len) {
+		return finish(stream, &saved, -ENOMEM);
+	}
+
+	return 0;
+}
+
+int nrf_cloud_obj_stream_num_add(struct nrf_cloud_obj_stream *const stream,
+				 const char *const key, const double val, const bool data_child)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+	int key_id;
+	int err;
+
+	if (is_cbor(stream) && !data_child && (strcmp(key, NRF_CLOUD_MSG_TIMESTAMP_KEY) == 0)) {
+		return cbor_ts_set(stream, val);
+	}
+
+	key_id = member_begin(stream, key, data_child);
+	if (key_id < 0) {
+		err = key_id;
+	} else if (is_cbor(stream)) {
+		err = cbor_num_put(stream, key_id, val);
+	} else {
+		err = json_num_put(stream, val);
+	}
+
+	return finish(stream, &saved, err);
+}
+
+int nrf_cloud_obj_stream_str_add(struct nrf_cloud_obj_stream *const stream,
+				 const char *const key, const char *const val,
+				 const bool data_child)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+	int key_id;
+	int err;
+
+	key_id = member_begin(stream, key, data_child);
+	if (key_id < 0) {
+		err = key_id;
+	} else if (is_cbor(stream) && (key_id != MSG_KEY_DATA)) {
+		/* Only the data value of message_out can be a string besides the app ID */
+		err = -EINVAL;
+	} else {
+		err = str_put(stream, val);
+	}
+
+	return finish(stream, &saved, err);
+}
+
+/* Booleans, nulls and arrays have no place in the CoAP message_out schema,
+ * so they can only be added to JSON streams.
+ */
+
+int nrf_cloud_obj_stream_bool_add(struct nrf_cloud_obj_stream *const stream,
+				  const char *const key, const bool val, const bool data_child)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+	int err;
+
+	if (is_cbor(stream)) {
+		return -ENOTSUP;
+	}
+
+	err = member_begin(stream, key, data_child);
+	if (!err) {
+		err = json_bool_put(stream, val);
+	}
+
+	return finish(stream, &saved, err);
+}
+
+int nrf_cloud_obj_stream_null_add(struct nrf_cloud_obj_stream *const stream,
+				  const char *const key, const bool data_child)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+	int err;
+
+	if (is_cbor(stream)) {
+		return -ENOTSUP;
+	}
+
+	err = member_begin(stream, key, data_child);
+	if (!err) {
+		err = json_null_put(stream);
+	}
+
+	return finish(stream, &saved, err);
+}
+
+int nrf_cloud_obj_stream_int_array_add(struct nrf_cloud_obj_stream *const stream,
+				       const char *const key, const uint32_t ints[],
+				       const uint32_t ints_cnt, const bool data_child)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+	int err;
+
+	if (is_cbor(stream)) {
+		return -ENOTSUP;
+	}
+
+	err = member_begin(stream, key, data_child);
+	if (!err) {
+		err = container_open(stream, false);
+	}
+
+	for (uint32_t i = 0; !err && (i < ints_cnt); i++) {
+		err = element_begin(stream);
+		if (!err) {
+			err = json_num_put(stream, ints[i]);
+		}
+	}
+
+	if (!err) {
+		err = container_close(stream);
+	}
+
+	return finish(stream, &saved, err);
+}
+
+int nrf_cloud_obj_stream_str_array_add(struct nrf_cloud_obj_stream *const stream,
+				       const char *const key, const char *const strs[],
+				       const uint32_t strs_cnt, const bool data_child)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+	int err;
+
+	if (is_cbor(stream)) {
+		return -ENOTSUP;
+	}
+
+	err = member_begin(stream, key, data_child);
+	if (!err) {
+		err = container_open(stream, false);
+	}
+
+	for (uint32_t i = 0; !err && (i < strs_cnt); i++) {
+		err = element_begin(stream);
+		if (!err) {
+			err = str_put(stream, strs[i]);
+		}
+	}
+
+	if (!err) {
+		err = container_close(stream);
+	}
+
+	return finish(stream, &saved, err);
+}
+
+int nrf_cloud_obj_stream_pvt_add(struct nrf_cloud_obj_stream *const stream,
+				 const struct nrf_cloud_gnss_pvt *const pvt)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+	struct pvt_member {
+		const char *key;
+		double val;
+		bool present;
+	};
+	/* JSON keeps the order of nrf_cloud_pvt_data_encode(), CBOR that of message_out */
+	const struct pvt_member json_members[] = {
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_LON, pvt->lon, true },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_LAT, pvt->lat, true },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_ACCURACY, pvt->accuracy, true },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_ALTITUDE, pvt->alt, pvt->has_alt },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_SPEED, pvt->speed, pvt->has_speed },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_HEADING, pvt->heading, pvt->has_heading },
+	};
+	const struct pvt_member cbor_members[] = {
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_LAT, pvt->lat, true },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_LON, pvt->lon, true },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_ACCURACY, pvt->accuracy, true },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_SPEED, pvt->speed, pvt->has_speed },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_HEADING, pvt->heading, pvt->has_heading },
+		{ NRF_CLOUD_JSON_GNSS_PVT_KEY_ALTITUDE, pvt->alt, pvt->has_alt },
+	};
+	const struct pvt_member *members = is_cbor(stream) ? cbor_members : json_members;
+	int err = 0;
+
+	for (size_t i = 0; !err && (i < ARRAY_SIZE(json_members)); i++) {
+		if (members[i].present) {
+			err = nrf_cloud_obj_stream_num_add(stream, members[i].key, members[i].val,
+							   true);
+		}
+	}
+
+	/* The PVT members are added as a whole or not at all */
+	return finish(stream, &saved, err);
+}
+
+int nrf_cloud_obj_stream_encode(struct nrf_cloud_obj_stream *const stream,
+				struct nrf_cloud_data *const output)
+{
+	const struct nrf_cloud_obj_stream saved = *stream;
+	int err;
+
+	if (!stream->len) {
+		return -ENOENT;
+	}
+
+	err = complete(stream);
+
+	/* JSON is null-terminated like the output of cJSON_PrintUnformatted() */
+	if (!err && !is_cbor(stream)) {
+		if (stream->len == stream->size) {
+			err = -ENOMEM;
+		} else {
+			stream->buf[stream->len] = '\0';
+		}
+	}
+
+	if (!err) {
+		output->ptr = stream->buf;
+		output->len = stream->len;
+	}
+
+	return finish(stream, &saved, err);
+}
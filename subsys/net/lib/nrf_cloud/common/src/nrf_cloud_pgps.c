@@ -9,6 +9,7 @@
 #include <zephyr/device.h>
 #include <zephyr/storage/stream_flash.h>
 #include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
 
 #include <cJSON.h>
 #include <modem/modem_info.h>
@@ -51,6 +52,10 @@ BUILD_ASSERT(((NUM_PREDICTIONS & 1) == 0), "NUM_PREDICTIONS must be even");
 BUILD_ASSERT(((REPLACEMENT_THRESHOLD & 1) == 0), "REPLACEMENT_THRESHOLD must be even");
 BUILD_ASSERT((NUM_PREDICTIONS != REPLACEMENT_THRESHOLD),
 	     "NUM_PREDICTIONS and REPLACEMENT_THRESHOLD cannot be equal");
+BUILD_ASSERT((PGPS_PREDICTION_DL_SIZE == (sizeof(struct pgps_prediction_dl_head) +
+					  NRF_CLOUD_PGPS_NUM_SV *
+					  sizeof(struct nrf_cloud_agnss_ephemeris))),
+	     "Unexpected P-GPS prediction layout");
 
 enum pgps_state {
 	PGPS_NONE,
@@ -79,6 +84,11 @@ struct pgps_index {
 	bool stale_server_data;
 	int32_t storage_extent;
 	int store_block;
+	/* State of the prediction being downloaded */
+	uint32_t dl_crc;
+	uint32_t dl_sentinel;
+	uint8_t part_len;
+	bool skip_prediction;
 
 	/* Array of memory offsets to predictions, in sorted time order.
 	 * If flash device is external, this must be passed
@@ -87,6 +97,10 @@ struct pgps_index {
 	 * a pointer.
 	 */
 	struct nrf_cloud_pgps_prediction *predictions[NUM_PREDICTIONS];
+	/* CRC of each prediction as stored in flash */
+	uint32_t crcs[NUM_PREDICTIONS];
+	/* Predictions restored from the saved index are checked when first used */
+	bool verified[NUM_PREDICTIONS];
 };
 
 static struct pgps_index index;
@@ -107,7 +121,9 @@ static off_t prediction_cache_flash_offset = UINT32_MAX;
 static uint8_t prediction_cache[PGPS_PREDICTION_STORAGE_SIZE];
 #endif
 
-static uint8_t prediction_buf[PGPS_PREDICTION_STORAGE_SIZE];
+/* Part of a prediction that is split across download fragments */
+static uint8_t part_buf[MAX(sizeof(struct pgps_prediction_dl_head),
+			    sizeof(struct nrf_cloud_agnss_ephemeris))];
 static volatile bool accept_packets;
 static volatile bool loading_in_progress;
 static volatile bool notified;
@@ -116,7 +132,8 @@ static int validate_stored_predictions(uint16_t *bad_day, uint32_t *bad_time);
 static void log_pgps_header(const char *msg, const struct nrf_cloud_pgps_header *header);
 static int consume_pgps_header(const char *buf, size_t buf_len);
 static void cache_pgps_header(const struct nrf_cloud_pgps_header *header);
-static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len);
+static int consume_pgps_part(const uint8_t *part);
+static int finish_prediction(uint8_t pnum);
 static void prediction_work_handler(struct k_work *work);
 static void prediction_timer_handler(struct k_timer *dummy);
 static bool prediction_timer_is_running(void);
@@ -138,6 +155,11 @@ static int get_prediction_block(int pnum)
 	return npgps_pointer_to_block((uint8_t *)index.predictions[pnum]);
 }
 
+static uint32_t prediction_crc(const struct nrf_cloud_pgps_prediction *p)
+{
+	return crc32_ieee((const uint8_t *)p, sizeof(*p));
+}
+
 /**
  * @brief When using external flash, ensure the prediction at the requested flash device offset
  * is available via the prediction cache.  When using internal flash, just the flash device offset
@@ -316,6 +338,7 @@ static int validate_stored_predictions(uint16_t *first_bad_day, uint32_t *first_
 	discard_prediction_buffer();
 	for (pnum = 0; pnum < count; pnum++) {
 		index.predictions[pnum] = NULL;
+		index.verified[pnum] = false;
 	}
 
 	npgps_reset_block_pool();
@@ -369,6 +392,9 @@ static int validate_stored_predictions(uint16_t *first_bad_day, uint32_t *first_
 			break;
 		}
 
+		index.crcs[pnum] = prediction_crc(pred);
+		index.verified[pnum] = true;
+
 		i = get_prediction_block(pnum);
 		LOG_DBG("Prediction num:%u, loc:%p, blk:%d", pnum, pred, i);
 		__ASSERT(i != NO_BLOCK, "unexpected pointer value %p", pred);
@@ -406,6 +432,97 @@ static void get_prediction_day_time(int pnum, int64_t *gps_sec, uint16_t *gps_da
 	}
 }
 
+/* Save the location and CRC of the first num_valid predictions */
+static int save_index(int num_valid)
+{
+	static struct npgps_index_record record;
+	uint16_t count = index.header.prediction_count;
+
+	memset(&record, 0, sizeof(record));
+	record.start_sec = index.start_sec;
+	record.count = count;
+
+	for (int pnum = 0; pnum < count; pnum++) {
+		if ((pnum < num_valid) && index.predictions[pnum]) {
+			record.block[pnum] = get_prediction_block(pnum);
+			record.crc[pnum] = index.crcs[pnum];
+		} else {
+			record.block[pnum] = INDEX_NO_BLOCK;
+		}
+	}
+
+	return npgps_save_index(&record);
+}
+
+/* Rebuild the catalog of predictions from the saved index, without reading them.
+ * Returns the number of consecutive predictions available, like validate_stored_predictions(),
+ * or -ENOENT if the index does not describe the stored set.
+ */
+static int load_stored_index(uint16_t *first_bad_day, uint32_t *first_bad_time)
+{
+	const struct npgps_index_record *record = npgps_get_saved_index();
+	uint16_t count = index.header.prediction_count;
+	int block = NO_BLOCK;
+	int pnum;
+
+	if ((record->count != count) || (record->start_sec != index.start_sec)) {
+		LOG_DBG("No index for stored predictions");
+		return -ENOENT;
+	}
+
+	discard_prediction_buffer();
+	npgps_reset_block_pool();
+	memset(index.predictions, 0, sizeof(index.predictions));
+
+	for (pnum = 0; pnum < count; pnum++) {
+		if (record->block[pnum] >= NUM_BLOCKS) {
+			LOG_WRN("Prediction num:%u missing", pnum);
+			get_prediction_day_time(pnum, NULL, first_bad_day, first_bad_time);
+			break;
+		}
+
+		block = record->block[pnum];
+		index.predictions[pnum] = npgps_block_to_pointer(block);
+		index.crcs[pnum] = record->crc[pnum];
+		index.verified[pnum] = false;
+		npgps_mark_block_used(block, true);
+	}
+
+	if (block != NO_BLOCK) {
+		(void)npgps_find_first_free(block);
+	}
+
+	npgps_print_blocks();
+	return pnum;
+}
+
+/* Check a prediction restored from the saved index the first time it is used */
+static int check_prediction(int pnum, const struct nrf_cloud_pgps_prediction *p)
+{
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+	int err;
+
+	if (index.verified[pnum]) {
+		return 0;
+	}
+
+	if (prediction_crc(p) != index.crcs[pnum]) {
+		LOG_ERR("Prediction num:%u does not match its CRC", pnum);
+		return -EBADMSG;
+	}
+
+	get_prediction_day_time(pnum, NULL, &gps_day, &gps_time_of_day);
+	err = validate_prediction(p, gps_day, gps_time_of_day, index.header.prediction_period_min,
+				  true, false);
+	if (err) {
+		return err;
+	}
+
+	index.verified[pnum] = true;
+	return 0;
+}
+
 static void discard_oldest_predictions(int num)
 {
 	int i;
@@ -433,6 +550,8 @@ static void discard_oldest_predictions(int num)
 	for (i = last; i < index.header.prediction_count; i++) {
 		pnum = i - last;
 		index.predictions[pnum] = index.predictions[i];
+		index.crcs[pnum] = index.crcs[i];
+		index.verified[pnum] = index.verified[i];
 	}
 
 	/* set prediction pointers for 'last' in the newly empty
@@ -673,6 +792,15 @@ int nrf_cloud_pgps_find_prediction(struct nrf_cloud_pgps_prediction **prediction
 	LOG_DBG("Selected prediction num:%d", pnum);
 	index.cur_pnum = pnum;
 	*prediction = get_prediction(pnum);
+	if (*prediction && check_prediction(pnum, *prediction)) {
+		/* the saved index or the stored data is stale; get a new set */
+		(void)npgps_clear_index();
+		*prediction = NULL;
+		index.cur_pnum = 0xff;
+		state = PGPS_EXPIRED;
+		loading_in_progress = false; /* make sure we request it */
+		return -ENODATA;
+	}
 	if (*prediction) {
 		err = validate_prediction(*prediction, cur_gps_day, cur_gps_time_of_day, period_min,
 					  false, margin);
@@ -1172,43 +1300,16 @@ static int open_storage(uint32_t offset, bool preserve)
 	return 0;
 }
 
-static int store_prediction(uint8_t *p, size_t len, uint32_t sentinel, bool last)
+static int store_bytes(const uint8_t *data, size_t len, bool flush)
 {
-	static bool first = true;
-	static uint8_t pad[PGPS_PREDICTION_PAD];
 	int err;
-	uint8_t schema = NRF_CLOUD_AGNSS_BIN_SCHEMA_VERSION;
-	size_t schema_offset = ((size_t)&((struct nrf_cloud_pgps_prediction *)0)->schema_version);
 
-	if (first) {
-		memset(pad, 0xff, PGPS_PREDICTION_PAD);
-		first = false;
-	}
+	/* the CRC covers the prediction as laid out in flash, without the padding */
+	index.dl_crc = crc32_ieee_update(index.dl_crc, data, len);
 
-	err = stream_flash_buffered_write(&stream, p, schema_offset, false);
-	if (err) {
-		LOG_ERR("Error writing pgps prediction:%d", err);
-		return err;
-	}
-	p += schema_offset;
-	len -= schema_offset;
-	err = stream_flash_buffered_write(&stream, &schema, sizeof(schema), false);
-	if (err) {
-		LOG_ERR("Error writing schema:%d", err);
-		return err;
-	}
-	err = stream_flash_buffered_write(&stream, p, len, false);
+	err = stream_flash_buffered_write(&stream, data, len, flush);
 	if (err) {
 		LOG_ERR("Error writing pgps prediction:%d", err);
-		return err;
-	}
-	err = stream_flash_buffered_write(&stream, (uint8_t *)&sentinel, sizeof(sentinel), false);
-	if (err) {
-		LOG_ERR("Error writing sentinel:%d", err);
-	}
-	err = stream_flash_buffered_write(&stream, pad, PGPS_PREDICTION_PAD, last);
-	if (err) {
-		LOG_ERR("Error writing sentinel:%d", err);
 	}
 	return err;
 }
@@ -1218,10 +1319,15 @@ static int flush_storage(void)
 	return stream_flash_buffered_write(&stream, NULL, 0, true);
 }
 
+static size_t dl_part_size(void)
+{
+	return (index.pred_offset == 0) ? sizeof(struct pgps_prediction_dl_head)
+					: sizeof(struct nrf_cloud_agnss_ephemeris);
+}
+
 int nrf_cloud_pgps_process_update(uint8_t *buf, size_t len)
 {
 	int err;
-	size_t need;
 	int64_t gps_sec;
 
 	if (buf == NULL) {
@@ -1275,34 +1381,48 @@ int nrf_cloud_pgps_process_update(uint8_t *buf, size_t len)
 		index.dl_offset += sizeof(*header);
 		index.dl_pnum = index.pnum_offset;
 		index.pred_offset = 0;
+		index.part_len = 0;
 	}
 
 	/* assume cache is no longer valid */
 	discard_prediction_buffer();
 
-	need = MIN((PGPS_PREDICTION_DL_SIZE - index.pred_offset), len);
-	memcpy(&prediction_buf[index.pred_offset], buf, need);
-	LOG_DBG("need:%zd bytes; pred_offset:%u, fragment len:%zd, dl_ofs:%zd", need,
-		index.pred_offset, len, index.dl_offset);
+	/* Parts of a prediction that lie entirely within the fragment are consumed
+	 * in place; only a part split across fragments is staged in part_buf.
+	 */
+	while (len) {
+		size_t part_size = dl_part_size();
+		const uint8_t *part;
+		size_t used;
+
+		if ((index.part_len == 0) && (len >= part_size)) {
+			part = buf;
+			used = part_size;
+		} else {
+			used = MIN(part_size - index.part_len, len);
+			memcpy(&part_buf[index.part_len], buf, used);
+			index.part_len += used;
+			part = part_buf;
+		}
+
+		len -= used;
+		buf += used;
+		index.dl_offset += used;
 
-	len -= need;
-	buf += need;
-	index.pred_offset += need;
-	index.dl_offset += need;
+		if ((part == part_buf) && (index.part_len < part_size)) {
+			break; /* rest of the part is in the next fragment */
+		}
+		index.part_len = 0;
 
-	if (index.pred_offset == PGPS_PREDICTION_DL_SIZE) {
-		LOG_DBG("consuming data prediction num:%u, remainder:%zd", index.dl_pnum, len);
-		err = consume_pgps_data(index.dl_pnum, prediction_buf, PGPS_PREDICTION_DL_SIZE);
+		err = consume_pgps_part(part);
 		if (err) {
+			state = PGPS_NONE; /* Fatal error in managing flash storage.
+					    * Allow app to keep running w/o P-GPS.
+					    */
 			return err;
 		}
-		if (len) { /* keep extra data for next time */
-			memcpy(prediction_buf, buf, len);
-		}
-		index.pred_offset = len;
-		index.dl_pnum++;
 	}
-	index.dl_offset += len;
+
 	return 0;
 }
 
@@ -1337,191 +1457,200 @@ static void cache_pgps_header(const struct nrf_cloud_pgps_header *header)
 	index.end_sec = index.start_sec + (int64_t)index.period_sec * index.header.prediction_count;
 }
 
-static size_t get_next_pgps_element(struct nrf_cloud_agnss_element *element, const char *buf)
+static int consume_pgps_head(uint8_t pnum, const struct pgps_prediction_dl_head *head)
 {
-	static uint16_t elements_left_to_process;
-	static enum nrf_cloud_agnss_type element_type;
-	size_t len = 0;
+	static const uint8_t schema = NRF_CLOUD_AGNSS_BIN_SCHEMA_VERSION;
+	const size_t time_len = offsetof(struct pgps_prediction_dl_head, ephemeris_type);
+	int64_t gps_sec;
+	int err;
 
-	/* Check if there are more elements left in the array to process.
-	 * The element type is only given once before the array, and not for
-	 * each element.
-	 */
-	if (elements_left_to_process == 0) {
-		element->type = (enum nrf_cloud_agnss_type)buf[NRF_CLOUD_AGNSS_BIN_TYPE_OFFSET];
-		element_type = element->type;
-		elements_left_to_process = *(uint16_t *)&buf[NRF_CLOUD_AGNSS_BIN_COUNT_OFFSET] - 1;
-		len += NRF_CLOUD_AGNSS_BIN_TYPE_SIZE + NRF_CLOUD_AGNSS_BIN_COUNT_SIZE;
-	} else {
-		element->type = element_type;
-		elements_left_to_process -= 1;
-	}
-
-	switch (element->type) {
-	case NRF_CLOUD_AGNSS_GPS_EPHEMERIDES:
-		element->ephemeris = (struct nrf_cloud_agnss_ephemeris *)(buf + len);
-		len += sizeof(struct nrf_cloud_agnss_ephemeris);
-		break;
-	case NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK:
-		element->time_and_tow = (struct nrf_cloud_agnss_system_time *)(buf + len);
-		len += sizeof(struct nrf_cloud_agnss_system_time) -
-		       sizeof(element->time_and_tow->sv_tow) + 4;
-		break;
-	default:
-		LOG_DBG("Unhandled P-GPS data type:%d", element->type);
+	LOG_DBG("Parsing prediction num:%u, idx:%u, type:%u, count:%u", pnum,
+		index.loading_count, head->time_type, head->time_count);
+
+	if ((head->time_type != NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK) || (head->time_count != 1) ||
+	    (head->ephemeris_type != NRF_CLOUD_AGNSS_GPS_EPHEMERIDES) ||
+	    (head->ephemeris_count != NRF_CLOUD_PGPS_NUM_SV)) {
+		LOG_ERR("Unexpected prediction layout; aborting.");
+		LOG_HEXDUMP_DBG(head, sizeof(*head), "bad data");
+		return -EINVAL;
+	}
+
+	gps_sec = npgps_gps_day_time_to_sec(head->time.date_day, head->time.time_full_s);
+	index.dl_sentinel = (uint32_t)gps_sec;
+	index.skip_prediction = true;
+
+	if (index.predictions[pnum]) {
+		LOG_WRN("Received duplicate packet; ignoring");
+		return 0;
+	} else if (gps_sec == 0) {
+		LOG_ERR("Prediction did not include GPS day and time of day; ignoring");
+		LOG_HEXDUMP_DBG(head, sizeof(*head), "bad data");
 		return 0;
 	}
 
-#if PGPS_DEBUG
-	LOG_DBG("  size:%zd, count:%u", len, elements_left_to_process);
-#endif
-	return len;
+	LOG_INF("Storing prediction num:%u idx:%u for gps sec:%d", pnum, index.loading_count,
+		(int32_t)gps_sec);
+	index.skip_prediction = false;
+	index.dl_crc = 0;
+
+	/* the schema version is not part of the download; insert it after the time */
+	err = store_bytes((const uint8_t *)head, time_len, false);
+	if (!err) {
+		err = store_bytes(&schema, sizeof(schema), false);
+	}
+	if (!err) {
+		err = store_bytes((const uint8_t *)head + time_len, sizeof(*head) - time_len,
+				  false);
+	}
+	return err;
 }
 
-static int consume_pgps_data(uint8_t pnum, const char *buf, size_t buf_len)
+static int consume_pgps_ephemeris(const uint8_t *eph)
 {
-	struct nrf_cloud_agnss_element element = {};
-	uint8_t *prediction_ptr = (uint8_t *)buf;
-	uint8_t *element_ptr = prediction_ptr;
-	struct agnss_header *elem = (struct agnss_header *)element_ptr;
-	size_t parsed_len = 0;
-	int64_t gps_sec;
-	bool finished = false;
-	int err = 0;
+	static const uint8_t empty_health = NRF_CLOUD_PGPS_EMPTY_EPHEM_HEALTH;
+	const size_t health_offset = offsetof(struct nrf_cloud_agnss_ephemeris, health);
+	const size_t len = sizeof(struct nrf_cloud_agnss_ephemeris);
+	int err;
 
-	gps_sec = 0;
+	if (index.skip_prediction) {
+		return 0;
+	}
 
-	LOG_DBG("Parsing prediction num:%u, idx:%u, type:%u, count:%u, buf len:%u", pnum,
-		index.loading_count, elem->type, elem->count, buf_len);
+	/* check for all zeros except first byte (sv_id) */
+	for (int i = 1; i < len; i++) {
+		if (eph[i] != 0) {
+			return store_bytes(eph, len, false);
+		}
+	}
 
-	while (parsed_len < buf_len) {
-		bool empty;
-		size_t element_size = get_next_pgps_element(&element, element_ptr);
+	LOG_DBG("Marking ephemeris:%u as empty", eph[0]);
+	err = store_bytes(eph, health_offset, false);
+	if (!err) {
+		err = store_bytes(&empty_health, sizeof(empty_health), false);
+	}
+	if (!err) {
+		err = store_bytes(eph + health_offset + 1, len - health_offset - 1, false);
+	}
+	return err;
+}
 
-		if (element_size == 0) {
-			LOG_DBG("  End of element");
-			break;
-		}
-		switch (element.type) {
-		case NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK:
-			gps_sec = npgps_gps_day_time_to_sec(element.time_and_tow->date_day,
-							    element.time_and_tow->time_full_s);
-			break;
-		case NRF_CLOUD_AGNSS_GPS_EPHEMERIDES:
-			/* check for all zeros except first byte (sv_id) */
-			empty = true;
-			for (int i = 1; i < sizeof(struct nrf_cloud_agnss_ephemeris); i++) {
-				if (element_ptr[i] != 0) {
-					empty = false;
-					break;
-				}
-			}
-			if (empty) {
-				LOG_DBG("Marking ephemeris:%u as empty", element.ephemeris->sv_id);
-				element.ephemeris->health = NRF_CLOUD_PGPS_EMPTY_EPHEM_HEALTH;
-			}
-			break;
-		default: /* just store */
-			break;
-		}
+static int consume_pgps_part(const uint8_t *part)
+{
+	int err;
 
-		parsed_len += element_size;
-		element_ptr += element_size;
+	if (index.pred_offset == 0) {
+		err = consume_pgps_head(index.dl_pnum,
+					(const struct pgps_prediction_dl_head *)part);
+	} else {
+		err = consume_pgps_ephemeris(part);
+	}
+	if (err) {
+		return err;
 	}
 
-	if (parsed_len == buf_len) {
-		LOG_DBG("Parsing finished");
+	index.pred_offset += dl_part_size();
+	if (index.pred_offset < PGPS_PREDICTION_DL_SIZE) {
+		return 0;
+	}
 
-		if (index.predictions[pnum]) {
-			LOG_WRN("Received duplicate packet; ignoring");
-		} else if (gps_sec == 0) {
-			LOG_ERR("Prediction did not include GPS day and time of day; ignoring");
-			LOG_HEXDUMP_DBG(prediction_ptr, buf_len, "bad data");
-		} else {
-			LOG_INF("Storing prediction num:%u idx:%u for gps sec:%d", pnum,
-				index.loading_count, (int32_t)gps_sec);
+	LOG_DBG("Parsing finished");
+	index.pred_offset = 0;
+	if (index.skip_prediction) {
+		index.dl_pnum++;
+		return 0;
+	}
+	return finish_prediction(index.dl_pnum++);
+}
 
-			index.loading_count++;
-			finished = (index.loading_count == index.expected_count);
-			err = store_prediction(prediction_ptr, buf_len, (uint32_t)gps_sec,
-					       finished || (index.storage_extent == 1));
-			if (err) {
-				LOG_ERR("Error storing prediction:%d", err);
-				goto fail;
-			}
-			index.predictions[pnum] = npgps_block_to_pointer(index.store_block);
+static int finish_prediction(uint8_t pnum)
+{
+	static bool first = true;
+	static uint8_t pad[PGPS_PREDICTION_PAD];
+	bool finished;
+	int err;
 
-			if (!finished) {
-				if (loading_in_progress && !notified && (index.loading_count > 1)) {
-					notified = true;
-					nrf_cloud_pgps_notify_prediction();
-				}
+	if (first) {
+		memset(pad, 0xff, PGPS_PREDICTION_PAD);
+		first = false;
+	}
 
-				if (evt_handler) {
-					struct nrf_cloud_pgps_event evt = {
-						.type = PGPS_EVT_LOADING,
-					};
+	index.loading_count++;
+	finished = (index.loading_count == index.expected_count);
 
-					evt_handler(&evt);
-				}
-			} else {
-				if (loading_in_progress && !notified) {
-					notified = true;
-					nrf_cloud_pgps_notify_prediction();
-				}
+	err = store_bytes((const uint8_t *)&index.dl_sentinel, sizeof(index.dl_sentinel), false);
+	if (!err) {
+		err = stream_flash_buffered_write(&stream, pad, PGPS_PREDICTION_PAD,
+						  finished || (index.storage_extent == 1));
+	}
+	if (err) {
+		LOG_ERR("Error storing prediction:%d", err);
+		return err;
+	}
+	index.crcs[pnum] = index.dl_crc;
+	index.predictions[pnum] = npgps_block_to_pointer(index.store_block);
+	index.verified[pnum] = true;
 
-				LOG_INF("All P-GPS data received. Done.");
-				state = PGPS_READY;
-				if (evt_handler) {
-					struct nrf_cloud_pgps_event evt = {.type = PGPS_EVT_READY,
-									   .prediction = NULL};
+	if (!finished) {
+		if (loading_in_progress && !notified && (index.loading_count > 1)) {
+			notified = true;
+			nrf_cloud_pgps_notify_prediction();
+		}
 
-					evt_handler(&evt);
-				}
-				npgps_print_blocks();
-				return 0;
-			}
+		if (evt_handler) {
+			struct nrf_cloud_pgps_event evt = {
+				.type = PGPS_EVT_LOADING,
+			};
 
-			index.store_block = npgps_alloc_block();
-			if (index.store_block == NO_BLOCK) {
-				LOG_ERR("No more free blocks!");
-				err = -ENOMEM;
-				goto fail;
-			}
-			index.storage_extent--;
-			if (index.storage_extent == 0) {
-				index.storage_extent = npgps_get_block_extent(index.store_block);
-				LOG_DBG("Moving to new flash region:%d, len:%d", index.store_block,
-					index.storage_extent);
-				err = flush_storage();
-				if (err) {
-					LOG_ERR("Error flushing storage:%d", err);
-					goto fail;
-				}
-				err = open_storage(npgps_block_to_offset(index.store_block), false);
-				if (err) {
-					LOG_ERR("Error opening storage again:%d", err);
-					goto fail;
-				}
-			} else if (index.storage_extent < 0) {
-				LOG_ERR("Unexpected storage extent:%d", index.storage_extent);
-				err = -ENOMEM;
-				goto fail;
-			}
+			evt_handler(&evt);
 		}
 	} else {
-		LOG_ERR("Parsing incomplete; aborting.");
-		err = -EINVAL;
-		goto fail;
+		if (loading_in_progress && !notified) {
+			notified = true;
+			nrf_cloud_pgps_notify_prediction();
+		}
+
+		LOG_INF("All P-GPS data received. Done.");
+		err = save_index(index.header.prediction_count);
+		if (err) {
+			LOG_WRN("Error saving P-GPS index:%d", err);
+		}
+		state = PGPS_READY;
+		if (evt_handler) {
+			struct nrf_cloud_pgps_event evt = {.type = PGPS_EVT_READY,
+							   .prediction = NULL};
+
+			evt_handler(&evt);
+		}
+		npgps_print_blocks();
+		return 0;
 	}
 
-	return 0;
+	index.store_block = npgps_alloc_block();
+	if (index.store_block == NO_BLOCK) {
+		LOG_ERR("No more free blocks!");
+		return -ENOMEM;
+	}
+	index.storage_extent--;
+	if (index.storage_extent == 0) {
+		index.storage_extent = npgps_get_block_extent(index.store_block);
+		LOG_DBG("Moving to new flash region:%d, len:%d", index.store_block,
+			index.storage_extent);
+		err = flush_storage();
+		if (err) {
+			LOG_ERR("Error flushing storage:%d", err);
+			return err;
+		}
+		err = open_storage(npgps_block_to_offset(index.store_block), false);
+		if (err) {
+			LOG_ERR("Error opening storage again:%d", err);
+			return err;
+		}
+	} else if (index.storage_extent < 0) {
+		LOG_ERR("Unexpected storage extent:%d", index.storage_extent);
+		return -ENOMEM;
+	}
 
-fail:
-	state = PGPS_NONE; /* Fatal error in managing flash storage.
-			    * Allow app to keep running w/o P-GPS.
-			    */
-	return err;
+	return 0;
 }
 
 int nrf_cloud_pgps_begin_update(void)
@@ -1537,6 +1666,9 @@ int nrf_cloud_pgps_begin_update(void)
 	/* assume cache is no longer valid */
 	discard_prediction_buffer();
 
+	/* the saved index no longer matches flash once new predictions are written */
+	(void)npgps_clear_index();
+
 	index.loading_count = 0;
 	index.store_block = npgps_alloc_block();
 	if (index.store_block == NO_BLOCK) {
@@ -1706,7 +1838,16 @@ int nrf_cloud_pgps_init(struct nrf_cloud_pgps_init_param *param)
 		 * if missing some, get from server
 		 */
 		LOG_INF("Checking stored P-GPS data; count:%u, period_min:%u", count, period_min);
-		num_valid = validate_stored_predictions(&gps_day, &gps_time_of_day);
+		err = load_stored_index(&gps_day, &gps_time_of_day);
+		if (err >= 0) {
+			num_valid = err;
+		} else {
+			num_valid = validate_stored_predictions(&gps_day, &gps_time_of_day);
+			if (num_valid && save_index(num_valid)) {
+				LOG_WRN("Error saving P-GPS index");
+			}
+		}
+		err = 0;
 	}
 
 	struct nrf_cloud_pgps_prediction *found_prediction = NULL;
@@ -25,6 +25,8 @@ LOG_MODULE_DECLARE(nrf_cloud_pgps, CONFIG_NRF_CLOUD_GPS_LOG_LEVEL);
 #define SETTINGS_NAME		  "nrf_cloud_pgps"
 #define SETTINGS_KEY_PGPS_HEADER  "pgps_header"
 #define SETTINGS_FULL_PGPS_HEADER SETTINGS_NAME "/" SETTINGS_KEY_PGPS_HEADER
+#define SETTINGS_KEY_PGPS_INDEX	  "pgps_index"
+#define SETTINGS_FULL_PGPS_INDEX  SETTINGS_NAME "/" SETTINGS_KEY_PGPS_INDEX
 #define SETTINGS_KEY_LOCATION	  "location"
 #define SETTINGS_FULL_LOCATION	  SETTINGS_NAME "/" SETTINGS_KEY_LOCATION
 #define SETTINGS_KEY_LEAP_SEC	  "g2u_leap_sec"
@@ -44,6 +46,7 @@ static int num_blocks;
 static int gps_leap_seconds = GPS_TO_UTC_LEAP_SECONDS;
 static struct gps_location saved_location;
 static struct nrf_cloud_pgps_header saved_header;
+static struct npgps_index_record saved_index;
 
 static K_SEM_DEFINE(dl_active, 1, 1);
 
@@ -82,6 +85,14 @@ static int settings_set(const char *key, size_t len_rd, settings_read_cb read_cb
 			return 0;
 		}
 	}
+	if (!strncmp(key, SETTINGS_KEY_PGPS_INDEX, strlen(SETTINGS_KEY_PGPS_INDEX)) &&
+	    (len_rd == sizeof(saved_index))) {
+		if (read_cb(cb_arg, (void *)&saved_index, len_rd) == len_rd) {
+			LOG_DBG("Read pgps_index: count:%u, gps sec:%d", saved_index.count,
+				(int32_t)saved_index.start_sec);
+			return 0;
+		}
+	}
 	if (!strncmp(key, SETTINGS_KEY_LOCATION, strlen(SETTINGS_KEY_LOCATION)) &&
 	    (len_rd == sizeof(saved_location))) {
 		if (read_cb(cb_arg, (void *)&saved_location, len_rd) == len_rd) {
@@ -132,6 +143,34 @@ const struct nrf_cloud_pgps_header *npgps_get_saved_header(void)
 	return &saved_header;
 }
 
+int npgps_save_index(const struct npgps_index_record *record)
+{
+	int ret;
+
+	LOG_DBG("Saving pgps index");
+	ret = settings_save_one(SETTINGS_FULL_PGPS_INDEX, record, sizeof(*record));
+	if (!ret) {
+		memcpy(&saved_index, record, sizeof(saved_index));
+	}
+	return ret;
+}
+
+int npgps_clear_index(void)
+{
+	if (saved_index.count == 0) {
+		return 0;
+	}
+
+	LOG_DBG("Clearing pgps index");
+	memset(&saved_index, 0, sizeof(saved_index));
+	return settings_delete(SETTINGS_FULL_PGPS_INDEX);
+}
+
+const struct npgps_index_record *npgps_get_saved_index(void)
+{
+	return &saved_index;
+}
+
 /* @TODO: consider rate-limiting these updates to reduce Flash wear */
 static int save_location(void)
 {
@@ -7,8 +7,11 @@
 #ifndef __SETTINGS_ZMS_LEGACY_H_
 #define __SETTINGS_ZMS_LEGACY_H_
 
+#include <zephyr/devicetree.h>
 #include <zephyr/fs/zms.h>
+#include <zephyr/kernel.h>
 #include <zephyr/settings/settings.h>
+#include <zephyr/sys/util.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,10 +29,59 @@ extern "C" {
  * Setting's name entries start from ZMS_NAMECNT_ID + 1.
  * The entry with ID == ZMS_NAMECNT_ID is used to store the largest name ID in use.
  *
+ * The entry with ID == ZMS_TXN_ID is the commit marker of a transaction whose
+ * updates are not all written yet, and stores the length of the transaction
+ * journal kept in the entries starting from ZMS_TXN_DATA_ID.
+ *
  * Deleted records will not be found, only the last record will be read.
  */
 #define ZMS_NAMECNT_ID     0x80000000
 #define ZMS_NAME_ID_OFFSET 0x40000000
+#define ZMS_TXN_ID         (ZMS_NAMECNT_ID - 1)
+#define ZMS_TXN_DATA_ID    (ZMS_NAMECNT_ID - 0x10000)
+
+#if DT_HAS_CHOSEN(zephyr_settings_partition)
+#define SETTINGS_ZMS_PARTITION_NODE DT_CHOSEN(zephyr_settings_partition)
+#else
+#define SETTINGS_ZMS_PARTITION_NODE DT_NODELABEL(storage_partition)
+#endif
+
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE > 0
+#define SETTINGS_ZMS_NAME_CACHE_ENTRIES CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE
+#else
+/* Size of the ZMS settings area, which is at most the size of the settings partition. */
+#define SETTINGS_ZMS_AREA_SIZE                                                                     \
+	MIN(DT_REG_SIZE(SETTINGS_ZMS_PARTITION_NODE),                                              \
+	    CONFIG_SETTINGS_ZMS_SECTOR_COUNT * CONFIG_SETTINGS_ZMS_SECTOR_SIZE_MULT *              \
+		    DT_PROP_OR(DT_GPARENT(SETTINGS_ZMS_PARTITION_NODE), erase_block_size,       \
+			       DT_REG_SIZE(SETTINGS_ZMS_PARTITION_NODE)))
+/* Each setting takes at least two 16-byte ZMS allocation table entries, one for
+ * its name and one for its value, so the cache can hold every stored name.
+ */
+#define SETTINGS_ZMS_NAME_CACHE_ENTRIES (SETTINGS_ZMS_AREA_SIZE / 32)
+#endif
+#define SETTINGS_ZMS_NAME_CACHE_SLOTS                                                              \
+	(SETTINGS_ZMS_NAME_CACHE_ENTRIES + SETTINGS_ZMS_NAME_CACHE_ENTRIES / 2 + 1)
+#endif
+
+#if CONFIG_SETTINGS_ZMS_TXN
+/* Each staged record takes at least five bytes of the transaction buffer, so
+ * the index is never more than 80% full.
+ */
+#define SETTINGS_ZMS_TXN_INDEX_SLOTS (CONFIG_SETTINGS_ZMS_TXN_BUF_SIZE / 4)
+
+/* Header of a record staged in the transaction buffer and journal, followed by
+ * the name, without the terminating '\0', and the value.
+ */
+struct settings_zms_txn_rec {
+	uint16_t name_len;
+	uint16_t val_len;
+};
+
+/* Set in name_len of a record replaced by a later update of the same name. */
+#define SETTINGS_ZMS_TXN_REC_STALE BIT(15)
+#endif
 
 struct settings_zms {
 	struct settings_store cf_store;
@@ -37,14 +89,30 @@ struct settings_zms {
 	uint32_t last_name_id;
 	const struct device *flash_dev;
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
+	/* Open-addressing hash table, kept at most two thirds full. */
 	struct {
 		uint32_t name_hash;
 		uint32_t name_id;
-	} cache[CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE];
+	} cache[SETTINGS_ZMS_NAME_CACHE_SLOTS];
 
-	uint32_t cache_next;
 	uint32_t cache_total;
+	bool cache_ovfl;
 	bool loaded;
+
+	/* Bit n is set if the name ID ZMS_NAMECNT_ID + 1 + n is not in use. */
+	uint32_t free_ids[DIV_ROUND_UP(SETTINGS_ZMS_NAME_CACHE_ENTRIES, 32)];
+	/* A name ID too large for free_ids was freed. */
+	bool free_ids_ovfl;
+#endif
+#if CONFIG_SETTINGS_ZMS_TXN
+	uint8_t txn_buf[CONFIG_SETTINGS_ZMS_TXN_BUF_SIZE];
+	/* Hash index of the staged records by name. */
+	uint16_t txn_index[SETTINGS_ZMS_TXN_INDEX_SLOTS];
+	size_t txn_len;
+	/* Length of the staged records replaced by later updates. */
+	size_t txn_stale_len;
+	k_tid_t txn_owner;
+	bool txn_active;
 #endif
 };
 
@@ -57,6 +125,64 @@ int settings_zms_dst(struct settings_zms *cf);
 /* Initialize a zms backend. */
 int settings_zms_backend_init(struct settings_zms *cf);
 
+/* Read the value of a single setting from the destination zms backend.
+ *
+ * Unlike settings_load_subtree_direct(), the name is looked up through the
+ * name cache instead of iterating over all stored settings.
+ *
+ * Returns the number of bytes read, -ENOENT if the setting does not exist
+ * or another negative error code.
+ */
+ssize_t settings_zms_legacy_load_one(const char *name, void *data, size_t len);
+
+/* Start a settings transaction on the destination zms backend.
+ *
+ * Until the transaction is committed or aborted, settings saved or deleted
+ * by the calling thread are staged in RAM instead of being written to the
+ * storage. Staged updates of the same setting are coalesced, so only the last
+ * one is written.
+ *
+ * The calling thread holds the settings lock for the whole duration of the
+ * transaction, so other threads accessing the settings are blocked until it
+ * ends. Only the calling thread can commit or abort the transaction.
+ *
+ * Returns 0 on success, -EALREADY if a transaction is already in progress
+ * or another negative error code.
+ */
+int settings_zms_legacy_txn_begin(void);
+
+/* Write all updates staged in the current transaction and end it.
+ *
+ * The commit is atomic. The updates are first written to a journal in the
+ * storage and committed by writing a commit marker, so if the commit is
+ * interrupted by a reset before that, none of them are written. Once the
+ * marker is written, the updates that could not be written are written when
+ * the backend is initialized again, see settings_zms_legacy_txn_recover().
+ *
+ * Returns 0 on success, -EINVAL if no transaction is in progress, -EPERM if
+ * the transaction was started by another thread or another negative error
+ * code.
+ */
+int settings_zms_legacy_txn_commit(void);
+
+/* Discard all updates staged in the current transaction and end it.
+ *
+ * Returns 0 on success, -EINVAL if no transaction is in progress, -EPERM if
+ * the transaction was started by another thread or another negative error
+ * code.
+ */
+int settings_zms_legacy_txn_abort(void);
+
+/* Write the updates of a transaction whose commit was interrupted.
+ *
+ * Called when the backend is initialized. If the commit marker is stored, the
+ * updates in the journal are written and the journal is deleted. Otherwise,
+ * a partly written journal is deleted.
+ *
+ * Returns 0 on success or a negative error code.
+ */
+int settings_zms_legacy_txn_recover(struct settings_zms *cf);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,15 +14,12 @@
 
 #include <zephyr/settings/settings.h>
 #include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(settings, CONFIG_SETTINGS_LOG_LEVEL);
 
-#if DT_HAS_CHOSEN(zephyr_settings_partition)
-#define SETTINGS_PARTITION DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_settings_partition))
-#else
-#define SETTINGS_PARTITION FIXED_PARTITION_ID(storage_partition)
-#endif
+#define SETTINGS_PARTITION DT_FIXED_PARTITION_ID(SETTINGS_ZMS_PARTITION_NODE)
 
 struct settings_zms_read_fn_arg {
 	struct zms_fs *fs;
@@ -64,34 +61,132 @@ int settings_zms_dst(struct settings_zms *cf)
 }
 
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
-#define SETTINGS_ZMS_CACHE_OVFL(cf) ((cf)->cache_total > ARRAY_SIZE((cf)->cache))
+/* The name cache is an open-addressing hash table with linear probing that
+ * maps name hashes to name IDs. Once it is filled by settings_zms_load() and
+ * as long as it holds every stored name, a name missing in the cache is also
+ * missing in the storage, so the storage never needs to be scanned. Hash
+ * collisions are resolved by comparing the name read from the storage.
+ */
+#define SETTINGS_ZMS_CACHE_EMPTY 0
+
+static uint32_t settings_zms_name_hash(const char *name)
+{
+	return sys_hash32(name, strnlen(name, SETTINGS_FULL_NAME_LEN));
+}
+
+static bool settings_zms_cache_complete(struct settings_zms *cf)
+{
+	return cf->loaded && !cf->cache_ovfl;
+}
+
+static void settings_zms_free_ids_reset(struct settings_zms *cf)
+{
+	memset(cf->free_ids, 0, sizeof(cf->free_ids));
+	cf->free_ids_ovfl = false;
+}
+
+static void settings_zms_cache_reset(struct settings_zms *cf)
+{
+	memset(cf->cache, 0, sizeof(cf->cache));
+	cf->cache_total = 0;
+	cf->cache_ovfl = false;
+	settings_zms_free_ids_reset(cf);
+}
+
+static void settings_zms_cache_overflow(struct settings_zms *cf)
+{
+	/* The free IDs are only tracked while the cache is complete, as the
+	 * storage scan does not update them.
+	 */
+	cf->cache_ovfl = true;
+	settings_zms_free_ids_reset(cf);
+}
+
+static void settings_zms_cache_add(struct settings_zms *cf, uint32_t name_hash, uint32_t name_id)
+{
+	uint32_t pos;
+
+	if (cf->cache_ovfl) {
+		return;
+	}
+
+	if (cf->cache_total >= SETTINGS_ZMS_NAME_CACHE_ENTRIES) {
+		settings_zms_cache_overflow(cf);
+		return;
+	}
+
+	/* The table is never full, so there always is an empty slot. */
+	pos = name_hash % ARRAY_SIZE(cf->cache);
+	while (cf->cache[pos].name_id != SETTINGS_ZMS_CACHE_EMPTY) {
+		pos = (pos + 1) % ARRAY_SIZE(cf->cache);
+	}
 
-static void settings_zms_cache_add(struct settings_zms *cf, const char *name, uint32_t name_id)
+	cf->cache[pos].name_hash = name_hash;
+	cf->cache[pos].name_id = name_id;
+	cf->cache_total++;
+}
+
+static void settings_zms_cache_remove(struct settings_zms *cf, uint32_t name_hash,
+				      uint32_t name_id)
 {
-	uint32_t name_hash = sys_hash32(name, strnlen(name, SETTINGS_FULL_NAME_LEN));
+	uint32_t pos = name_hash % ARRAY_SIZE(cf->cache);
+	uint32_t next;
 
-	cf->cache[cf->cache_next].name_hash = name_hash;
-	cf->cache[cf->cache_next++].name_id = name_id;
+	while (cf->cache[pos].name_id != name_id) {
+		if (cf->cache[pos].name_id == SETTINGS_ZMS_CACHE_EMPTY) {
+			return;
+		}
 
-	cf->cache_next %= CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE;
+		pos = (pos + 1) % ARRAY_SIZE(cf->cache);
+	}
+
+	cf->cache[pos].name_id = SETTINGS_ZMS_CACHE_EMPTY;
+	cf->cache_total--;
+
+	/* Shift back the following entries of the probe sequence that would
+	 * no longer be reachable from their home slot.
+	 */
+	for (next = (pos + 1) % ARRAY_SIZE(cf->cache);
+	     cf->cache[next].name_id != SETTINGS_ZMS_CACHE_EMPTY;
+	     next = (next + 1) % ARRAY_SIZE(cf->cache)) {
+		uint32_t home = cf->cache[next].name_hash % ARRAY_SIZE(cf->cache);
+		bool reachable;
+
+		if (pos <= next) {
+			reachable = (home > pos) && (home <= next);
+		} else {
+			reachable = (home > pos) || (home <= next);
+		}
+
+		if (!reachable) {
+			cf->cache[pos] = cf->cache[next];
+			cf->cache[next].name_id = SETTINGS_ZMS_CACHE_EMPTY;
+			pos = next;
+		}
+	}
 }
 
-static uint32_t settings_zms_cache_match(struct settings_zms *cf, const char *name, char *rdname,
-					 size_t len)
+static uint32_t settings_zms_cache_match(struct settings_zms *cf, uint32_t name_hash,
+					 const char *name, char *rdname, size_t len)
 {
-	uint32_t name_hash = sys_hash32(name, strnlen(name, SETTINGS_FULL_NAME_LEN));
+	uint32_t pos = name_hash % ARRAY_SIZE(cf->cache);
 	int rc;
 
-	for (int i = 0; i < CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE; i++) {
-		if (cf->cache[i].name_hash != name_hash) {
-			continue;
+	for (size_t i = 0; i < ARRAY_SIZE(cf->cache); i++) {
+		uint32_t name_id = cf->cache[pos].name_id;
+		bool hash_match = (cf->cache[pos].name_hash == name_hash);
+
+		if (name_id == SETTINGS_ZMS_CACHE_EMPTY) {
+			break;
 		}
 
-		if (cf->cache[i].name_id <= ZMS_NAMECNT_ID) {
+		pos = (pos + 1) % ARRAY_SIZE(cf->cache);
+
+		if (!hash_match) {
 			continue;
 		}
 
-		rc = zms_read(&cf->cf_zms, cf->cache[i].name_id, rdname, len);
+		rc = zms_read(&cf->cf_zms, name_id, rdname, len);
 		if (rc < 0) {
 			continue;
 		}
@@ -102,13 +197,144 @@ static uint32_t settings_zms_cache_match(struct settings_zms *cf, const char *na
 			continue;
 		}
 
-		return cf->cache[i].name_id;
+		return name_id;
 	}
 
 	return ZMS_NAMECNT_ID;
 }
+
+static void settings_zms_free_id_push(struct settings_zms *cf, uint32_t name_id)
+{
+	uint32_t bit = name_id - ZMS_NAMECNT_ID - 1;
+
+	if (cf->cache_ovfl) {
+		return;
+	}
+
+	if (bit < SETTINGS_ZMS_NAME_CACHE_ENTRIES) {
+		cf->free_ids[bit / 32] |= BIT(bit % 32);
+	} else {
+		cf->free_ids_ovfl = true;
+	}
+}
+
+static void settings_zms_free_id_remove(struct settings_zms *cf, uint32_t name_id)
+{
+	uint32_t bit = name_id - ZMS_NAMECNT_ID - 1;
+
+	if (bit < SETTINGS_ZMS_NAME_CACHE_ENTRIES) {
+		cf->free_ids[bit / 32] &= ~BIT(bit % 32);
+	}
+}
+
+/* Returns the lowest name ID that is not in use. The ID stays free until a
+ * setting is written to it.
+ */
+static uint32_t settings_zms_free_id_get(struct settings_zms *cf)
+{
+	uint32_t name_id;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cf->free_ids); i++) {
+		if (cf->free_ids[i] == 0) {
+			continue;
+		}
+
+		name_id = ZMS_NAMECNT_ID + 1 + i * 32 + u32_count_trailing_zeros(cf->free_ids[i]);
+
+		/* IDs above the largest one in use are allocated anyway. */
+		if (name_id <= cf->last_name_id) {
+			return name_id;
+		}
+
+		break;
+	}
+
+	/* Name IDs that do not fit in free_ids are only found in the storage. */
+	if (cf->free_ids_ovfl) {
+		for (name_id = ZMS_NAMECNT_ID + 1 + SETTINGS_ZMS_NAME_CACHE_ENTRIES;
+		     name_id < cf->last_name_id; name_id++) {
+			if (zms_get_data_length(&cf->cf_zms, name_id) == -ENOENT) {
+				return name_id;
+			}
+		}
+
+		cf->free_ids_ovfl = false;
+	}
+
+	return cf->last_name_id + 1;
+}
 #endif /* CONFIG_SETTINGS_ZMS_NAME_CACHE */
 
+/* Returns the ID of the name entry matching name or ZMS_NAMECNT_ID if not found. */
+static uint32_t settings_zms_name_find(struct settings_zms *cf, const char *name, char *rdname,
+				       size_t len)
+{
+	uint32_t name_id;
+	int rc;
+
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+	name_id = settings_zms_cache_match(cf, settings_zms_name_hash(name), name, rdname, len);
+	if (name_id != ZMS_NAMECNT_ID) {
+		return name_id;
+	}
+
+	/* We can skip reading ZMS if we know that the cache holds every name. */
+	if (settings_zms_cache_complete(cf)) {
+		return ZMS_NAMECNT_ID;
+	}
+#endif
+
+	for (name_id = cf->last_name_id; name_id > ZMS_NAMECNT_ID; name_id--) {
+		rc = zms_read(&cf->cf_zms, name_id, rdname, len);
+		if (rc < 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (!strcmp(name, rdname)) {
+			return name_id;
+		}
+	}
+
+	return ZMS_NAMECNT_ID;
+}
+
+ssize_t settings_zms_legacy_load_one(const char *name, void *data, size_t len)
+{
+	struct settings_zms *cf;
+	char rdname[SETTINGS_FULL_NAME_LEN];
+	struct zms_fs *fs;
+	uint32_t name_id;
+	ssize_t rc;
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+	settings_lock_take();
+
+	rc = settings_storage_get((void **)&fs);
+	if (rc) {
+		goto out;
+	}
+
+	cf = CONTAINER_OF(fs, struct settings_zms, cf_zms);
+
+	name_id = settings_zms_name_find(cf, name, rdname, sizeof(rdname));
+	if (name_id == ZMS_NAMECNT_ID) {
+		rc = -ENOENT;
+		goto out;
+	}
+
+	rc = zms_read(&cf->cf_zms, name_id + ZMS_NAME_ID_OFFSET, data, len);
+
+out:
+	settings_lock_release();
+
+	return rc;
+}
+
 static int settings_zms_load(struct settings_store *cs, const struct settings_load_arg *arg)
 {
 	int ret = 0;
@@ -119,9 +345,15 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 	uint32_t name_id = ZMS_NAMECNT_ID;
 
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
-	uint32_t cached = 0;
-
-	cf->loaded = false;
+	/* Saves and deletes keep a complete cache up to date, so it is only
+	 * built by the first load that goes through all stored names.
+	 */
+	bool cache_build = !settings_zms_cache_complete(cf);
+
+	if (cache_build) {
+		cf->loaded = false;
+		settings_zms_cache_reset(cf);
+	}
 #endif
 
 	name_id = cf->last_name_id + 1;
@@ -131,8 +363,9 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 		name_id--;
 		if (name_id == ZMS_NAMECNT_ID) {
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
-			cf->loaded = true;
-			cf->cache_total = cached;
+			if (cache_build) {
+				cf->loaded = true;
+			}
 #endif
 			break;
 		}
@@ -156,6 +389,11 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 				zms_write(&cf->cf_zms, ZMS_NAMECNT_ID, &cf->last_name_id,
 					  sizeof(uint32_t));
 			}
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+			else {
+				settings_zms_free_id_push(cf, name_id);
+			}
+#endif
 
 			continue;
 		}
@@ -169,11 +407,23 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 			zms_delete(&cf->cf_zms, name_id);
 			zms_delete(&cf->cf_zms, name_id + ZMS_NAME_ID_OFFSET);
 
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+			if (!cache_build && (rc1 > 0)) {
+				name[rc1] = '\0';
+				settings_zms_cache_remove(cf, settings_zms_name_hash(name), name_id);
+			}
+#endif
+
 			if (name_id == cf->last_name_id) {
 				cf->last_name_id--;
 				zms_write(&cf->cf_zms, ZMS_NAMECNT_ID, &cf->last_name_id,
 					  sizeof(uint32_t));
 			}
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+			else {
+				settings_zms_free_id_push(cf, name_id);
+			}
+#endif
 
 			continue;
 		}
@@ -184,8 +434,9 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 		read_fn_arg.id = name_id + ZMS_NAME_ID_OFFSET;
 
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
-		settings_zms_cache_add(cf, name, name_id);
-		cached++;
+		if (cache_build) {
+			settings_zms_cache_add(cf, settings_zms_name_hash(name), name_id);
+		}
 #endif
 
 		ret = settings_call_set_handler(name, rc2, settings_zms_read_fn, &read_fn_arg,
@@ -197,10 +448,9 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 	return ret;
 }
 
-static int settings_zms_save(struct settings_store *cs, const char *name, const char *value,
-			     size_t val_len)
+static int settings_zms_save_entry(struct settings_zms *cf, const char *name, const char *value,
+				   size_t val_len)
 {
-	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
 	char rdname[SETTINGS_FULL_NAME_LEN];
 	uint32_t name_id, write_name_id;
 	bool delete, write_name;
@@ -214,15 +464,26 @@ static int settings_zms_save(struct settings_store *cs, const char *name, const
 	delete = ((value == NULL) || (val_len == 0));
 
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
+	uint32_t name_hash = settings_zms_name_hash(name);
 	bool name_in_cache = false;
 
-	name_id = settings_zms_cache_match(cf, name, rdname, sizeof(rdname));
+	name_id = settings_zms_cache_match(cf, name_hash, name, rdname, sizeof(rdname));
 	if (name_id != ZMS_NAMECNT_ID) {
 		write_name_id = name_id;
 		write_name = false;
 		name_in_cache = true;
 		goto found;
 	}
+
+	/* We can skip reading ZMS if we know that the cache holds every name:
+	 * the name is not stored yet and any free ID can be used for it.
+	 */
+	if (settings_zms_cache_complete(cf)) {
+		name_id = ZMS_NAMECNT_ID;
+		write_name_id = delete ? ZMS_NAMECNT_ID : settings_zms_free_id_get(cf);
+		write_name = true;
+		goto found;
+	}
 #endif
 
 	/* No entry with "name" is in cache, let's find if it exists in the storage */
@@ -230,13 +491,6 @@ static int settings_zms_save(struct settings_store *cs, const char *name, const
 	write_name_id = cf->last_name_id + 1;
 	write_name = true;
 
-#if CONFIG_SETTINGS_ZMS_NAME_CACHE
-	/* We can skip reading ZMS if we know that the cache wasn't overflowed. */
-	if (cf->loaded && !SETTINGS_ZMS_CACHE_OVFL(cf)) {
-		goto found;
-	}
-#endif
-
 	/* Let's find if we already have an ID within storage */
 	while (1) {
 		name_id--;
@@ -288,6 +542,16 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+		if (name_in_cache) {
+			settings_zms_cache_remove(cf, name_hash, name_id);
+		}
+
+		if (name_id != cf->last_name_id) {
+			settings_zms_free_id_push(cf, name_id);
+		}
+#endif
+
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
 			rc = zms_write(&cf->cf_zms, ZMS_NAMECNT_ID, &cf->last_name_id,
@@ -334,16 +598,445 @@ found:
 
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
 	if (!name_in_cache) {
-		settings_zms_cache_add(cf, name, write_name_id);
-		if (cf->loaded && !SETTINGS_ZMS_CACHE_OVFL(cf)) {
-			cf->cache_total++;
-		}
+		settings_zms_free_id_remove(cf, write_name_id);
+		settings_zms_cache_add(cf, name_hash, write_name_id);
 	}
 #endif
 
 	return 0;
 }
 
+#if CONFIG_SETTINGS_ZMS_TXN
+/* Staged updates are stored back to back in the transaction buffer, each as a
+ * record header followed by the name (without the terminating '\0') and the
+ * value. A record with an empty value is a delete. A record replaced by a later
+ * update of the same name is marked as stale, and the stale records are removed
+ * when the buffer is full and before the transaction is committed.
+ *
+ * On commit, the records are first written to a journal of ZMS entries
+ * starting from ZMS_TXN_DATA_ID, followed by the ZMS_TXN_ID commit marker that
+ * holds the length of the records. Only then are the settings entries written.
+ * The journal is deleted once all of them are written, and replayed when the
+ * backend is initialized if it is still there, so either all updates of a
+ * transaction are written or none of them.
+ *
+ * The index is an open-addressing hash table with linear probing that maps
+ * each staged name to the offset of its latest record plus one, zero marking
+ * an empty slot.
+ */
+static size_t settings_zms_txn_rec_len(const struct settings_zms_txn_rec *rec)
+{
+	return sizeof(*rec) + (rec->name_len & ~SETTINGS_ZMS_TXN_REC_STALE) + rec->val_len;
+}
+
+/* Returns the index slot of the record staged for name, or the empty slot for
+ * it if it is not staged.
+ */
+static uint16_t *settings_zms_txn_slot(struct settings_zms *cf, const char *name,
+				       size_t name_len)
+{
+	struct settings_zms_txn_rec rec;
+	size_t slot = sys_hash32(name, name_len) % ARRAY_SIZE(cf->txn_index);
+	size_t off;
+
+	while (cf->txn_index[slot] != 0) {
+		off = cf->txn_index[slot] - 1;
+		memcpy(&rec, &cf->txn_buf[off], sizeof(rec));
+
+		if ((rec.name_len == name_len) &&
+		    !memcmp(&cf->txn_buf[off + sizeof(rec)], name, name_len)) {
+			break;
+		}
+
+		slot = (slot + 1) % ARRAY_SIZE(cf->txn_index);
+	}
+
+	return &cf->txn_index[slot];
+}
+
+/* Removes the stale records from the transaction buffer and rebuilds the index. */
+static void settings_zms_txn_compact(struct settings_zms *cf)
+{
+	struct settings_zms_txn_rec rec;
+	size_t off = 0;
+	size_t len = 0;
+	size_t rec_len;
+
+	memset(cf->txn_index, 0, sizeof(cf->txn_index));
+
+	while (off < cf->txn_len) {
+		memcpy(&rec, &cf->txn_buf[off], sizeof(rec));
+		rec_len = settings_zms_txn_rec_len(&rec);
+
+		if (!(rec.name_len & SETTINGS_ZMS_TXN_REC_STALE)) {
+			memmove(&cf->txn_buf[len], &cf->txn_buf[off], rec_len);
+			*settings_zms_txn_slot(cf, (const char *)&cf->txn_buf[len + sizeof(rec)],
+					       rec.name_len) = len + 1;
+			len += rec_len;
+		}
+
+		off += rec_len;
+	}
+
+	cf->txn_len = len;
+	cf->txn_stale_len = 0;
+}
+
+static int settings_zms_txn_stage(struct settings_zms *cf, const char *name, const char *value,
+				  size_t val_len)
+{
+	struct settings_zms_txn_rec rec, old;
+	size_t name_len = strnlen(name, SETTINGS_FULL_NAME_LEN);
+	size_t old_len = 0;
+	size_t off;
+	uint16_t *slot;
+
+	if (value == NULL) {
+		val_len = 0;
+	}
+
+	if (val_len > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	rec.name_len = name_len;
+	rec.val_len = val_len;
+
+	slot = settings_zms_txn_slot(cf, name, name_len);
+	if (*slot != 0) {
+		memcpy(&old, &cf->txn_buf[*slot - 1], sizeof(old));
+		old_len = settings_zms_txn_rec_len(&old);
+	}
+
+	if (cf->txn_len - cf->txn_stale_len - old_len + settings_zms_txn_rec_len(&rec) >
+	    sizeof(cf->txn_buf)) {
+		return -ENOMEM;
+	}
+
+	/* A later update of the same name replaces the staged one. */
+	if (old_len) {
+		old.name_len |= SETTINGS_ZMS_TXN_REC_STALE;
+		memcpy(&cf->txn_buf[*slot - 1], &old, sizeof(old));
+		cf->txn_stale_len += old_len;
+	}
+
+	if (cf->txn_len + settings_zms_txn_rec_len(&rec) > sizeof(cf->txn_buf)) {
+		settings_zms_txn_compact(cf);
+		slot = settings_zms_txn_slot(cf, name, name_len);
+	}
+
+	off = cf->txn_len;
+	*slot = off + 1;
+	memcpy(&cf->txn_buf[off], &rec, sizeof(rec));
+	off += sizeof(rec);
+	memcpy(&cf->txn_buf[off], name, name_len);
+	off += name_len;
+	if (val_len) {
+		memcpy(&cf->txn_buf[off], value, val_len);
+		off += val_len;
+	}
+	cf->txn_len = off;
+
+	return 0;
+}
+
+/* Writes the staged records, which are known not to be stale. */
+static int settings_zms_txn_apply(struct settings_zms *cf)
+{
+	char name[SETTINGS_FULL_NAME_LEN + 1];
+	struct settings_zms_txn_rec rec;
+	size_t off = 0;
+	int rc;
+
+	for (; off < cf->txn_len; off += settings_zms_txn_rec_len(&rec)) {
+		memcpy(&rec, &cf->txn_buf[off], sizeof(rec));
+		memcpy(name, &cf->txn_buf[off + sizeof(rec)], rec.name_len);
+		name[rec.name_len] = '\0';
+
+		rc = settings_zms_save_entry(cf, name,
+					     &cf->txn_buf[off + sizeof(rec) + rec.name_len],
+					     rec.val_len);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+/* Deletes the journal chunks, the last one first, so that the chunks left
+ * after a reset always start from the first one.
+ */
+static void settings_zms_txn_journal_delete(struct settings_zms *cf, uint32_t chunk_cnt)
+{
+	while (chunk_cnt > 0) {
+		chunk_cnt--;
+		(void)zms_delete(&cf->cf_zms, ZMS_TXN_DATA_ID + chunk_cnt);
+	}
+}
+
+/* Writes the staged records to the journal and then the commit marker. Once
+ * the marker is written, the transaction is committed: if the records are not
+ * all written to the settings entries, they are written again by
+ * settings_zms_legacy_txn_recover() after a reset.
+ */
+static int settings_zms_txn_journal_write(struct settings_zms *cf, uint32_t *chunk_cnt)
+{
+	/* Well below the largest ZMS entry, which must fit in a sector */
+	size_t chunk_len = cf->cf_zms.sector_size / 4;
+	uint32_t txn_len = cf->txn_len;
+	size_t off = 0;
+	ssize_t rc;
+
+	*chunk_cnt = 0;
+
+	while (off < cf->txn_len) {
+		size_t len = MIN(chunk_len, cf->txn_len - off);
+
+		rc = zms_write(&cf->cf_zms, ZMS_TXN_DATA_ID + *chunk_cnt, &cf->txn_buf[off], len);
+		(*chunk_cnt)++;
+		if (rc < 0) {
+			return rc;
+		}
+
+		off += len;
+	}
+
+	rc = zms_write(&cf->cf_zms, ZMS_TXN_ID, &txn_len, sizeof(txn_len));
+
+	return (rc < 0) ? rc : 0;
+}
+
+static int settings_zms_txn_commit(struct settings_zms *cf)
+{
+	uint32_t chunk_cnt;
+	int rc;
+
+	/* Only the latest update of each setting is journaled and written */
+	settings_zms_txn_compact(cf);
+	if (cf->txn_len == 0) {
+		return 0;
+	}
+
+	rc = settings_zms_txn_journal_write(cf, &chunk_cnt);
+	if (rc < 0) {
+		/* Nothing was committed */
+		settings_zms_txn_journal_delete(cf, chunk_cnt);
+		return rc;
+	}
+
+	rc = settings_zms_txn_apply(cf);
+	if (rc < 0) {
+		/* The journal is kept and written again after a reset */
+		LOG_ERR("Committed transaction not fully written (err %d)", rc);
+		return rc;
+	}
+
+	rc = zms_delete(&cf->cf_zms, ZMS_TXN_ID);
+	settings_zms_txn_journal_delete(cf, chunk_cnt);
+
+	return rc;
+}
+
+/* Checks that the journal read to the transaction buffer holds whole records. */
+static bool settings_zms_txn_journal_valid(struct settings_zms *cf)
+{
+	struct settings_zms_txn_rec rec;
+	size_t off = 0;
+
+	while (cf->txn_len - off >= sizeof(rec)) {
+		memcpy(&rec, &cf->txn_buf[off], sizeof(rec));
+		if (rec.name_len > SETTINGS_FULL_NAME_LEN) {
+			return false;
+		}
+
+		off += settings_zms_txn_rec_len(&rec);
+		if (off > cf->txn_len) {
+			return false;
+		}
+	}
+
+	return off == cf->txn_len;
+}
+
+int settings_zms_legacy_txn_recover(struct settings_zms *cf)
+{
+	uint32_t chunk_cnt = 0;
+	uint32_t txn_len;
+	size_t off = 0;
+	ssize_t rc;
+
+	rc = zms_read(&cf->cf_zms, ZMS_TXN_ID, &txn_len, sizeof(txn_len));
+	if (rc != sizeof(txn_len)) {
+		/* No transaction was committed, discard a partly written journal */
+		while (zms_get_data_length(&cf->cf_zms, ZMS_TXN_DATA_ID + chunk_cnt) > 0) {
+			chunk_cnt++;
+		}
+
+		settings_zms_txn_journal_delete(cf, chunk_cnt);
+
+		return 0;
+	}
+
+	if (txn_len > sizeof(cf->txn_buf)) {
+		LOG_ERR("Committed transaction of %u bytes too large, discarded", txn_len);
+		goto discard;
+	}
+
+	while (off < txn_len) {
+		rc = zms_read(&cf->cf_zms, ZMS_TXN_DATA_ID + chunk_cnt, &cf->txn_buf[off],
+			      txn_len - off);
+		if (rc <= 0 || (size_t)rc > txn_len - off) {
+			LOG_ERR("Committed transaction journal corrupted, discarded");
+			goto discard;
+		}
+
+		off += rc;
+		chunk_cnt++;
+	}
+
+	cf->txn_len = txn_len;
+	if (!settings_zms_txn_journal_valid(cf)) {
+		cf->txn_len = 0;
+		LOG_ERR("Committed transaction journal corrupted, discarded");
+		goto discard;
+	}
+
+	LOG_DBG("Writing committed transaction of %u bytes", txn_len);
+
+	rc = settings_zms_txn_apply(cf);
+	cf->txn_len = 0;
+
+	if (rc < 0) {
+		/* The journal is kept and written again at the next init */
+		return rc;
+	}
+
+discard:
+	rc = zms_delete(&cf->cf_zms, ZMS_TXN_ID);
+	if (rc < 0) {
+		return rc;
+	}
+
+	/* Without the marker, the journal left after a reset here is discarded */
+	while (zms_get_data_length(&cf->cf_zms, ZMS_TXN_DATA_ID + chunk_cnt) > 0) {
+		chunk_cnt++;
+	}
+
+	settings_zms_txn_journal_delete(cf, chunk_cnt);
+
+	return 0;
+}
+
+static int settings_zms_txn_get(struct settings_zms **cf)
+{
+	struct zms_fs *fs;
+	int rc;
+
+	rc = settings_storage_get((void **)&fs);
+	if (rc) {
+		return rc;
+	}
+
+	*cf = CONTAINER_OF(fs, struct settings_zms, cf_zms);
+
+	return 0;
+}
+
+int settings_zms_legacy_txn_begin(void)
+{
+	struct settings_zms *cf;
+	int rc;
+
+	settings_lock_take();
+
+	rc = settings_zms_txn_get(&cf);
+	if (!rc && cf->txn_active) {
+		rc = -EALREADY;
+	}
+
+	if (rc) {
+		settings_lock_release();
+		return rc;
+	}
+
+	/* The settings lock is held by the calling thread until it commits or
+	 * aborts the transaction.
+	 */
+	cf->txn_active = true;
+	cf->txn_owner = k_current_get();
+	cf->txn_len = 0;
+	cf->txn_stale_len = 0;
+	memset(cf->txn_index, 0, sizeof(cf->txn_index));
+
+	return 0;
+}
+
+static int settings_zms_txn_end(bool commit)
+{
+	struct settings_zms *cf;
+	int rc;
+
+	rc = settings_zms_txn_get(&cf);
+	if (rc) {
+		return rc;
+	}
+
+	/* Only the owner can take the settings lock while the transaction is
+	 * in progress, and no other thread ever sees its own ID in txn_owner.
+	 */
+	if (cf->txn_owner != k_current_get()) {
+		return (cf->txn_owner == NULL) ? -EINVAL : -EPERM;
+	}
+
+	settings_lock_take();
+
+	if (commit) {
+		rc = settings_zms_txn_commit(cf);
+	}
+
+	cf->txn_active = false;
+	cf->txn_owner = NULL;
+	cf->txn_len = 0;
+
+	/* Release the lock taken here and the one taken by
+	 * settings_zms_legacy_txn_begin().
+	 */
+	settings_lock_release();
+	settings_lock_release();
+
+	return rc;
+}
+
+int settings_zms_legacy_txn_commit(void)
+{
+	return settings_zms_txn_end(true);
+}
+
+int settings_zms_legacy_txn_abort(void)
+{
+	return settings_zms_txn_end(false);
+}
+#endif /* CONFIG_SETTINGS_ZMS_TXN */
+
+static int settings_zms_save(struct settings_store *cs, const char *name, const char *value,
+			     size_t val_len)
+{
+	struct settings_zms *cf = CONTAINER_OF(cs, struct settings_zms, cf_store);
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+#if CONFIG_SETTINGS_ZMS_TXN
+	if (cf->txn_active) {
+		return settings_zms_txn_stage(cf, name, value, val_len);
+	}
+#endif
+
+	return settings_zms_save_entry(cf, name, value, val_len);
+}
+
 /* Initialize the zms backend. */
 int settings_zms_backend_init(struct settings_zms *cf)
 {
@@ -367,6 +1060,19 @@ int settings_zms_backend_init(struct settings_zms *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+#if CONFIG_SETTINGS_ZMS_TXN
+	/* Complete a transaction whose commit was interrupted by a reset before
+	 * the settings are read.
+	 */
+	rc = settings_zms_legacy_txn_recover(cf);
+	if (rc) {
+		/* The settings are still usable, the journal is kept and written
+		 * again at the next init.
+		 */
+		LOG_ERR("Committed transaction not fully written (err %d)", rc);
+	}
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
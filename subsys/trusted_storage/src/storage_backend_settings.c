@@ -12,6 +12,10 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/settings/settings.h>
 
+#if defined(CONFIG_SETTINGS_ZMS_LEGACY)
+#include <settings/settings_zms_legacy.h>
+#endif
+
 #include "storage_backend.h"
 
 LOG_MODULE_REGISTER(internal_trusted_storage_settings, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
@@ -47,6 +51,7 @@ static psa_status_t create_filename(char *filename, const size_t filename_size,
 	return PSA_SUCCESS;
 }
 
+#if !defined(CONFIG_SETTINGS_ZMS_LEGACY)
 /*
  * Reads the object content up to the size of object.
  */
@@ -63,6 +68,7 @@ static int storage_settings_load_object(const char *key, size_t len, settings_re
 	 */
 	return info->ret;
 }
+#endif
 
 static psa_status_t error_to_psa_error(int errorno)
 {
@@ -100,12 +106,18 @@ psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix,
 		return status;
 	}
 
+#if defined(CONFIG_SETTINGS_ZMS_LEGACY)
+	/* Look up the object directly instead of iterating over all settings */
+	info.ret = settings_zms_legacy_load_one(path, object_data, object_size);
+	ret = 0;
+#else
 	info.data = object_data;
 	info.size = object_size;
 	/* Set a fallback error if storage_settings_load_object isn't called */
 	info.ret = -ENOENT;
 
 	ret = settings_load_subtree_direct(path, storage_settings_load_object, &info);
+#endif
 
 	LOG_DBG("Get object with filename %s (max_size: %zd), ret: %d", path, object_size,
 		info.ret);
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <emds/emds.h>
+
+#define STORE_ROUNDS 8
+
+/* Word-aligned entries are written directly from their memory, while the
+ * unaligned one goes through the chunk buffer.
+ */
+static uint8_t aligned_data[1024] __aligned(4);
+static uint8_t small_data[16] __aligned(4);
+static uint8_t unaligned_buf[336] __aligned(4);
+
+EMDS_STATIC_ENTRY_DEFINE(aligned_entry, 0x100, aligned_data, sizeof(aligned_data));
+
+static struct emds_dynamic_entry d_entries[] = {
+	{{0x1001, small_data, sizeof(small_data)}},
+	{{0x1002, &unaligned_buf[1], sizeof(unaligned_buf) - 3}},
+};
+
+static void data_update(uint8_t round)
+{
+	memset(aligned_data, round, sizeof(aligned_data));
+	memset(small_data, round + 1, sizeof(small_data));
+	memset(unaligned_buf, round + 2, sizeof(unaligned_buf));
+}
+
+static void *emds_store_setup(void)
+{
+	zassert_ok(emds_init(NULL), "Initializing failed");
+
+	for (int i = 0; i < ARRAY_SIZE(d_entries); i++) {
+		zassert_ok(emds_entry_add(&d_entries[i]), "Adding entry %d failed", i);
+	}
+
+	zassert_ok(emds_clear(), "Clearing failed");
+
+	return NULL;
+}
+
+ZTEST(emds_store, test_store_throughput)
+{
+	uint64_t total_us = 0;
+	uint64_t throughput;
+	uint32_t estimate_us;
+	size_t store_size;
+	uint32_t start;
+	uint32_t store_us;
+	int err;
+
+	zassert_ok(emds_store_size_get(&store_size), "Getting store size failed");
+
+	for (uint8_t round = 0; round < STORE_ROUNDS; round++) {
+		err = emds_load();
+		zassert_true(err == 0 || err == -ENOENT, "Load failed: %d", err);
+
+		if (round > 0) {
+			zassert_equal(aligned_data[0], round - 1, "Unexpected data loaded");
+			zassert_equal(unaligned_buf[1], (uint8_t)(round + 1),
+				      "Unexpected data loaded");
+		}
+
+		zassert_ok(emds_prepare(), "Prepare failed");
+
+		data_update(round);
+
+		start = k_cycle_get_32();
+		zassert_ok(emds_store(), "Store failed");
+		store_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+
+		zassert_ok(emds_store_time_get(&estimate_us), "Getting store time failed");
+		zassert_true(store_us < estimate_us, "Store took %uus, estimate is %uus",
+			     store_us, estimate_us);
+
+		total_us += store_us;
+	}
+
+	/* Throughput in thousandths of a byte per microsecond */
+	throughput = (store_size * STORE_ROUNDS * 1000ULL) / total_us;
+
+	TC_PRINT("Stored %zu bytes in %llu us on average: %llu.%03llu bytes/us\n", store_size,
+		 total_us / STORE_ROUNDS, throughput / 1000, throughput % 1000);
+}
+
+ZTEST_SUITE(emds_store, NULL, emds_store_setup, NULL, NULL, NULL);
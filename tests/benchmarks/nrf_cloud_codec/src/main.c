@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <net/nrf_cloud_codec.h>
+#include <net/nrf_cloud_os.h>
+
+#define ENCODE_ROUNDS 32
+#define MSG_BUF_SIZE 512
+#define MSG_TS 1700000000123LL
+
+/* Each allocation is prefixed with its size so that the hooks can track heap usage */
+struct alloc_hdr {
+	size_t size;
+} __aligned(8);
+
+static size_t heap_used;
+static size_t heap_peak;
+
+static uint8_t msg_buf[MSG_BUF_SIZE];
+static char json_msg[MSG_BUF_SIZE];
+
+static void *counting_malloc(size_t size)
+{
+	struct alloc_hdr *hdr = k_malloc(sizeof(*hdr) + size);
+
+	if (!hdr) {
+		return NULL;
+	}
+
+	hdr->size = size;
+	heap_used += size;
+	heap_peak = MAX(heap_peak, heap_used);
+
+	return hdr + 1;
+}
+
+static void *counting_calloc(size_t count, size_t size)
+{
+	void *ptr = counting_malloc(count * size);
+
+	if (ptr) {
+		memset(ptr, 0, count * size);
+	}
+
+	return ptr;
+}
+
+static void counting_free(void *ptr)
+{
+	struct alloc_hdr *hdr;
+
+	if (!ptr) {
+		return;
+	}
+
+	hdr = (struct alloc_hdr *)ptr - 1;
+	heap_used -= hdr->size;
+	k_free(hdr);
+}
+
+/* A GNSS fix with a few sensor readings, like the asset tracker sends periodically */
+static int msg_build(struct nrf_cloud_obj *const obj)
+{
+	static const uint32_t cells[] = { 21655, 21656, 21658 };
+	int err;
+
+	err = nrf_cloud_obj_msg_init(obj, NRF_CLOUD_JSON_APPID_VAL_GNSS,
+				     NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+	err = err ? err : nrf_cloud_obj_ts_add(obj, MSG_TS);
+	err = err ? err : nrf_cloud_obj_num_add(obj, "lat", 63.421218, true);
+	err = err ? err : nrf_cloud_obj_num_add(obj, "lon", 10.437378, true);
+	err = err ? err : nrf_cloud_obj_num_add(obj, "acc", 12.5, true);
+	err = err ? err : nrf_cloud_obj_num_add(obj, "alt", 48.25, true);
+	err = err ? err : nrf_cloud_obj_num_add(obj, "spd", 0.3, true);
+	err = err ? err : nrf_cloud_obj_num_add(obj, "hdg", 271, true);
+	err = err ? err : nrf_cloud_obj_num_add(obj, "temp", 21.7, true);
+	err = err ? err : nrf_cloud_obj_num_add(obj, "hum", 44, true);
+	err = err ? err : nrf_cloud_obj_bool_add(obj, "moving", false, true);
+	err = err ? err : nrf_cloud_obj_str_add(obj, "fw", "v1.2.3", true);
+	err = err ? err : nrf_cloud_obj_int_array_add(obj, "cells", cells, ARRAY_SIZE(cells),
+						      true);
+
+	return err;
+}
+
+/* The same fix in the CoAP message_out schema, the only one CBOR streams can encode */
+static int pvt_msg_build(struct nrf_cloud_obj *const obj)
+{
+	static const struct nrf_cloud_gnss_pvt pvt = {
+		.lat = 63.421218,
+		.lon = 10.437378,
+		.accuracy = 12.5f,
+		.alt = 48.25f,
+		.has_alt = true,
+		.speed = 0.3f,
+		.has_speed = true,
+		.heading = 271.0f,
+		.has_heading = true,
+	};
+	int err;
+
+	err = nrf_cloud_obj_msg_init(obj, NRF_CLOUD_JSON_APPID_VAL_GNSS, NULL);
+	err = err ? err : nrf_cloud_obj_ts_add(obj, MSG_TS);
+	err = err ? err : nrf_cloud_obj_pvt_add(obj, &pvt);
+
+	return err;
+}
+
+static void encode_run(const char *label, struct nrf_cloud_obj *const obj,
+		       int (*build)(struct nrf_cloud_obj *const obj))
+{
+	uint32_t cycles = 0;
+	uint32_t start;
+	size_t len = 0;
+
+	heap_used = 0;
+	heap_peak = 0;
+
+	for (int i = 0; i < ENCODE_ROUNDS; i++) {
+		start = k_cycle_get_32();
+		zassert_ok(build(obj), "Building %s message failed", label);
+		zassert_ok(nrf_cloud_obj_cloud_encode(obj), "Encoding %s message failed", label);
+		cycles += k_cycle_get_32() - start;
+
+		len = obj->encoded_data.len;
+
+		zassert_ok(nrf_cloud_obj_cloud_encoded_free(obj), "Freeing %s data failed", label);
+		zassert_ok(nrf_cloud_obj_free(obj), "Freeing %s message failed", label);
+	}
+
+	zassert_equal(heap_used, 0, "%s encoding leaked %zu bytes", label, heap_used);
+
+	TC_PRINT("%-11s: %3zu bytes, %6llu ns per message, %5zu bytes of heap at peak\n", label,
+		 len, k_cyc_to_ns_floor64(cycles) / ENCODE_ROUNDS, heap_peak);
+}
+
+static void *nrf_cloud_codec_setup(void)
+{
+	static struct nrf_cloud_os_mem_hooks hooks = {
+		.malloc_fn = counting_malloc,
+		.calloc_fn = counting_calloc,
+		.free_fn = counting_free,
+	};
+
+	nrf_cloud_os_mem_hooks_init(&hooks);
+
+	return NULL;
+}
+
+ZTEST(nrf_cloud_codec, test_stream_matches_json)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(json_obj);
+	NRF_CLOUD_OBJ_STREAM_DEFINE(stream_obj, msg_buf, sizeof(msg_buf),
+				    NRF_CLOUD_OBJ_STREAM_FMT_JSON);
+
+	zassert_ok(msg_build(&json_obj), "Building JSON message failed");
+	zassert_ok(nrf_cloud_obj_cloud_encode(&json_obj), "Encoding JSON message failed");
+	strncpy(json_msg, json_obj.encoded_data.ptr, sizeof(json_msg) - 1);
+	(void)nrf_cloud_obj_cloud_encoded_free(&json_obj);
+	(void)nrf_cloud_obj_free(&json_obj);
+
+	zassert_ok(msg_build(&stream_obj), "Building stream message failed");
+	zassert_ok(nrf_cloud_obj_cloud_encode(&stream_obj), "Encoding stream message failed");
+	zassert_str_equal(stream_obj.encoded_data.ptr, json_msg, "Stream output differs");
+
+	/* The data child cannot be extended once a value was added outside of it */
+	zassert_ok(nrf_cloud_obj_free(&stream_obj), "Freeing stream message failed");
+	zassert_ok(nrf_cloud_obj_msg_init(&stream_obj, "TEMP", NULL), "Init failed");
+	zassert_ok(nrf_cloud_obj_num_add(&stream_obj, "temp", 21.7, true), "Adding failed");
+	zassert_ok(nrf_cloud_obj_ts_add(&stream_obj, MSG_TS), "Adding timestamp failed");
+	zassert_equal(nrf_cloud_obj_num_add(&stream_obj, "hum", 44, true), -EPERM,
+		      "Data child reopened");
+	zassert_ok(nrf_cloud_obj_free(&stream_obj), "Freeing stream message failed");
+}
+
+ZTEST(nrf_cloud_codec, test_stream_overflow)
+{
+	NRF_CLOUD_OBJ_STREAM_DEFINE(stream_obj, msg_buf, 64, NRF_CLOUD_OBJ_STREAM_FMT_JSON);
+	size_t len;
+
+	zassert_ok(nrf_cloud_obj_msg_init(&stream_obj, "TEMP", NULL), "Init failed");
+	zassert_ok(nrf_cloud_obj_num_add(&stream_obj, "temp", 21.7, true), "Adding failed");
+
+	/* A value that does not fit leaves the message as it was */
+	len = stream_obj_stream.len;
+	zassert_equal(nrf_cloud_obj_str_add(&stream_obj, "note",
+					    "this string does not fit into the buffer", true),
+		      -ENOMEM, "Oversized value added");
+	zassert_equal(stream_obj_stream.len, len, "Failed value was partially written");
+
+	zassert_ok(nrf_cloud_obj_cloud_encode(&stream_obj), "Encoding failed");
+	zassert_str_equal(stream_obj.encoded_data.ptr,
+			  "{\"appId\":\"TEMP\",\"data\":{\"temp\":21.7}}", "Unexpected output");
+	zassert_ok(nrf_cloud_obj_free(&stream_obj), "Freeing stream message failed");
+}
+
+ZTEST(nrf_cloud_codec, test_encode_time)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(json_obj);
+	NRF_CLOUD_OBJ_STREAM_DEFINE(json_stream_obj, msg_buf, sizeof(msg_buf),
+				    NRF_CLOUD_OBJ_STREAM_FMT_JSON);
+	NRF_CLOUD_OBJ_STREAM_DEFINE(cbor_stream_obj, msg_buf, sizeof(msg_buf),
+				    NRF_CLOUD_OBJ_STREAM_FMT_CBOR);
+
+	encode_run("cJSON", &json_obj, msg_build);
+	encode_run("stream JSON", &json_stream_obj, msg_build);
+	zassert_equal(heap_peak, 0, "Stream encoding used the heap");
+	encode_run("cJSON PVT", &json_obj, pvt_msg_build);
+	encode_run("stream CBOR", &cbor_stream_obj, pvt_msg_build);
+	zassert_equal(heap_peak, 0, "Stream encoding used the heap");
+}
+
+ZTEST_SUITE(nrf_cloud_codec, NULL, nrf_cloud_codec_setup, NULL, NULL, NULL);
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+#include <settings/settings_zms_legacy.h>
+
+/* Object names follow the trusted storage settings backend pattern */
+#define OBJECT_NAME_PATTERN "its/%08x%08x"
+#define OBJECT_NAME_LEN 32
+#define OBJECT_SIZE 32
+#define LOOKUP_COUNT 50
+
+struct load_info {
+	uint8_t *data;
+	ssize_t ret;
+};
+
+static uint32_t stored_cnt;
+
+static void object_name_get(uint32_t uid, char *name)
+{
+	snprintf(name, OBJECT_NAME_LEN, OBJECT_NAME_PATTERN, 0U, uid);
+}
+
+static void object_data_get(uint32_t uid, uint8_t *data)
+{
+	memset(data, (uint8_t)uid, OBJECT_SIZE);
+	memcpy(data, &uid, sizeof(uid));
+}
+
+static int load_cb(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+		   void *param)
+{
+	struct load_info *info = param;
+
+	info->ret = read_cb(cb_arg, info->data, MIN(len, OBJECT_SIZE));
+
+	return 0;
+}
+
+static void objects_store(uint32_t cnt)
+{
+	char name[OBJECT_NAME_LEN];
+	uint8_t data[OBJECT_SIZE];
+	int err;
+
+	for (; stored_cnt < cnt; stored_cnt++) {
+		object_name_get(stored_cnt, name);
+		object_data_get(stored_cnt, data);
+
+		err = settings_save_one(name, data, sizeof(data));
+		zassert_ok(err, "Cannot store object %u: %d", stored_cnt, err);
+	}
+}
+
+static uint32_t lookup_subtree_direct(uint32_t uid)
+{
+	char name[OBJECT_NAME_LEN];
+	uint8_t data[OBJECT_SIZE];
+	uint8_t expected[OBJECT_SIZE];
+	struct load_info info = {
+		.data = data,
+		.ret = -ENOENT,
+	};
+	uint32_t start;
+	uint32_t cycles;
+
+	object_name_get(uid, name);
+	object_data_get(uid, expected);
+
+	start = k_cycle_get_32();
+	(void)settings_load_subtree_direct(name, load_cb, &info);
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(info.ret, OBJECT_SIZE, "Unexpected length: %d", info.ret);
+	zassert_mem_equal(data, expected, OBJECT_SIZE, "Unexpected data");
+
+	return cycles;
+}
+
+static uint32_t lookup_load_one(uint32_t uid)
+{
+	char name[OBJECT_NAME_LEN];
+	uint8_t data[OBJECT_SIZE];
+	uint8_t expected[OBJECT_SIZE];
+	uint32_t start;
+	uint32_t cycles;
+	ssize_t ret;
+
+	object_name_get(uid, name);
+	object_data_get(uid, expected);
+
+	start = k_cycle_get_32();
+	ret = settings_zms_legacy_load_one(name, data, sizeof(data));
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(ret, OBJECT_SIZE, "Unexpected length: %d", ret);
+	zassert_mem_equal(data, expected, OBJECT_SIZE, "Unexpected data");
+
+	return cycles;
+}
+
+static void lookup_benchmark(uint32_t cnt)
+{
+	uint64_t direct_cycles = 0;
+	uint64_t load_one_cycles = 0;
+
+	objects_store(cnt);
+
+	/* Fill the name cache the same way the application does on boot */
+	zassert_ok(settings_load(), "Cannot load settings");
+
+	for (uint32_t i = 0; i < LOOKUP_COUNT; i++) {
+		uint32_t uid = (i * 7919U) % cnt;
+
+		direct_cycles += lookup_subtree_direct(uid);
+		load_one_cycles += lookup_load_one(uid);
+	}
+
+	TC_PRINT("%4u objects: subtree load %6llu us, direct load %6llu us per lookup\n", cnt,
+		 k_cyc_to_us_floor64(direct_cycles / LOOKUP_COUNT),
+		 k_cyc_to_us_floor64(load_one_cycles / LOOKUP_COUNT));
+
+	zassert_equal(settings_zms_legacy_load_one("its/missing", NULL, 0), -ENOENT,
+		      "Missing object found");
+}
+
+static void *settings_lookup_setup(void)
+{
+	zassert_ok(settings_subsys_init(), "Cannot initialize settings");
+
+	return NULL;
+}
+
+ZTEST(settings_lookup, test_lookup_10)
+{
+	lookup_benchmark(10);
+}
+
+ZTEST(settings_lookup, test_lookup_100)
+{
+	lookup_benchmark(100);
+}
+
+ZTEST(settings_lookup, test_lookup_1000)
+{
+	lookup_benchmark(1000);
+}
+
+ZTEST_SUITE(settings_lookup, NULL, settings_lookup_setup, NULL, NULL, NULL);
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/zms.h>
+#include <zephyr/settings/settings.h>
+#include <settings/settings_zms_legacy.h>
+
+/* A provisioning burst stores a few entries per node and updates each of them
+ * several times, like the mesh stack does while a node is being configured.
+ */
+#define ENTRY_NAME_PATTERN "bt/mesh/%c/%x/%u"
+#define ENTRY_NAME_LEN 32
+#define ENTRY_SIZE 16
+#define ENTRIES_PER_NODE 4
+#define UPDATES_PER_ENTRY 3
+
+typedef int (*burst_fn)(char prefix, uint32_t nodes);
+
+static void entry_name_get(char prefix, uint32_t node, uint32_t entry, char *name)
+{
+	snprintf(name, ENTRY_NAME_LEN, ENTRY_NAME_PATTERN, prefix, node, entry);
+}
+
+static void entry_data_get(uint32_t node, uint32_t entry, uint32_t update, uint8_t *data)
+{
+	memset(data, (uint8_t)(entry + update), ENTRY_SIZE);
+	memcpy(data, &node, sizeof(node));
+}
+
+static int burst_store(char prefix, uint32_t nodes)
+{
+	char name[ENTRY_NAME_LEN];
+	uint8_t data[ENTRY_SIZE];
+	int err;
+
+	for (uint32_t update = 0; update < UPDATES_PER_ENTRY; update++) {
+		for (uint32_t node = 0; node < nodes; node++) {
+			for (uint32_t entry = 0; entry < ENTRIES_PER_NODE; entry++) {
+				entry_name_get(prefix, node, entry, name);
+				entry_data_get(node, entry, update, data);
+
+				err = settings_save_one(name, data, sizeof(data));
+				if (err) {
+					return err;
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int burst_store_txn(char prefix, uint32_t nodes)
+{
+	int err;
+
+	err = settings_zms_legacy_txn_begin();
+	if (err) {
+		return err;
+	}
+
+	err = burst_store(prefix, nodes);
+	if (err) {
+		(void)settings_zms_legacy_txn_abort();
+		return err;
+	}
+
+	return settings_zms_legacy_txn_commit();
+}
+
+static void burst_verify(char prefix, uint32_t nodes)
+{
+	char name[ENTRY_NAME_LEN];
+	uint8_t data[ENTRY_SIZE];
+	uint8_t expected[ENTRY_SIZE];
+	ssize_t ret;
+
+	for (uint32_t node = 0; node < nodes; node++) {
+		for (uint32_t entry = 0; entry < ENTRIES_PER_NODE; entry++) {
+			entry_name_get(prefix, node, entry, name);
+			entry_data_get(node, entry, UPDATES_PER_ENTRY - 1, expected);
+
+			ret = settings_zms_legacy_load_one(name, data, sizeof(data));
+			zassert_equal(ret, ENTRY_SIZE, "Unexpected length of %s: %d", name, ret);
+			zassert_mem_equal(data, expected, ENTRY_SIZE, "Unexpected data of %s", name);
+		}
+	}
+}
+
+static void burst_run(const char *label, burst_fn fn, char prefix, uint32_t nodes)
+{
+	struct zms_fs *fs;
+	ssize_t free_before;
+	ssize_t free_after;
+	uint32_t start;
+	uint32_t cycles;
+
+	zassert_ok(settings_storage_get((void **)&fs), "Cannot get settings storage");
+
+	free_before = zms_calc_free_space(fs);
+
+	start = k_cycle_get_32();
+	zassert_ok(fn(prefix, nodes), "%s burst failed", label);
+	cycles = k_cycle_get_32() - start;
+
+	free_after = zms_calc_free_space(fs);
+
+	TC_PRINT("%3u nodes, %-11s: %7llu us, %6d bytes of flash used\n", nodes, label,
+		 k_cyc_to_us_floor64(cycles), (int)(free_before - free_after));
+
+	burst_verify(prefix, nodes);
+}
+
+static void burst_benchmark(char prefix, uint32_t nodes)
+{
+	burst_run("save_one", burst_store, prefix, nodes);
+	burst_run("transaction", burst_store_txn, prefix + 1, nodes);
+}
+
+static void *settings_txn_setup(void)
+{
+	zassert_ok(settings_subsys_init(), "Cannot initialize settings");
+	zassert_ok(settings_load(), "Cannot load settings");
+
+	return NULL;
+}
+
+ZTEST(settings_txn, test_burst_8)
+{
+	burst_benchmark('a', 8);
+}
+
+ZTEST(settings_txn, test_burst_64)
+{
+	burst_benchmark('c', 64);
+}
+
+ZTEST(settings_txn, test_abort)
+{
+	char name[ENTRY_NAME_LEN];
+	uint8_t data[ENTRY_SIZE];
+
+	zassert_ok(settings_zms_legacy_txn_begin(), "Cannot begin transaction");
+	zassert_equal(settings_zms_legacy_txn_begin(), -EALREADY, "Nested transaction begun");
+	zassert_ok(burst_store('x', 1), "Cannot stage settings");
+	zassert_ok(settings_zms_legacy_txn_abort(), "Cannot abort transaction");
+
+	entry_name_get('x', 0, 0, name);
+	zassert_equal(settings_zms_legacy_load_one(name, data, sizeof(data)), -ENOENT,
+		      "Aborted setting stored");
+	zassert_equal(settings_zms_legacy_txn_commit(), -EINVAL,
+		      "Transaction committed after abort");
+}
+
+ZTEST_SUITE(settings_txn, NULL, settings_txn_setup, NULL, NULL, NULL);
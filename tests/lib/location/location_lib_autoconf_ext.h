@@ -14,3 +14,9 @@
 #define CONFIG_WIFI_MGMT_RAW_SCAN_RESULT_LENGTH 10
 #define CONFIG_NET_MGMT_EVENT 1
 #define CONFIG_NET_MGMT_EVENT_INFO 1
+
+/* Cloud location cache, which is compiled into the test application */
+#define CONFIG_LOCATION_SERVICE_CLOUD_CACHE_SIZE 2
+#define CONFIG_LOCATION_SERVICE_CLOUD_CACHE_MAX_AGE 60
+#define CONFIG_LOCATION_SERVICE_CLOUD_CACHE_WIFI_APS 3
+#define CONFIG_LOCATION_SERVICE_CLOUD_CACHE_WIFI_MATCH 2
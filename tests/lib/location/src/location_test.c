@@ -24,6 +24,9 @@
 #include "cmock_net_if.h"
 #include "cmock_net_mgmt.h"
 #include "cmock_wifi_mgmt.h"
+#include "cmock_date_time.h"
+
+#include "cloud_location_cache.h"
 
 /* NOTE: Sleep, e.g. k_sleep(K_MSEC(1)), is used after many location library API
  *       function calls because otherwise some of the threaded work in location library
@@ -125,6 +128,11 @@ static const char ncellmeas_resp_gci5[] =
 	"\"00011B08\",\"26295\",\"00B7\",65535,0,2300,9,62,30,150345527,0,0\r\n";
 #endif
 
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR_WIFI_EARLY_FINISH)
+/* Response to AT%NCELLMEASSTOP during a GCI search that has not found any cells */
+static const char ncellmeas_resp_gci_stopped[] = "%NCELLMEAS:2\r\n";
+#endif
+
 char http_resp[512];
 
 static const char http_resp_header_ok[] =
@@ -1435,6 +1443,165 @@ void test_location_wifi_timeout(void)
 #endif
 }
 
+/********* COMBINED WI-FI AND CELLULAR TESTS ***********************/
+
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR_WIFI_EARLY_FINISH)
+#if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && !defined(CONFIG_LOCATION_DATA_DETAILS)
+static void helper_wifi_cellular_request(void)
+{
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR, LOCATION_METHOD_WIFI};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.methods[0].cellular.cell_count = 4;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_CLOUD_LOCATION_EXT_REQUEST;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_WIFI;
+	location_cb_expected++;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_LOCATION;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_WIFI_CELLULAR;
+	test_location_event_data[location_cb_expected].location.latitude = 51.98765;
+	test_location_event_data[location_cb_expected].location.longitude = 13.12345;
+	test_location_event_data[location_cb_expected].location.accuracy = 50.0;
+	test_location_event_data[location_cb_expected].location.datetime.valid = false;
+	location_cb_expected++;
+
+	net_mgmt_NET_REQUEST_WIFI_SCAN_expected = true;
+	__cmock_net_mgmt_NET_REQUEST_WIFI_SCAN_ExpectAndReturn(0);
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+}
+
+/* Send Wi-Fi scan results with enough access points to finish the cell measurements */
+static void helper_wifi_scan_done(void)
+{
+	struct net_mgmt_event_callback cb;
+	const struct wifi_status status = {
+		.status = WIFI_STATUS_CONN_SUCCESS
+	};
+	struct wifi_scan_result scan_result = {
+		.ssid = "TestAP",
+		.ssid_length = 6,
+		.channel = 36,
+		.mac = {0x12, 0x34, 0x56, 0x78, 0x90, 0x00},
+		.mac_length = 6
+	};
+
+	for (int i = 0; i < CONFIG_LOCATION_METHOD_CELLULAR_WIFI_EARLY_FINISH_AP_COUNT; i++) {
+		scan_result.mac[5] = i;
+		cb.info = &scan_result;
+		scan_wifi_net_mgmt_event_handler(&cb, NET_EVENT_WIFI_SCAN_RESULT, NULL);
+		k_sleep(K_MSEC(1));
+	}
+
+	/* The scan done callback only requests the cell measurements to finish */
+	cb.info = &status;
+	scan_wifi_net_mgmt_event_handler(&cb, NET_EVENT_WIFI_SCAN_DONE, NULL);
+	k_sleep(K_MSEC(1));
+}
+
+/* Wait for the cloud location request and give the location */
+static void helper_wifi_cellular_result_set(void)
+{
+	int err;
+	struct location_data location_data = {
+		.latitude = 51.98765,
+		.longitude = 13.12345,
+		.accuracy = 50.0,
+		.datetime.valid = false
+	};
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	location_cloud_location_ext_result_set(LOCATION_EXT_RESULT_SUCCESS, &location_data);
+	k_sleep(K_MSEC(1));
+}
+#endif
+#endif
+
+/* Test finishing cell measurements early during the 1st NCELLMEAS, before the wait for
+ * RRC idle mode. The normal neighbor search is completed and GCI searches are skipped.
+ */
+void test_location_wifi_cellular_early_finish_before_rrc_idle_wait(void)
+{
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR_WIFI_EARLY_FINISH)
+#if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && !defined(CONFIG_LOCATION_DATA_DETAILS)
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	helper_wifi_cellular_request();
+
+	/* No AT%NCELLMEASSTOP is expected as the normal neighbor search is not stopped */
+	helper_wifi_scan_done();
+
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+	k_sleep(K_MSEC(1));
+
+	helper_wifi_cellular_result_set();
+#endif
+#endif
+}
+
+/* Test finishing cell measurements early while waiting for RRC idle mode before
+ * GCI searches.
+ */
+void test_location_wifi_cellular_early_finish_during_rrc_idle_wait(void)
+{
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR_WIFI_EARLY_FINISH)
+#if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && !defined(CONFIG_LOCATION_DATA_DETAILS)
+	/* RRC connected mode prevents GCI searches */
+	at_monitor_dispatch("+CSCON: 1");
+	k_sleep(K_MSEC(1));
+
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	helper_wifi_cellular_request();
+
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+	k_sleep(K_MSEC(1));
+
+	/* The wait for RRC idle mode is interrupted without any GCI search */
+	helper_wifi_scan_done();
+
+	helper_wifi_cellular_result_set();
+
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+#endif
+#endif
+}
+
+/* Test finishing cell measurements early during a GCI search. The search is stopped from
+ * the location workqueue and the cells found so far are used.
+ */
+void test_location_wifi_cellular_early_finish_during_gci_search(void)
+{
+#if defined(CONFIG_LOCATION_METHOD_CELLULAR_WIFI_EARLY_FINISH)
+#if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && !defined(CONFIG_LOCATION_DATA_DETAILS)
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=3,5", 0);
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEASSTOP", 0);
+
+	helper_wifi_cellular_request();
+
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+	k_sleep(K_MSEC(1));
+
+	helper_wifi_scan_done();
+
+	/* Stopping the GCI search triggers a NCELLMEAS notification */
+	at_monitor_dispatch(ncellmeas_resp_gci_stopped);
+	k_sleep(K_MSEC(1));
+
+	helper_wifi_cellular_result_set();
+#endif
+#endif
+}
+
 /********* GENERAL ERROR TESTS ***********************/
 
 /* Test location request with unknown method. */
@@ -2192,6 +2359,218 @@ void test_location_cellular_periodic(void)
 #endif
 }
 
+/********* CLOUD LOCATION CACHE TESTS ***********************/
+
+#define CACHE_TEST_MAX_AGE_MS (CONFIG_LOCATION_SERVICE_CLOUD_CACHE_MAX_AGE * MSEC_PER_SEC)
+
+static int64_t cache_test_now_ms;
+static bool cache_test_time_valid;
+
+static int cache_test_date_time_now(int64_t *unix_time_ms, int cmock_num_calls)
+{
+	if (!cache_test_time_valid) {
+		return -ENODATA;
+	}
+
+	*unix_time_ms = cache_test_now_ms;
+	return 0;
+}
+
+/* The cache is not cleared between the tests, so the locations cached by earlier tests
+ * are expired by moving the time forward.
+ */
+static void helper_cache_start(void)
+{
+	__cmock_date_time_now_Stub(cache_test_date_time_now);
+	cache_test_time_valid = true;
+	cache_test_now_ms += CACHE_TEST_MAX_AGE_MS + MSEC_PER_SEC;
+}
+
+static void helper_cache_cell_set(struct lte_lc_cells_info *cell_data, uint32_t cell_id)
+{
+	memset(cell_data, 0, sizeof(*cell_data));
+	cell_data->current_cell.mcc = 262;
+	cell_data->current_cell.mnc = 95;
+	cell_data->current_cell.id = cell_id;
+	cell_data->current_cell.tac = 0x00B7;
+}
+
+static void helper_cache_ap_set(struct wifi_scan_result *ap, uint8_t mac_id, int8_t rssi)
+{
+	memset(ap, 0, sizeof(*ap));
+	memset(ap->mac, mac_id, WIFI_MAC_ADDR_LEN);
+	ap->mac_length = WIFI_MAC_ADDR_LEN;
+	ap->rssi = rssi;
+}
+
+static void helper_cache_put(
+	const struct lte_lc_cells_info *cell_data,
+	const struct wifi_scan_info *wifi_data,
+	double latitude)
+{
+	struct location_data location = {
+		.latitude = latitude,
+		.longitude = 13.12345,
+		.accuracy = 50.0,
+	};
+
+	cloud_location_cache_put(cell_data, wifi_data, &location);
+}
+
+/* Test that a location is found with the same serving cell. */
+void test_location_cloud_cache_hit(void)
+{
+	struct lte_lc_cells_info cell_data;
+	struct location_data location = { 0 };
+	uint32_t age = 0;
+	int err;
+
+	helper_cache_start();
+	helper_cache_cell_set(&cell_data, 0x00011B07);
+	helper_cache_put(&cell_data, NULL, 61.50375);
+
+	cache_test_now_ms += 10 * MSEC_PER_SEC;
+
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL_DOUBLE(61.50375, location.latitude);
+	TEST_ASSERT_EQUAL_DOUBLE(13.12345, location.longitude);
+	TEST_ASSERT_EQUAL_FLOAT(50.0, location.accuracy);
+	TEST_ASSERT_EQUAL(10, age);
+}
+
+/* Test that a location is not found with a different serving cell. */
+void test_location_cloud_cache_miss_other_cell(void)
+{
+	struct lte_lc_cells_info cell_data;
+	struct location_data location = { 0 };
+	uint32_t age;
+	int err;
+
+	helper_cache_start();
+	helper_cache_cell_set(&cell_data, 0x00011B07);
+	helper_cache_put(&cell_data, NULL, 61.50375);
+
+	helper_cache_cell_set(&cell_data, 0x00011B08);
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(-ENOENT, err);
+
+	/* Same cell ID in another tracking area */
+	helper_cache_cell_set(&cell_data, 0x00011B07);
+	cell_data.current_cell.tac = 0x00C3;
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(-ENOENT, err);
+
+	/* No serving cell */
+	helper_cache_cell_set(&cell_data, LTE_LC_CELL_EUTRAN_ID_INVALID);
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(-ENOENT, err);
+}
+
+/* Test that a Wi-Fi location is found when enough of the strongest access points match. */
+void test_location_cloud_cache_wifi_partial_match(void)
+{
+	struct lte_lc_cells_info cell_data;
+	struct wifi_scan_result aps[CONFIG_LOCATION_SERVICE_CLOUD_CACHE_WIFI_APS + 1];
+	struct wifi_scan_info wifi_data = { .ap_info = aps, .cnt = ARRAY_SIZE(aps) };
+	struct location_data location = { 0 };
+	uint32_t age;
+	int err;
+
+	helper_cache_start();
+	helper_cache_cell_set(&cell_data, 0x00011B07);
+
+	/* The weakest access point is not part of the fingerprint */
+	helper_cache_ap_set(&aps[0], 1, -50);
+	helper_cache_ap_set(&aps[1], 2, -60);
+	helper_cache_ap_set(&aps[2], 3, -70);
+	helper_cache_ap_set(&aps[3], 4, -90);
+	helper_cache_put(&cell_data, &wifi_data, 61.50375);
+
+	/* Two of the strongest access points are found, in a different order */
+	helper_cache_ap_set(&aps[0], 5, -55);
+	helper_cache_ap_set(&aps[1], 3, -45);
+	helper_cache_ap_set(&aps[2], 2, -65);
+	helper_cache_ap_set(&aps[3], 6, -95);
+	err = cloud_location_cache_get(&cell_data, &wifi_data, &location, &age);
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL_DOUBLE(61.50375, location.latitude);
+
+	/* Only one of them is found */
+	helper_cache_ap_set(&aps[1], 4, -45);
+	err = cloud_location_cache_get(&cell_data, &wifi_data, &location, &age);
+	TEST_ASSERT_EQUAL(-ENOENT, err);
+
+	/* A location resolved with Wi-Fi is not used for a cellular only request */
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(-ENOENT, err);
+}
+
+/* Test that a location is not used after the maximum age or while the time is unknown. */
+void test_location_cloud_cache_expiry(void)
+{
+	struct lte_lc_cells_info cell_data;
+	struct location_data location = { 0 };
+	uint32_t age;
+	int err;
+
+	helper_cache_start();
+	helper_cache_cell_set(&cell_data, 0x00011B07);
+	helper_cache_put(&cell_data, NULL, 61.50375);
+
+	cache_test_now_ms += CACHE_TEST_MAX_AGE_MS;
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL(CONFIG_LOCATION_SERVICE_CLOUD_CACHE_MAX_AGE, age);
+
+	cache_test_time_valid = false;
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(-ENODATA, err);
+	cache_test_time_valid = true;
+
+	cache_test_now_ms += MSEC_PER_SEC;
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(-ENOENT, err);
+}
+
+/* Test that the oldest location is replaced when the cache is full. */
+void test_location_cloud_cache_eviction(void)
+{
+	struct lte_lc_cells_info cell_data;
+	struct location_data location = { 0 };
+	uint32_t age;
+	int err;
+
+	helper_cache_start();
+
+	for (int i = 0; i <= CONFIG_LOCATION_SERVICE_CLOUD_CACHE_SIZE; i++) {
+		helper_cache_cell_set(&cell_data, 0x00011B00 + i);
+		helper_cache_put(&cell_data, NULL, 60.0 + i);
+		cache_test_now_ms += MSEC_PER_SEC;
+	}
+
+	helper_cache_cell_set(&cell_data, 0x00011B00);
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(-ENOENT, err);
+
+	for (int i = 1; i <= CONFIG_LOCATION_SERVICE_CLOUD_CACHE_SIZE; i++) {
+		helper_cache_cell_set(&cell_data, 0x00011B00 + i);
+		err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+		TEST_ASSERT_EQUAL(0, err);
+		TEST_ASSERT_EQUAL_DOUBLE(60.0 + i, location.latitude);
+	}
+
+	/* A location of the same place replaces the cached one instead of the oldest */
+	helper_cache_put(&cell_data, NULL, 70.0);
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL_DOUBLE(70.0, location.latitude);
+
+	helper_cache_cell_set(&cell_data, 0x00011B01);
+	err = cloud_location_cache_get(&cell_data, NULL, &location, &age);
+	TEST_ASSERT_EQUAL(0, err);
+}
+
 /* This is needed because AT Monitor library is initialized in SYS_INIT. */
 static int location_test_sys_init(void)
 {
@@ -1602,18 +1602,18 @@ void test_nrf9x_socket_offload_sendmsg_not_fits_buf(void)
 	msg.msg_iov = chunks;
 	msg.msg_iovlen = 3;
 
-	/* First send doesn't send all data of the first chunk */
-	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, &chunk_1, sizeof(int),
+	/* The first two chunks fill the buffer. First send doesn't send all of it */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, 2 * sizeof(int),
 					   NRF_MSG_DONTWAIT,
-					   NULL, 0, sizeof(int) - 1);
-	/* Second send will send the remaining part of the first chunk */
-	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, ((uint8_t *)&chunk_1) + sizeof(int) - 1, 1,
+					   NULL, 0, 2 * sizeof(int) - 1);
+	__cmock_nrf_sendto_IgnoreArg_message();
+	/* Second send will send the remaining part of the buffer */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, 1,
 					   NRF_MSG_DONTWAIT,
 					   NULL, 0, 1);
-	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, &chunk_2, sizeof(int),
-					   NRF_MSG_DONTWAIT,
-					   NULL, 0, sizeof(int));
-	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, &chunk_3, sizeof(int),
+	__cmock_nrf_sendto_IgnoreArg_message();
+	/* Third send will send the last chunk */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, sizeof(int),
 					   NRF_MSG_DONTWAIT,
 					   NULL, 0, sizeof(int));
 	__cmock_nrf_sendto_IgnoreArg_message();
@@ -1629,6 +1629,54 @@ void test_nrf9x_socket_offload_sendmsg_not_fits_buf(void)
 	TEST_ASSERT_EQUAL(ret, 0);
 }
 
+void test_nrf9x_socket_offload_sendmsg_large_chunk(void)
+{
+	int ret;
+	int fd;
+	int nrf_fd = 2;
+	int family = AF_INET;
+	int type = SOCK_STREAM;
+	int proto = IPPROTO_TCP;
+	int flags = ZSOCK_MSG_DONTWAIT;
+	struct msghdr msg = { 0 };
+	struct iovec chunks[2] = { 0 };
+	int chunk_1 = 42;
+	int chunk_2[3] = { 43, 44, 45 };
+
+	__cmock_nrf_socket_ExpectAndReturn(NRF_AF_INET, NRF_SOCK_STREAM, NRF_IPPROTO_TCP, nrf_fd);
+
+	fd = zsock_socket(family, type, proto);
+
+	TEST_ASSERT_EQUAL(fd, 0);
+
+	chunks[0].iov_base = &chunk_1;
+	chunks[0].iov_len = sizeof(chunk_1);
+	chunks[1].iov_base = chunk_2;
+	chunks[1].iov_len = sizeof(chunk_2);
+	msg.msg_iov = chunks;
+	msg.msg_iovlen = 2;
+
+	/* The first chunk and the start of the second one fill the buffer */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, 2 * sizeof(int),
+					   NRF_MSG_DONTWAIT,
+					   NULL, 0, 2 * sizeof(int));
+	__cmock_nrf_sendto_IgnoreArg_message();
+	/* The rest of the second chunk fills the buffer, so it is sent without copying */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, &chunk_2[1], 2 * sizeof(int),
+					   NRF_MSG_DONTWAIT,
+					   NULL, 0, 2 * sizeof(int));
+
+	ret = zsock_sendmsg(fd, &msg, flags);
+
+	TEST_ASSERT_EQUAL(ret, 4 * sizeof(int));
+
+	__cmock_nrf_close_ExpectAndReturn(nrf_fd, 0);
+
+	ret = zsock_close(fd);
+
+	TEST_ASSERT_EQUAL(ret, 0);
+}
+
 void test_nrf9x_socket_offload_fcntl_einval(void)
 {
 	int ret;
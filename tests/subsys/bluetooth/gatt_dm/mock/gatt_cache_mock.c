@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <string.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include "gatt_cache_mock.h"
+
+#define SETTINGS_MOCK_ENTRIES 8
+#define SETTINGS_MOCK_NAME_LEN 64
+
+/* Settings of the read and subscribe mocks */
+static struct bt_gatt_cache_mock {
+	uint8_t db_hash[BT_GATT_CACHE_MOCK_DB_HASH_LEN];
+	bool db_hash_valid;
+	struct bt_conn *conn;
+	struct bt_gatt_read_params *read_params;
+	struct k_work read_work;
+	struct bt_gatt_subscribe_params *sub_params;
+	struct k_work subscribe_work;
+} cache_mock_data;
+
+static const bt_addr_le_t peer_addr = {
+	.type = BT_ADDR_LE_PUBLIC,
+	.a = {{0x01, 0x02, 0x03, 0x04, 0x05, 0xc0}},
+};
+
+static struct settings_mock_entry {
+	char name[SETTINGS_MOCK_NAME_LEN];
+	uint8_t val[CONFIG_BT_GATT_DM_CACHE_ENTRY_SIZE];
+	size_t val_len;
+} settings_entries[SETTINGS_MOCK_ENTRIES];
+
+void bt_gatt_cache_mock_db_hash_set(const uint8_t *hash)
+{
+	cache_mock_data.db_hash_valid = (hash != NULL);
+
+	if (hash) {
+		memcpy(cache_mock_data.db_hash, hash, sizeof(cache_mock_data.db_hash));
+	}
+}
+
+bool bt_gatt_cache_mock_sc_subscribed(void)
+{
+	return (cache_mock_data.sub_params != NULL) &&
+	       (cache_mock_data.sub_params->value == BT_GATT_CCC_INDICATE);
+}
+
+void bt_gatt_cache_mock_sc_indicate(void)
+{
+	/* Indicated range: the whole database */
+	static const uint8_t range[] = {0x01, 0x00, 0xff, 0xff};
+
+	zassert_not_null(cache_mock_data.sub_params, "Service Changed not subscribed");
+	zassert_equal(cache_mock_data.sub_params->notify(cache_mock_data.conn,
+							 cache_mock_data.sub_params,
+							 range, sizeof(range)),
+		      BT_GATT_ITER_CONTINUE);
+}
+
+void bt_gatt_cache_mock_disconnect(void)
+{
+	STRUCT_SECTION_FOREACH(bt_conn_cb, cb) {
+		if (cb->disconnected) {
+			cb->disconnected(cache_mock_data.conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+		}
+	}
+
+	cache_mock_data.sub_params = NULL;
+}
+
+size_t bt_gatt_cache_mock_settings_cnt(void)
+{
+	size_t cnt = 0;
+
+	ARRAY_FOR_EACH_PTR(settings_entries, entry) {
+		if (entry->val_len) {
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
+
+static void bt_gatt_read_work(struct k_work *work)
+{
+	struct bt_gatt_read_params *params = cache_mock_data.read_params;
+
+	if (cache_mock_data.db_hash_valid) {
+		(void)params->func(cache_mock_data.conn, 0, params, cache_mock_data.db_hash,
+				   sizeof(cache_mock_data.db_hash));
+	} else {
+		(void)params->func(cache_mock_data.conn, BT_ATT_ERR_ATTRIBUTE_NOT_FOUND, params,
+				   NULL, 0);
+	}
+}
+
+static void bt_gatt_subscribe_work(struct k_work *work)
+{
+	cache_mock_data.sub_params->subscribe(cache_mock_data.conn, 0, cache_mock_data.sub_params);
+}
+
+/* Mocked version of the bt_gatt_read, only reads by the UUID are supported */
+int bt_gatt_read(struct bt_conn *conn, struct bt_gatt_read_params *params)
+{
+	zassert_equal(params->handle_count, 0, "Only reads by UUID are supported");
+	zassert_ok(bt_uuid_cmp(params->by_uuid.uuid, BT_UUID_GATT_DB_HASH));
+
+	cache_mock_data.conn = conn;
+	cache_mock_data.read_params = params;
+	k_work_init(&cache_mock_data.read_work, bt_gatt_read_work);
+	k_work_submit(&cache_mock_data.read_work);
+
+	return 0;
+}
+
+/* Mocked version of the bt_gatt_subscribe, the subscription always succeeds */
+int bt_gatt_subscribe(struct bt_conn *conn, struct bt_gatt_subscribe_params *params)
+{
+	zassert_not_null(params->notify);
+	zassert_not_null(params->subscribe);
+	zassert_not_equal(params->ccc_handle, 0, "CCC descriptor not discovered");
+
+	cache_mock_data.conn = conn;
+	cache_mock_data.sub_params = params;
+	k_work_init(&cache_mock_data.subscribe_work, bt_gatt_subscribe_work);
+	k_work_submit(&cache_mock_data.subscribe_work);
+
+	return 0;
+}
+
+/* Wrapped version of the bt_conn_get_dst, the peer uses a public address */
+const bt_addr_le_t *__wrap_bt_conn_get_dst(const struct bt_conn *conn)
+{
+	return &peer_addr;
+}
+
+/* Wrapped version of the bt_conn_index, there is a single connection */
+uint8_t __wrap_bt_conn_index(const struct bt_conn *conn)
+{
+	return 0;
+}
+
+static ssize_t settings_mock_read_fn(void *back_end, void *data, size_t len)
+{
+	struct settings_mock_entry *entry = back_end;
+
+	len = MIN(len, entry->val_len);
+	memcpy(data, entry->val, len);
+
+	return len;
+}
+
+static int settings_mock_load(struct settings_store *cs, const struct settings_load_arg *arg)
+{
+	int err;
+
+	ARRAY_FOR_EACH_PTR(settings_entries, entry) {
+		if (!entry->val_len) {
+			continue;
+		}
+
+		err = settings_call_set_handler(entry->name, entry->val_len,
+						settings_mock_read_fn, entry, arg);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+static int settings_mock_save(struct settings_store *cs, const char *name, const char *value,
+			      size_t val_len)
+{
+	struct settings_mock_entry *free_entry = NULL;
+
+	zassert_true(strlen(name) < SETTINGS_MOCK_NAME_LEN, "Too long settings key");
+	zassert_true(val_len <= CONFIG_BT_GATT_DM_CACHE_ENTRY_SIZE, "Too long settings value");
+
+	ARRAY_FOR_EACH_PTR(settings_entries, entry) {
+		if (!entry->val_len) {
+			free_entry = free_entry ? free_entry : entry;
+			continue;
+		}
+
+		if (!strcmp(entry->name, name)) {
+			/* Deletes are saves of empty values */
+			if (val_len) {
+				memcpy(entry->val, value, val_len);
+			}
+			entry->val_len = val_len;
+			return 0;
+		}
+	}
+
+	if (val_len == 0) {
+		return 0;
+	}
+
+	zassert_not_null(free_entry, "Settings mock full");
+
+	strcpy(free_entry->name, name);
+	memcpy(free_entry->val, value, val_len);
+	free_entry->val_len = val_len;
+
+	return 0;
+}
+
+static struct settings_store_itf settings_mock_itf = {
+	.csi_load = settings_mock_load,
+	.csi_save = settings_mock_save,
+};
+
+static struct settings_store settings_mock_store = {
+	.cs_itf = &settings_mock_itf
+};
+
+static int settings_mock_init(void)
+{
+	settings_dst_register(&settings_mock_store);
+	settings_src_register(&settings_mock_store);
+
+	return 0;
+}
+
+SYS_INIT(settings_mock_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BT_GATT_CACHE_MOCK_H_
+#define BT_GATT_CACHE_MOCK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file
+ * @defgroup bt_gatt_cache_mock API
+ * @{
+ * @brief The API used to setup the mocks used by the discovery cache
+ */
+
+/** Size of the Database Hash characteristic value. */
+#define BT_GATT_CACHE_MOCK_DB_HASH_LEN 16
+
+/**
+ * @brief Set the Database Hash of the peer
+ *
+ * @param hash The Database Hash or NULL if the peer does not have one.
+ */
+void bt_gatt_cache_mock_db_hash_set(const uint8_t *hash);
+
+/**
+ * @brief Check if the Service Changed indications are enabled
+ *
+ * @return true if the Service Changed characteristic is subscribed.
+ */
+bool bt_gatt_cache_mock_sc_subscribed(void);
+
+/**
+ * @brief Send a Service Changed indication
+ */
+void bt_gatt_cache_mock_sc_indicate(void);
+
+/**
+ * @brief Simulate the disconnection of the peer
+ *
+ * Calls the registered connection callbacks and removes the subscription.
+ */
+void bt_gatt_cache_mock_disconnect(void);
+
+/**
+ * @brief Get the number of stored settings entries
+ *
+ * @return Number of entries in the settings storage mock.
+ */
+size_t bt_gatt_cache_mock_settings_cnt(void);
+
+/**
+ * @}
+ */
+
+#endif /* BT_GATT_CACHE_MOCK_H_ */
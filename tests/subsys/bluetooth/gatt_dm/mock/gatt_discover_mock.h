@@ -90,5 +90,12 @@
  */
 void bt_gatt_discover_mock_setup(const struct bt_gatt_attr *attr, size_t len);
 
+/**
+ * @brief Get the number of @ref bt_gatt_discover calls
+ *
+ * @return Number of calls since the last @ref bt_gatt_discover_mock_setup call.
+ */
+size_t bt_gatt_discover_mock_call_cnt(void);
+
 /** @} */
 #endif /* #define BT_GATT_DISCOVERY_MOCK_H_ */
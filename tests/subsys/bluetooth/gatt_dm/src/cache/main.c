@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/gatt_dm.h>
+#include "../../mock/gatt_discover_mock.h"
+#include "../../mock/gatt_cache_mock.h"
+
+/* Timeout for the discovery in ms */
+#define SERVICE_DISCOVERY_TIMEOUT 2000
+/* Time for the cache updates done in the workqueue in ms */
+#define CACHE_UPDATE_TIME 50
+
+static char dummy_conn;
+static K_SEM_DEFINE(cache_discovery_finished, 0, 1);
+
+static const uint8_t db_hash_a[BT_GATT_CACHE_MOCK_DB_HASH_LEN] = {0xa0, 0xa1, 0xa2, 0xa3};
+static const uint8_t db_hash_b[BT_GATT_CACHE_MOCK_DB_HASH_LEN] = {0xb0, 0xb1, 0xb2, 0xb3};
+
+static const struct bt_gatt_attr cache_sim[] = {
+	/* GATT */
+	BT_GATT_DISCOVER_MOCK_SERV(1, BT_UUID_GATT, 4),
+	/* The value handle is needed to find the CCC descriptor */
+	{
+		.uuid = BT_UUID_GATT_CHRC,
+		.handle = 2,
+		.user_data = (void *)(&(const struct bt_gatt_chrc) {
+			.uuid = BT_UUID_GATT_SC,
+			.value_handle = 3,
+			.properties = BT_GATT_CHRC_INDICATE,
+		}),
+	},
+	BT_GATT_DISCOVER_MOCK_DESC(3, BT_UUID_GATT_SC),
+	BT_GATT_DISCOVER_MOCK_DESC(4, BT_UUID_GATT_CCC),
+
+	/* DIS */
+	BT_GATT_DISCOVER_MOCK_SERV(5, BT_UUID_DIS, 7),
+	BT_GATT_DISCOVER_MOCK_CHRC(6, BT_UUID_DIS_MODEL_NUMBER, BT_GATT_CHRC_READ),
+	BT_GATT_DISCOVER_MOCK_DESC(7, BT_UUID_DIS_MODEL_NUMBER),
+
+	/* BAS */
+	BT_GATT_DISCOVER_MOCK_SERV(8, BT_UUID_BAS, 10),
+	BT_GATT_DISCOVER_MOCK_CHRC(9, BT_UUID_BAS_BATTERY_LEVEL,
+				   BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY),
+	BT_GATT_DISCOVER_MOCK_DESC(10, BT_UUID_BAS_BATTERY_LEVEL),
+
+	/* HRS */
+	BT_GATT_DISCOVER_MOCK_SERV(11, BT_UUID_HRS, 13),
+	BT_GATT_DISCOVER_MOCK_CHRC(12, BT_UUID_HRS_MEASUREMENT, BT_GATT_CHRC_NOTIFY),
+	BT_GATT_DISCOVER_MOCK_DESC(13, BT_UUID_HRS_MEASUREMENT),
+};
+
+static void cache_cb_completed(struct bt_gatt_dm *dm, void *context)
+{
+	*(struct bt_gatt_dm **)context = dm;
+	k_sem_give(&cache_discovery_finished);
+}
+
+static void cache_cb_service_not_found(struct bt_conn *conn, void *context)
+{
+	*(struct bt_gatt_dm **)context = NULL;
+	k_sem_give(&cache_discovery_finished);
+}
+
+static void cache_cb_error_found(struct bt_conn *conn, int err, void *context)
+{
+	zassert_unreachable("Discovery error: %d", err);
+}
+
+static struct bt_gatt_dm_cb cache_test_cb = {
+	.completed         = cache_cb_completed,
+	.service_not_found = cache_cb_service_not_found,
+	.error_found       = cache_cb_error_found
+};
+
+/* Runs the discovery of the service and checks the single characteristic
+ * that each of the services has. Returns the number of bt_gatt_discover calls
+ * the discovery needed.
+ */
+static size_t cache_run_dm(const struct bt_uuid *svc_uuid, const struct bt_uuid *chrc_uuid)
+{
+	size_t call_cnt = bt_gatt_discover_mock_call_cnt();
+	const struct bt_gatt_dm_attr *attr;
+	struct bt_gatt_dm *dm;
+	int err;
+
+	err = bt_gatt_dm_start((struct bt_conn *)&dummy_conn, svc_uuid, &cache_test_cb, &dm);
+	zassert_ok(err, "bt_gatt_dm_start finished with error: %d", err);
+
+	err = k_sem_take(&cache_discovery_finished, K_MSEC(SERVICE_DISCOVERY_TIMEOUT));
+	zassert_ok(err, "It seems that no callback function was called: %d", err);
+	zassert_not_null(dm, "Service not found");
+
+	zassert_equal(bt_gatt_dm_attr_cnt(dm), 3, "Wrong attribute count");
+	zassert_ok(bt_uuid_cmp(bt_gatt_dm_service_get(dm)->uuid, BT_UUID_GATT_PRIMARY));
+
+	attr = bt_gatt_dm_char_by_uuid(dm, chrc_uuid);
+	zassert_not_null(attr, "Characteristic not found");
+	zassert_equal(attr->handle, bt_gatt_dm_service_get(dm)->handle + 1);
+
+	zassert_ok(bt_gatt_dm_data_release(dm));
+
+	/* Let the cache update complete */
+	k_sleep(K_MSEC(CACHE_UPDATE_TIME));
+
+	return bt_gatt_discover_mock_call_cnt() - call_cnt;
+}
+
+static void cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&cache_discovery_finished);
+	bt_gatt_discover_mock_setup(cache_sim, ARRAY_SIZE(cache_sim));
+	bt_gatt_cache_mock_db_hash_set(db_hash_a);
+	bt_gatt_cache_mock_disconnect();
+	zassert_ok(bt_gatt_dm_cache_clear(NULL));
+}
+
+static void cache_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Other suites run without the cache */
+	bt_gatt_cache_mock_db_hash_set(NULL);
+	bt_gatt_cache_mock_disconnect();
+	zassert_ok(bt_gatt_dm_cache_clear(NULL));
+}
+
+ZTEST_SUITE(gatt_dm_cache, NULL, NULL, cache_before, cache_after, NULL);
+
+ZTEST(gatt_dm_cache, test_cache_hit)
+{
+	zassert_not_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0);
+	zassert_equal(bt_gatt_cache_mock_settings_cnt(), 1, "Discovery not cached");
+	zassert_true(bt_gatt_cache_mock_sc_subscribed(), "Service Changed not subscribed");
+
+	/* Neither the service nor the Service Changed characteristic is
+	 * discovered again on the same connection.
+	 */
+	zassert_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0,
+		      "Discovery not restored from cache");
+	zassert_equal(bt_gatt_cache_mock_settings_cnt(), 1);
+}
+
+ZTEST(gatt_dm_cache, test_cache_miss_on_db_hash_change)
+{
+	zassert_not_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0);
+
+	bt_gatt_cache_mock_db_hash_set(db_hash_b);
+	zassert_not_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0,
+			  "Outdated discovery restored from cache");
+
+	/* The outdated entry is replaced */
+	zassert_equal(bt_gatt_cache_mock_settings_cnt(), 1);
+	zassert_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0);
+}
+
+ZTEST(gatt_dm_cache, test_cache_miss_on_other_service)
+{
+	zassert_not_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0);
+	zassert_not_equal(cache_run_dm(BT_UUID_BAS, BT_UUID_BAS_BATTERY_LEVEL), 0,
+			  "Other service restored from cache");
+	zassert_equal(bt_gatt_cache_mock_settings_cnt(), 2);
+
+	zassert_equal(cache_run_dm(BT_UUID_BAS, BT_UUID_BAS_BATTERY_LEVEL), 0);
+	zassert_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0);
+}
+
+ZTEST(gatt_dm_cache, test_cache_invalidated_on_service_changed)
+{
+	zassert_not_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0);
+	zassert_not_equal(cache_run_dm(BT_UUID_BAS, BT_UUID_BAS_BATTERY_LEVEL), 0);
+
+	/* The Database Hash is the same until it is read again */
+	bt_gatt_cache_mock_sc_indicate();
+	k_sleep(K_MSEC(CACHE_UPDATE_TIME));
+	zassert_equal(bt_gatt_cache_mock_settings_cnt(), 0, "Cache not cleared");
+
+	zassert_not_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0,
+			  "Invalidated discovery restored from cache");
+}
+
+ZTEST(gatt_dm_cache, test_cache_resubscribe_on_new_connection)
+{
+	zassert_not_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0);
+
+	bt_gatt_cache_mock_disconnect();
+	zassert_false(bt_gatt_cache_mock_sc_subscribed());
+
+	/* Only the Service Changed characteristic and its CCC descriptor are
+	 * discovered.
+	 */
+	zassert_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 2);
+	zassert_true(bt_gatt_cache_mock_sc_subscribed(), "Service Changed not subscribed");
+}
+
+ZTEST(gatt_dm_cache, test_cache_lru_eviction)
+{
+	BUILD_ASSERT(CONFIG_BT_GATT_DM_CACHE_MAX_ENTRIES == 2, "Test assumes two cache entries");
+
+	zassert_not_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0);
+	zassert_not_equal(cache_run_dm(BT_UUID_BAS, BT_UUID_BAS_BATTERY_LEVEL), 0);
+
+	/* Restoring DIS makes BAS the least recently used entry */
+	zassert_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0);
+
+	zassert_not_equal(cache_run_dm(BT_UUID_HRS, BT_UUID_HRS_MEASUREMENT), 0);
+	zassert_equal(bt_gatt_cache_mock_settings_cnt(), 2, "Cache not bounded");
+
+	zassert_equal(cache_run_dm(BT_UUID_DIS, BT_UUID_DIS_MODEL_NUMBER), 0,
+		      "Recently used entry evicted");
+	zassert_equal(cache_run_dm(BT_UUID_HRS, BT_UUID_HRS_MEASUREMENT), 0,
+		      "New entry evicted");
+	zassert_not_equal(cache_run_dm(BT_UUID_BAS, BT_UUID_BAS_BATTERY_LEVEL), 0,
+			  "Least recently used entry not evicted");
+}
@@ -371,6 +371,38 @@ ZTEST(gatt_tests, test_gatt_HIDS_chrc_by_uuid)
 		      bt_gatt_dm_attr_cnt(dm));
 }
 
+ZTEST(gatt_tests, test_gatt_HIDS_chrc_next_from_desc)
+{
+	struct bt_gatt_dm *dm;
+	const struct bt_gatt_dm_attr *attr_chrc;
+
+	dm = run_dm(BT_UUID_HIDS);
+	zassert_not_null(dm, "Device Manager pointer not set");
+
+	/* Next characteristic after the service declaration */
+	attr_chrc = bt_gatt_dm_char_next(dm, bt_gatt_dm_attr_by_handle(dm, 1));
+	zassert_not_null(attr_chrc, "Unexpected NULL");
+	zassert_equal(2, attr_chrc->handle, "Unexpected handle: %d", attr_chrc->handle);
+
+	/* Next characteristic after a descriptor */
+	attr_chrc = bt_gatt_dm_char_next(dm, bt_gatt_dm_attr_by_handle(dm, 8));
+	zassert_not_null(attr_chrc, "Unexpected NULL");
+	zassert_equal(10, attr_chrc->handle, "Unexpected handle: %d", attr_chrc->handle);
+
+	/* No characteristic after the last descriptor */
+	attr_chrc = bt_gatt_dm_char_next(dm, bt_gatt_dm_attr_by_handle(dm, 11));
+	zassert_is_null(attr_chrc, "Expected NULL");
+
+	/* Last characteristic by UUID */
+	attr_chrc = bt_gatt_dm_char_by_uuid(dm, BT_UUID_HIDS_CTRL_POINT);
+	zassert_not_null(attr_chrc, "Unexpected NULL");
+	zassert_equal(10, attr_chrc->handle, "Unexpected handle: %d", attr_chrc->handle);
+
+	bt_gatt_dm_data_release(dm);
+	zassert_equal(0, bt_gatt_dm_attr_cnt(dm), "Parameter count after clearing: %d",
+		      bt_gatt_dm_attr_cnt(dm));
+}
+
 ZTEST(gatt_tests, test_gatt_generic_serv)
 {
 	struct bt_gatt_dm *dm;
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdint.h>
+#include <zephyr/ztest.h>
+#include <bluetooth/mesh/light_ctrl_reg_spec.h>
+
+#define REG_INT CONFIG_BT_MESH_LIGHT_CTRL_REG_SPEC_INTERVAL
+
+#define RANDOM_RUNS 500
+#define STEPS_PER_RUN 200
+#define STEPS_PER_MEASUREMENT 20
+
+/* Floating-point regulator evaluated in double precision, used as a reference
+ * for the fixed-point regulator. Single-precision floats accumulate rounding
+ * errors of several lightness levels in the internal sum, so the fixed-point
+ * regulator is compared against this instead.
+ */
+struct ref_reg {
+	struct bt_mesh_light_ctrl_reg_cfg cfg;
+	double target;
+	double measured;
+	double i;
+	bool neg;
+};
+
+static struct bt_mesh_light_ctrl_reg_spec spec_reg = BT_MESH_LIGHT_CTRL_REG_SPEC_INIT;
+static struct ref_reg ref_reg;
+static float reg_output;
+static uint32_t rand_state;
+
+static uint32_t rand_get(void)
+{
+	/* xorshift32, to get the same sequence on every run. */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static float rand_float_get(uint32_t max)
+{
+	return (rand_get() % (max * 100 + 1)) / 100.0f;
+}
+
+static void ref_terms_calc(double *i, double *p)
+{
+	double error = ref_reg.target - ref_reg.measured;
+	double accuracy = (ref_reg.cfg.accuracy * ref_reg.target) / (2 * 100.0);
+	double input;
+
+	if (error > accuracy) {
+		input = error - accuracy;
+	} else if (error < -accuracy) {
+		input = error + accuracy;
+	} else {
+		input = 0.0;
+	}
+
+	if (input >= 0) {
+		*i = input * ref_reg.cfg.ki.up * REG_INT / MSEC_PER_SEC;
+		*p = input * ref_reg.cfg.kp.up;
+	} else {
+		*i = input * ref_reg.cfg.ki.down * REG_INT / MSEC_PER_SEC;
+		*p = input * ref_reg.cfg.kp.down;
+	}
+}
+
+static uint16_t ref_step(void)
+{
+	double i, p;
+
+	ref_terms_calc(&i, &p);
+
+	ref_reg.i += i;
+	if (ref_reg.i >= 0) {
+		ref_reg.neg = false;
+	}
+
+	if (!ref_reg.neg) {
+		ref_reg.i = CLAMP(ref_reg.i, 0, UINT16_MAX);
+	}
+
+	return CLAMP(ref_reg.i + p, 0, UINT16_MAX);
+}
+
+static uint16_t reg_step(void)
+{
+	/* Run the step directly instead of waiting for the regulator timer. */
+	spec_reg.timer.work.handler(&spec_reg.timer.work);
+
+	return CLAMP(reg_output, 0, UINT16_MAX);
+}
+
+static void reg_updated(struct bt_mesh_light_ctrl_reg *reg, float output)
+{
+	reg_output = output;
+}
+
+static void measured_set(float measured)
+{
+	spec_reg.reg.measured = measured;
+	ref_reg.measured = measured;
+}
+
+static void reg_start(const struct bt_mesh_light_ctrl_reg_cfg *cfg, float target,
+		      float measured, uint16_t lightness)
+{
+	double i, p;
+
+	spec_reg.reg.cfg = *cfg;
+	bt_mesh_light_ctrl_reg_target_set(&spec_reg.reg, target, 0);
+	ref_reg.cfg = *cfg;
+	ref_reg.target = target;
+	measured_set(measured);
+
+	spec_reg.reg.start(&spec_reg.reg, lightness);
+
+	ref_terms_calc(&i, &p);
+	ref_reg.i = lightness - i;
+	ref_reg.neg = true;
+}
+
+static void steps_check(uint32_t steps)
+{
+	for (uint32_t step = 0; step < steps; step++) {
+		uint16_t expected = ref_step();
+		uint16_t output = reg_step();
+
+		zassert_within(output, expected, 1, "Step %u: expected %u, got %u", step, expected,
+			       output);
+	}
+}
+
+static void *reg_setup(void)
+{
+	spec_reg.reg.updated = reg_updated;
+	spec_reg.reg.init(&spec_reg.reg);
+
+	return NULL;
+}
+
+static void reg_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	rand_state = 0x4c43;
+}
+
+static void reg_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	spec_reg.reg.stop(&spec_reg.reg);
+}
+
+ZTEST(light_ctrl_reg_spec, test_default_cfg)
+{
+	const struct bt_mesh_light_ctrl_reg_cfg cfg = {
+		.ki = { .up = 250, .down = 25 },
+		.kp = { .up = 80, .down = 80 },
+		.accuracy = 2,
+	};
+
+	/* Approach the target from below, pass through the dead zone and
+	 * overshoot it.
+	 */
+	reg_start(&cfg, 500, 0, 1000);
+
+	for (float measured = 0; measured <= 600; measured += 10) {
+		measured_set(measured);
+		steps_check(STEPS_PER_MEASUREMENT);
+	}
+}
+
+ZTEST(light_ctrl_reg_spec, test_saturation)
+{
+	const struct bt_mesh_light_ctrl_reg_cfg cfg = {
+		.ki = { .up = 1000, .down = 1000 },
+		.kp = { .up = 1000, .down = 1000 },
+		.accuracy = 0,
+	};
+
+	/* Drive the internal sum to both ends of the lightness range. */
+	reg_start(&cfg, 167772, 0, 0);
+	steps_check(STEPS_PER_RUN);
+
+	reg_start(&cfg, 0, 167772.14f, UINT16_MAX);
+	steps_check(STEPS_PER_RUN);
+}
+
+ZTEST(light_ctrl_reg_spec, test_random_cfg)
+{
+	for (uint32_t run = 0; run < RANDOM_RUNS; run++) {
+		const struct bt_mesh_light_ctrl_reg_cfg cfg = {
+			.ki = { .up = rand_float_get(1000), .down = rand_float_get(1000) },
+			.kp = { .up = rand_float_get(1000), .down = rand_float_get(1000) },
+			.accuracy = rand_float_get(100),
+		};
+
+		reg_start(&cfg, rand_float_get(2000), rand_float_get(2000), rand_get());
+
+		for (uint32_t i = 0; i < STEPS_PER_RUN / STEPS_PER_MEASUREMENT; i++) {
+			measured_set(rand_float_get(2000));
+			steps_check(STEPS_PER_MEASUREMENT);
+		}
+
+		spec_reg.reg.stop(&spec_reg.reg);
+	}
+}
+
+ZTEST_SUITE(light_ctrl_reg_spec, NULL, reg_setup, reg_before, reg_after, NULL);
@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <bluetooth/mesh/models.h>
+
+#define TEST_SIG_MOD_ID 0x1300
+#define TEST_VND_COMPANY_ID 0x0059
+#define TEST_VND_MOD_ID 0x0001
+/* Too large for CONFIG_BT_MESH_SCENE_SRV_CACHE_SIZE along with the vendor data */
+#define SIG_DATA_MAX 16
+#define SIG_DATA_LEN 4
+#define VND_DATA_LEN 3
+#define PAGES_MAX 16
+#define PAGE_PATH_LEN 9
+
+/* A scene page stored by the Scene Server */
+struct stored_page {
+	char path[PAGE_PATH_LEN];
+	uint8_t data[SETTINGS_MAX_VAL_LEN];
+	size_t len;
+};
+
+/* Scene data of the test models */
+struct test_state {
+	uint8_t sig[SIG_DATA_MAX];
+	size_t sig_len;
+	uint8_t vnd[VND_DATA_LEN];
+};
+
+static struct bt_mesh_scene_srv scene_srv;
+
+static const struct bt_mesh_model sig_models[] = {
+	BT_MESH_MODEL_SCENE_SRV(&scene_srv),
+	BT_MESH_MODEL_CB(TEST_SIG_MOD_ID, BT_MESH_MODEL_NO_OPS, NULL, NULL, NULL),
+};
+
+static const struct bt_mesh_model vnd_models[] = {
+	BT_MESH_MODEL_VND_CB(TEST_VND_COMPANY_ID, TEST_VND_MOD_ID, BT_MESH_MODEL_NO_OPS, NULL,
+			     NULL, NULL),
+};
+
+static const struct bt_mesh_elem elems[] = {
+	BT_MESH_ELEM(1, sig_models, vnd_models),
+};
+
+static const struct bt_mesh_comp comp = {
+	.elem = elems,
+	.elem_count = ARRAY_SIZE(elems),
+};
+
+static const struct bt_mesh_model *const srv_mod = &sig_models[0];
+static const struct bt_mesh_model *const setup_mod = &sig_models[1];
+
+static struct stored_page pages[PAGES_MAX];
+static bool provisioned;
+/* Number of scenes loaded from storage when recalled */
+static int load_cnt;
+
+static struct test_state state;
+static struct test_state recalled;
+static int sig_recall_cnt;
+static int vnd_recall_cnt;
+static int recall_complete_cnt;
+
+/** Mocks ******************************************/
+
+const struct bt_mesh_comp *bt_mesh_comp_get(void)
+{
+	return &comp;
+}
+
+uint8_t bt_mesh_elem_count(void)
+{
+	return ARRAY_SIZE(elems);
+}
+
+const struct bt_mesh_elem *bt_mesh_model_elem(const struct bt_mesh_model *mod)
+{
+	return &elems[0];
+}
+
+const struct bt_mesh_model *bt_mesh_model_find(const struct bt_mesh_elem *elem, uint16_t id)
+{
+	for (int i = 0; i < elem->model_count; i++) {
+		if (elem->models[i].id == id) {
+			return &elem->models[i];
+		}
+	}
+
+	return NULL;
+}
+
+const struct bt_mesh_model *bt_mesh_model_find_vnd(const struct bt_mesh_elem *elem,
+						   uint16_t company, uint16_t id)
+{
+	for (int i = 0; i < elem->vnd_model_count; i++) {
+		if (elem->vnd_models[i].vnd.company == company &&
+		    elem->vnd_models[i].vnd.id == id) {
+			return &elem->vnd_models[i];
+		}
+	}
+
+	return NULL;
+}
+
+bool bt_mesh_model_is_extended(const struct bt_mesh_model *model)
+{
+	return false;
+}
+
+int bt_mesh_model_extend(const struct bt_mesh_model *extending_mod,
+			 const struct bt_mesh_model *base_mod)
+{
+	return 0;
+}
+
+struct bt_mesh_dtt_srv *bt_mesh_dtt_srv_get(const struct bt_mesh_elem *elem)
+{
+	return NULL;
+}
+
+bool bt_mesh_is_provisioned(void)
+{
+	return provisioned;
+}
+
+void bt_mesh_model_msg_init(struct net_buf_simple *msg, uint32_t opcode)
+{
+	net_buf_simple_init(msg, 0);
+	net_buf_simple_add_le16(msg, opcode);
+}
+
+int bt_mesh_msg_send(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *buf)
+{
+	return 0;
+}
+
+int bt_mesh_model_send(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		       struct net_buf_simple *msg, const struct bt_mesh_send_cb *cb,
+		       void *cb_data)
+{
+	return 0;
+}
+
+const char *bt_hex(const void *buf, size_t len)
+{
+	return "";
+}
+
+static struct stored_page *page_find(const char *path)
+{
+	for (int i = 0; i < ARRAY_SIZE(pages); i++) {
+		if (!strcmp(pages[i].path, path)) {
+			return &pages[i];
+		}
+	}
+
+	return NULL;
+}
+
+int bt_mesh_model_data_store(const struct bt_mesh_model *mod, bool vnd, const char *name,
+			     const void *data, size_t data_len)
+{
+	struct stored_page *page = page_find(name);
+
+	zassert_equal_ptr(mod, srv_mod);
+	zassert_true(data_len <= sizeof(page->data));
+
+	if (!data_len) {
+		if (page) {
+			memset(page, 0, sizeof(*page));
+		}
+
+		return 0;
+	}
+
+	if (!page) {
+		page = page_find("");
+		zassert_not_null(page, "Out of storage");
+		strcpy(page->path, name);
+	}
+
+	memcpy(page->data, data, data_len);
+	page->len = data_len;
+
+	return 0;
+}
+
+int settings_name_next(const char *name, const char **next)
+{
+	const char *sep = strchr(name, '/');
+
+	if (!sep) {
+		*next = NULL;
+		return strlen(name);
+	}
+
+	*next = sep + 1;
+	return sep - name;
+}
+
+static ssize_t page_read(void *cb_arg, void *data, size_t len)
+{
+	struct stored_page *page = cb_arg;
+
+	len = MIN(len, page->len);
+	memcpy(data, page->data, len);
+
+	return len;
+}
+
+static void page_load(struct stored_page *page)
+{
+	zassert_ok(srv_mod->cb->settings_set(srv_mod, page->path, page->len, page_read, page));
+}
+
+int settings_load_subtree(const char *subtree)
+{
+	char prefix[PAGE_PATH_LEN];
+	uint16_t scene;
+
+	/* The subtree of a recalled scene is "bt/mesh/s/<model>/data/<scene>" */
+	scene = strtol(strrchr(subtree, '/') + 1, NULL, 16);
+	snprintf(prefix, sizeof(prefix), "%x/", scene);
+	load_cnt++;
+
+	for (int i = 0; i < ARRAY_SIZE(pages); i++) {
+		if (!strncmp(pages[i].path, prefix, strlen(prefix))) {
+			page_load(&pages[i]);
+		}
+	}
+
+	return 0;
+}
+
+/** End Mocks **************************************/
+
+static ssize_t sig_store(const struct bt_mesh_model *model, uint8_t data[])
+{
+	memcpy(data, state.sig, state.sig_len);
+	return state.sig_len;
+}
+
+static void sig_recall(const struct bt_mesh_model *model, const uint8_t data[], size_t len,
+		       struct bt_mesh_model_transition *transition)
+{
+	zassert_true(len <= sizeof(recalled.sig));
+	memcpy(recalled.sig, data, len);
+	recalled.sig_len = len;
+	sig_recall_cnt++;
+}
+
+static ssize_t vnd_store(const struct bt_mesh_model *model, uint8_t data[])
+{
+	memcpy(data, state.vnd, sizeof(state.vnd));
+	return sizeof(state.vnd);
+}
+
+static void vnd_recall(const struct bt_mesh_model *model, const uint8_t data[], size_t len,
+		       struct bt_mesh_model_transition *transition)
+{
+	zassert_equal(len, sizeof(recalled.vnd));
+	memcpy(recalled.vnd, data, len);
+	vnd_recall_cnt++;
+}
+
+static void recall_complete(const struct bt_mesh_model *model)
+{
+	recall_complete_cnt++;
+}
+
+BT_MESH_SCENE_ENTRY_SIG(test) = {
+	.id.sig = TEST_SIG_MOD_ID,
+	.maxlen = SIG_DATA_MAX,
+	.store = sig_store,
+	.recall = sig_recall,
+	.recall_complete = recall_complete,
+};
+
+BT_MESH_SCENE_ENTRY_VND(test) = {
+	.id.vnd = {
+		.id = TEST_VND_MOD_ID,
+		.company = TEST_VND_COMPANY_ID,
+	},
+	.maxlen = VND_DATA_LEN,
+	.store = vnd_store,
+	.recall = vnd_recall,
+	.recall_complete = recall_complete,
+};
+
+/* Set the model states to data derived from the scene number */
+static void state_set(uint16_t scene, size_t sig_len)
+{
+	for (int i = 0; i < sig_len; i++) {
+		state.sig[i] = scene + i;
+	}
+
+	state.sig_len = sig_len;
+
+	for (int i = 0; i < sizeof(state.vnd); i++) {
+		state.vnd[i] = ~(scene + i);
+	}
+}
+
+static void setup_msg_send(uint32_t opcode, uint16_t scene)
+{
+	const struct bt_mesh_model_op *op;
+	struct bt_mesh_msg_ctx ctx = { 0 };
+
+	NET_BUF_SIMPLE_DEFINE(buf, 2);
+
+	net_buf_simple_add_le16(&buf, scene);
+
+	for (op = _bt_mesh_scene_setup_srv_op; op->func; op++) {
+		if (op->opcode == opcode) {
+			zassert_ok(op->func(setup_mod, &ctx, &buf));
+			return;
+		}
+	}
+
+	zassert_unreachable("No handler for opcode 0x%x", opcode);
+}
+
+static void scene_store(uint16_t scene, size_t sig_len)
+{
+	state_set(scene, sig_len);
+	setup_msg_send(BT_MESH_SCENE_OP_STORE_UNACK, scene);
+}
+
+static void scene_delete(uint16_t scene)
+{
+	setup_msg_send(BT_MESH_SCENE_OP_DELETE_UNACK, scene);
+}
+
+/* Recall a scene and check that the scene data of both models is recovered,
+ * from storage if from_storage is true and from the cache otherwise.
+ */
+static void scene_recall_verify(uint16_t scene, size_t sig_len, bool from_storage)
+{
+	memset(&recalled, 0, sizeof(recalled));
+	sig_recall_cnt = 0;
+	vnd_recall_cnt = 0;
+	recall_complete_cnt = 0;
+	load_cnt = 0;
+
+	zassert_ok(bt_mesh_scene_srv_set(&scene_srv, scene, NULL));
+	zassert_equal(bt_mesh_scene_srv_current_scene_get(&scene_srv), scene);
+
+	zassert_equal(load_cnt, from_storage ? 1 : 0, "Scene 0x%x %s", scene,
+		      from_storage ? "not loaded from storage" : "loaded from storage");
+	zassert_equal(sig_recall_cnt, 1);
+	zassert_equal(vnd_recall_cnt, 1);
+	zassert_equal(recall_complete_cnt, 2);
+
+	state_set(scene, sig_len);
+	zassert_equal(recalled.sig_len, sig_len);
+	zassert_mem_equal(recalled.sig, state.sig, sig_len, "Wrong SIG data of 0x%x", scene);
+	zassert_mem_equal(recalled.vnd, state.vnd, sizeof(state.vnd),
+			  "Wrong vendor data of 0x%x", scene);
+}
+
+/* Clear the Scene Server state kept in RAM and load the scenes from storage,
+ * as on startup.
+ */
+static void reboot(void)
+{
+	scene_srv.count = 0;
+	scene_srv.prev = BT_MESH_SCENE_NONE;
+	scene_srv.next = BT_MESH_SCENE_NONE;
+	scene_srv.sigpages = 0;
+	scene_srv.vndpages = 0;
+	memset(scene_srv.cache, 0, sizeof(scene_srv.cache));
+
+	provisioned = false;
+	for (int i = 0; i < ARRAY_SIZE(pages); i++) {
+		if (pages[i].len) {
+			page_load(&pages[i]);
+		}
+	}
+	provisioned = true;
+}
+
+static void *setup(void)
+{
+	zassert_ok(srv_mod->cb->init(srv_mod));
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	srv_mod->cb->reset(srv_mod);
+	memset(pages, 0, sizeof(pages));
+	provisioned = true;
+}
+
+ZTEST(scene_srv_test, test_recall_from_cache)
+{
+	scene_store(1, SIG_DATA_LEN);
+	scene_store(2, SIG_DATA_LEN);
+
+	scene_recall_verify(1, SIG_DATA_LEN, false);
+	scene_recall_verify(2, SIG_DATA_LEN, false);
+
+	/* Storing a scene again replaces its cached data */
+	scene_store(1, SIG_DATA_LEN - 1);
+	scene_recall_verify(2, SIG_DATA_LEN, false);
+	scene_recall_verify(1, SIG_DATA_LEN - 1, false);
+}
+
+ZTEST(scene_srv_test, test_recall_after_reboot)
+{
+	scene_store(1, SIG_DATA_LEN);
+	scene_store(2, SIG_DATA_LEN - 1);
+
+	/* The scene data is preloaded along with the scene register */
+	reboot();
+	zassert_equal(scene_srv.count, 2);
+
+	scene_recall_verify(2, SIG_DATA_LEN - 1, false);
+	scene_recall_verify(1, SIG_DATA_LEN, false);
+}
+
+ZTEST(scene_srv_test, test_uncached_scenes)
+{
+	scene_store(1, SIG_DATA_LEN);
+	scene_store(2, SIG_DATA_LEN);
+
+	/* All cache entries are in use */
+	scene_store(3, SIG_DATA_LEN);
+	scene_recall_verify(3, SIG_DATA_LEN, true);
+	scene_recall_verify(1, SIG_DATA_LEN, false);
+	scene_recall_verify(2, SIG_DATA_LEN, false);
+
+	/* Only as many scenes as fit in the cache are preloaded */
+	reboot();
+	zassert_equal(scene_srv.count, 3);
+	scene_recall_verify(3, SIG_DATA_LEN, true);
+	scene_recall_verify(1, SIG_DATA_LEN, false);
+	scene_recall_verify(2, SIG_DATA_LEN, false);
+
+	/* Deleting a scene frees its cache entry for the next stored scene */
+	scene_delete(1);
+	scene_recall_verify(3, SIG_DATA_LEN, true);
+	scene_store(3, SIG_DATA_LEN);
+	scene_recall_verify(2, SIG_DATA_LEN, false);
+	scene_recall_verify(3, SIG_DATA_LEN, false);
+}
+
+ZTEST(scene_srv_test, test_scene_too_large)
+{
+	scene_store(1, SIG_DATA_MAX);
+	scene_store(2, SIG_DATA_LEN);
+
+	/* Data that doesn't fit is recalled from storage */
+	scene_recall_verify(1, SIG_DATA_MAX, true);
+	scene_recall_verify(2, SIG_DATA_LEN, false);
+
+	reboot();
+	scene_recall_verify(1, SIG_DATA_MAX, true);
+	scene_recall_verify(2, SIG_DATA_LEN, false);
+
+	/* The cache entry is used again once the data fits */
+	scene_store(1, SIG_DATA_LEN);
+	scene_recall_verify(2, SIG_DATA_LEN, false);
+	scene_recall_verify(1, SIG_DATA_LEN, false);
+}
+
+ZTEST_SUITE(scene_srv_test, NULL, setup, before, NULL, NULL);
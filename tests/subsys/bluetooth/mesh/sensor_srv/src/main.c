@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bluetooth/mesh/sensor_srv.h>
+#include <bluetooth/mesh/properties.h>
+
+#define PUB_SENSORS_MAX 16
+#define PUB_VALUES(_values)                                                    \
+	((const struct bt_mesh_sensor_value(*)[CONFIG_BT_MESH_SENSOR_CHANNELS_MAX])(_values))
+
+static const struct bt_mesh_model mock_model;
+static struct bt_mesh_sensor_srv srv = { .model = &mock_model };
+
+static struct bt_mesh_sensor temp_sensor = {
+	.type = &bt_mesh_sensor_present_amb_temp,
+};
+static struct bt_mesh_sensor light_sensor = {
+	.type = &bt_mesh_sensor_present_amb_light_level,
+};
+
+static uint8_t sent_data[BT_MESH_TX_SDU_MAX];
+static size_t sent_len;
+static int sent_cnt;
+static int send_err;
+
+/** Mocks ******************************************/
+
+void bt_mesh_model_msg_init(struct net_buf_simple *msg, uint32_t opcode)
+{
+	net_buf_simple_init(msg, 0);
+	net_buf_simple_add_u8(msg, opcode);
+}
+
+int bt_mesh_msg_send(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *buf)
+{
+	zassert_equal_ptr(model, &mock_model);
+	zassert_true(buf->len <= sizeof(sent_data));
+
+	memcpy(sent_data, buf->data, buf->len);
+	sent_len = buf->len;
+	sent_cnt++;
+
+	return send_err;
+}
+
+int bt_mesh_model_send(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		       struct net_buf_simple *msg, const struct bt_mesh_send_cb *cb,
+		       void *cb_data)
+{
+	return 0;
+}
+
+int32_t bt_mesh_model_pub_period_get(const struct bt_mesh_model *mod)
+{
+	return 0;
+}
+
+int bt_mesh_model_extend(const struct bt_mesh_model *extending_mod,
+			 const struct bt_mesh_model *base_mod)
+{
+	return 0;
+}
+
+/** End Mocks **************************************/
+
+static void value_set(struct bt_mesh_sensor_value *value, const struct bt_mesh_sensor *sensor,
+		      int64_t micro)
+{
+	zassert_ok(bt_mesh_sensor_value_from_micro(sensor->type->channels[0].format, micro,
+						   value));
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(sent_data, 0, sizeof(sent_data));
+	sent_len = 0;
+	sent_cnt = 0;
+	send_err = 0;
+
+	memset(&temp_sensor.state.prev, 0, sizeof(temp_sensor.state.prev));
+	memset(&light_sensor.state.prev, 0, sizeof(light_sensor.state.prev));
+}
+
+ZTEST(sensor_srv_test, test_pub_multi)
+{
+	struct bt_mesh_sensor *const sensors[] = { &temp_sensor, &light_sensor };
+	struct bt_mesh_sensor_value values[2][CONFIG_BT_MESH_SENSOR_CHANNELS_MAX];
+	const uint8_t expected[] = {
+		BT_MESH_SENSOR_OP_STATUS,
+		/* Present ambient temperature, 1 byte: 21.5 C in 0.5 C steps */
+		0xe0, 0x09, 43,
+		/* Present ambient light level, 3 bytes: 123.45 lux in 0.01 lux steps */
+		0xc4, 0x09, 0x39, 0x30, 0x00,
+	};
+
+	value_set(&values[0][0], &temp_sensor, 21500000);
+	value_set(&values[1][0], &light_sensor, 123450000);
+
+	zassert_ok(bt_mesh_sensor_srv_pub_multi(&srv, NULL, sensors, PUB_VALUES(values),
+						ARRAY_SIZE(sensors)));
+
+	/* Both values are encoded in a single Sensor Status message */
+	zassert_equal(sent_cnt, 1);
+	zassert_equal(sent_len, sizeof(expected));
+	zassert_mem_equal(sent_data, expected, sizeof(expected));
+
+	zassert_mem_equal(&temp_sensor.state.prev, &values[0][0], sizeof(values[0][0]));
+	zassert_mem_equal(&light_sensor.state.prev, &values[1][0], sizeof(values[1][0]));
+}
+
+ZTEST(sensor_srv_test, test_pub_multi_matches_single)
+{
+	struct bt_mesh_sensor *const sensors[] = { &light_sensor };
+	struct bt_mesh_sensor_value values[1][CONFIG_BT_MESH_SENSOR_CHANNELS_MAX];
+	uint8_t single[BT_MESH_TX_SDU_MAX];
+	size_t single_len;
+
+	value_set(&values[0][0], &light_sensor, 500000000);
+
+	zassert_ok(bt_mesh_sensor_srv_pub(&srv, NULL, &light_sensor, values[0]));
+	memcpy(single, sent_data, sent_len);
+	single_len = sent_len;
+
+	zassert_ok(bt_mesh_sensor_srv_pub_multi(&srv, NULL, sensors, PUB_VALUES(values), 1));
+	zassert_equal(sent_cnt, 2);
+	zassert_equal(sent_len, single_len);
+	zassert_mem_equal(sent_data, single, single_len);
+}
+
+ZTEST(sensor_srv_test, test_pub_multi_too_long)
+{
+	struct bt_mesh_sensor *sensors[PUB_SENSORS_MAX];
+	struct bt_mesh_sensor_value values[PUB_SENSORS_MAX][CONFIG_BT_MESH_SENSOR_CHANNELS_MAX];
+	struct bt_mesh_sensor_value prev;
+	size_t count;
+	int err = 0;
+
+	for (int i = 0; i < PUB_SENSORS_MAX; i++) {
+		sensors[i] = &temp_sensor;
+		value_set(&values[i][0], &temp_sensor, 20000000);
+	}
+
+	/* Add sensors until the message, with its MIC, no longer fits in one SDU */
+	for (count = 1; count <= PUB_SENSORS_MAX; count++) {
+		sent_cnt = 0;
+		prev = temp_sensor.state.prev;
+
+		err = bt_mesh_sensor_srv_pub_multi(&srv, NULL, sensors, PUB_VALUES(values), count);
+		if (err) {
+			break;
+		}
+
+		zassert_equal(sent_cnt, 1);
+		zassert_true(sent_len + BT_MESH_MIC_SHORT <= BT_MESH_TX_SDU_MAX);
+
+		/* Reset the previous value to check that it's not updated on failure */
+		memset(&temp_sensor.state.prev, 0, sizeof(temp_sensor.state.prev));
+	}
+
+	zassert_true(count > 1, "A single sensor does not fit");
+	zassert_true(count <= PUB_SENSORS_MAX, "All sensors fit in one message");
+	zassert_equal(err, -ENOMEM);
+	zassert_equal(sent_cnt, 0, "Message sent when it does not fit");
+	zassert_mem_equal(&temp_sensor.state.prev, &prev, sizeof(prev));
+}
+
+ZTEST(sensor_srv_test, test_pub_multi_send_fail)
+{
+	struct bt_mesh_sensor *const sensors[] = { &temp_sensor, &light_sensor };
+	struct bt_mesh_sensor_value values[2][CONFIG_BT_MESH_SENSOR_CHANNELS_MAX];
+	struct bt_mesh_sensor_value temp_prev = temp_sensor.state.prev;
+	struct bt_mesh_sensor_value light_prev = light_sensor.state.prev;
+
+	value_set(&values[0][0], &temp_sensor, -5000000);
+	value_set(&values[1][0], &light_sensor, 1000000);
+
+	send_err = -EBUSY;
+	zassert_equal(bt_mesh_sensor_srv_pub_multi(&srv, NULL, sensors, PUB_VALUES(values),
+						   ARRAY_SIZE(sensors)), -EBUSY);
+
+	/* The previous values are only updated when published */
+	zassert_mem_equal(&temp_sensor.state.prev, &temp_prev, sizeof(temp_prev));
+	zassert_mem_equal(&light_sensor.state.prev, &light_prev, sizeof(light_prev));
+}
+
+ZTEST_SUITE(sensor_srv_test, NULL, NULL, before, NULL, NULL);
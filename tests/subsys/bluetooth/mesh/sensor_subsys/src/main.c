@@ -604,6 +604,50 @@ TEST_SCALAR_FORMAT(luminous_exposure,
 		   FORMAT_SPEC(3, 1, 3, 0, 0, 16777214000.0,
 			       SPECIAL(unknown, 0xFFFFFF)))
 
+/* Formats with a resolution of more than one unit round micro units to the closest
+ * step, both in the 32-bit and in the 64-bit division.
+ */
+static void check_kilo_format_rounding(const struct bt_mesh_sensor_format *format)
+{
+	static const struct {
+		int64_t micro;
+		uint32_t raw;
+	} vectors[] = {
+		{ 499999999, 0 },
+		{ 500000000, 1 },
+		{ 999999999, 1 },
+		{ 1000000000, 1 },
+		{ INT32_MAX / 2, 1 },
+		{ INT32_MAX / 2 + 1, 1 },
+		{ 1499999999, 1 },
+		{ 1500000000, 2 },
+		{ 1600000000, 2 },
+		{ 16777213499999999, 0xFFFFFD },
+		{ 16777213500000000, 0xFFFFFE },
+		{ -499999999, 0 },
+	};
+
+	for (int i = 0; i < ARRAY_SIZE(vectors); i++) {
+		check_from_micro(format, vectors[i].micro, 0, vectors[i].raw, true);
+	}
+
+	check_to_micro(format, 2, BT_MESH_SENSOR_VALUE_NUMBER, 2000000000, true);
+
+	/* Rounds to -1 and -2 steps, which are below the minimum of 0 */
+	check_from_micro(format, -500000000, -ERANGE, 0, true);
+	check_from_micro(format, -1600000000, -ERANGE, 0, true);
+}
+
+ZTEST(sensor_types_test, test_format_luminous_energy_rounding)
+{
+	check_kilo_format_rounding(&bt_mesh_sensor_format_luminous_energy);
+}
+
+ZTEST(sensor_types_test, test_format_luminous_exposure_rounding)
+{
+	check_kilo_format_rounding(&bt_mesh_sensor_format_luminous_exposure);
+}
+
 TEST_SCALAR_FORMAT(luminous_flux,
 		   FORMAT_SPEC(2, 1, 0, 0, 0, 65534,
 			       SPECIAL(unknown, 0xFFFF)))
@@ -975,4 +1019,23 @@ TEST_SENSOR_TYPE(rel_dev_runtime_in_a_generic_level_range, 0x0061,
 
 TEST_SENSOR_TYPE(total_dev_runtime, 0x006e, CHANNEL(time_hour_24, 3))
 
+ZTEST(sensor_types_test, test_type_lookup)
+{
+	const struct bt_mesh_sensor_type *prev = NULL;
+
+	/* The lookup relies on the types being sorted by ID at link time. */
+	STRUCT_SECTION_FOREACH(bt_mesh_sensor_type, type) {
+		if (prev) {
+			zassert_true(prev->id < type->id, "Type 0x%04x placed after 0x%04x",
+				     type->id, prev->id);
+		}
+
+		zassert_equal(bt_mesh_sensor_type_get(type->id), type);
+		prev = type;
+	}
+
+	zassert_is_null(bt_mesh_sensor_type_get(0x0000));
+	zassert_is_null(bt_mesh_sensor_type_get(0xffff));
+}
+
 ZTEST_SUITE(sensor_types_test, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gap.h>
+#include <zephyr/bluetooth/hci.h>
+#include <bluetooth/scan.h>
+
+#define TEST_NAME "Test"
+
+static struct bt_le_scan_cb *scan_cb;
+static struct bt_conn_cb *conn_cb;
+static bt_addr_le_t conn_dst;
+static size_t conn_create_cnt;
+
+static size_t match_cnt;
+static size_t no_match_cnt;
+static size_t connecting_error_cnt;
+static struct bt_scan_rssi_stats rssi_stats;
+
+static const uint8_t adv_name[] = {
+	sizeof(TEST_NAME), BT_DATA_NAME_COMPLETE, 'T', 'e', 's', 't'
+};
+
+static const uint8_t adv_other_name[] = {
+	sizeof(TEST_NAME), BT_DATA_NAME_COMPLETE, 'O', 't', 'h', 'r'
+};
+
+/* Wrapped versions of the Bluetooth host functions used by the library */
+int __wrap_bt_le_scan_cb_register(struct bt_le_scan_cb *cb)
+{
+	scan_cb = cb;
+
+	return 0;
+}
+
+int __wrap_bt_le_scan_start(const struct bt_le_scan_param *param, bt_le_scan_cb_t cb)
+{
+	return 0;
+}
+
+int __wrap_bt_le_scan_stop(void)
+{
+	return 0;
+}
+
+int __wrap_bt_conn_cb_register(struct bt_conn_cb *cb)
+{
+	conn_cb = cb;
+
+	return 0;
+}
+
+int __wrap_bt_conn_le_create(const bt_addr_le_t *peer,
+			     const struct bt_conn_le_create_param *create_param,
+			     const struct bt_le_conn_param *conn_param,
+			     struct bt_conn **conn)
+{
+	conn_create_cnt++;
+
+	/* Fail, so that no connection object is needed */
+	return -ENOMEM;
+}
+
+const bt_addr_le_t *__wrap_bt_conn_get_dst(const struct bt_conn *conn)
+{
+	return &conn_dst;
+}
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	match_cnt++;
+	rssi_stats = *device_info->rssi_stats;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	no_match_cnt++;
+	rssi_stats = *device_info->rssi_stats;
+}
+
+static void scan_connecting_error(struct bt_scan_device_info *device_info)
+{
+	connecting_error_cnt++;
+}
+
+BT_SCAN_CB_INIT(scan_test_cb, scan_filter_match, scan_filter_no_match,
+		scan_connecting_error, NULL);
+
+static void addr_get(uint16_t idx, bt_addr_le_t *addr)
+{
+	memset(addr, 0, sizeof(*addr));
+	addr->type = BT_ADDR_LE_RANDOM;
+	addr->a.val[0] = idx & 0xff;
+	addr->a.val[1] = idx >> 8;
+	/* Static random address */
+	addr->a.val[5] = 0xc0;
+}
+
+static void report_type(uint16_t idx, uint8_t adv_type, int8_t rssi,
+			const uint8_t *data, size_t len)
+{
+	struct bt_le_scan_recv_info info = {
+		.rssi = rssi,
+		.adv_type = adv_type,
+		.adv_props = BT_GAP_ADV_PROP_CONNECTABLE | BT_GAP_ADV_PROP_SCANNABLE,
+	};
+	struct net_buf_simple ad;
+	bt_addr_le_t addr;
+
+	if (adv_type == BT_GAP_ADV_TYPE_SCAN_RSP) {
+		info.adv_props |= BT_GAP_ADV_PROP_SCAN_RESPONSE;
+	}
+
+	addr_get(idx, &addr);
+	info.addr = &addr;
+	net_buf_simple_init_with_data(&ad, (void *)data, len);
+
+	scan_cb->recv(&info, &ad);
+}
+
+static void report(uint16_t idx, int8_t rssi, const uint8_t *data, size_t len)
+{
+	report_type(idx, BT_GAP_ADV_TYPE_ADV_IND, rssi, data, len);
+}
+
+static size_t report_cnt(void)
+{
+	return match_cnt + no_match_cnt;
+}
+
+static void scan_init(bool connect_if_match)
+{
+	struct bt_scan_init_param init = {
+		.connect_if_match = connect_if_match,
+	};
+
+	bt_scan_init(&init);
+}
+
+static void name_filter_enable(void)
+{
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, TEST_NAME));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER, false));
+}
+
+static void *scan_setup(void)
+{
+	bt_scan_cb_register(&scan_test_cb);
+
+	return NULL;
+}
+
+static void scan_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	scan_init(false);
+	bt_scan_filter_remove_all();
+	bt_scan_blocklist_clear();
+	bt_scan_conn_attempts_filter_clear();
+
+	conn_create_cnt = 0;
+	match_cnt = 0;
+	no_match_cnt = 0;
+	connecting_error_cnt = 0;
+	memset(&rssi_stats, 0, sizeof(rssi_stats));
+}
+
+ZTEST_SUITE(scan, NULL, scan_setup, scan_before, NULL, NULL);
+
+ZTEST(scan, test_dedup_window)
+{
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 1);
+	zassert_equal(rssi_stats.count, 1);
+
+	/* Unchanged reports are suppressed within the window */
+	report(0, -40, adv_name, sizeof(adv_name));
+	report(0, -60, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 1, "Unchanged report not suppressed");
+
+	k_sleep(K_MSEC(CONFIG_BT_SCAN_DEDUP_WINDOW_MS));
+
+	/* The next report aggregates the RSSI of the suppressed ones */
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 2, "Report suppressed after the window");
+	zassert_equal(rssi_stats.count, 3);
+	zassert_equal(rssi_stats.min, -60);
+	zassert_equal(rssi_stats.max, -40);
+	zassert_equal(rssi_stats.avg, -50);
+}
+
+ZTEST(scan, test_dedup_changed_data)
+{
+	report(0, -50, adv_name, sizeof(adv_name));
+	report(0, -50, adv_other_name, sizeof(adv_other_name));
+	zassert_equal(report_cnt(), 2, "Changed report suppressed");
+
+	/* The scan response is tracked separately from the advertising data */
+	report_type(0, BT_GAP_ADV_TYPE_SCAN_RSP, -50, adv_other_name, sizeof(adv_other_name));
+	zassert_equal(report_cnt(), 3, "Scan response suppressed");
+
+	report(0, -50, adv_other_name, sizeof(adv_other_name));
+	report_type(0, BT_GAP_ADV_TYPE_SCAN_RSP, -50, adv_other_name, sizeof(adv_other_name));
+	zassert_equal(report_cnt(), 3);
+
+	/* Other devices are reported */
+	report(1, -50, adv_other_name, sizeof(adv_other_name));
+	zassert_equal(report_cnt(), 4);
+}
+
+ZTEST(scan, test_dedup_eviction)
+{
+	BUILD_ASSERT(CONFIG_BT_SCAN_DEDUP_CACHE_SIZE == 4, "Test assumes four cache entries");
+
+	for (uint16_t i = 0; i < CONFIG_BT_SCAN_DEDUP_CACHE_SIZE; i++) {
+		report(i, -50, adv_name, sizeof(adv_name));
+	}
+
+	zassert_equal(report_cnt(), CONFIG_BT_SCAN_DEDUP_CACHE_SIZE);
+
+	/* Device 0 becomes the most recently seen one */
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 4);
+
+	/* The new device replaces the least recently seen device 1 */
+	report(4, -50, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 5);
+
+	report(0, -50, adv_name, sizeof(adv_name));
+	report(4, -50, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 5, "Recently seen device evicted");
+
+	/* Device 1 is reported again and replaces device 2 */
+	report(1, -50, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 6, "Evicted device suppressed");
+
+	report(3, -50, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 6);
+
+	report(2, -50, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 7, "Evicted device suppressed");
+}
+
+ZTEST(scan, test_dedup_connect_if_match)
+{
+	scan_init(true);
+	name_filter_enable();
+
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(match_cnt, 1);
+	zassert_equal(conn_create_cnt, 1);
+	zassert_equal(connecting_error_cnt, 1);
+
+	/* Unchanged reports that match still start the connection */
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(match_cnt, 2, "Matching report suppressed");
+	zassert_equal(conn_create_cnt, 2, "Connection not started");
+
+	/* Reports that do not match are suppressed */
+	report(1, -50, adv_other_name, sizeof(adv_other_name));
+	report(1, -50, adv_other_name, sizeof(adv_other_name));
+	zassert_equal(no_match_cnt, 1);
+	zassert_equal(conn_create_cnt, 2);
+
+	/* Without the automatic connection, matching reports are suppressed */
+	bt_scan_update_connect_if_match(false);
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(match_cnt, 2);
+}
+
+ZTEST(scan, test_dedup_filter_enabled_later)
+{
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(no_match_cnt, 1);
+
+	/* The device is connected to once it matches, even though its
+	 * report did not change.
+	 */
+	name_filter_enable();
+	bt_scan_update_connect_if_match(true);
+
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(match_cnt, 1, "Matching report suppressed");
+	zassert_equal(conn_create_cnt, 1, "Connection not started");
+}
+
+ZTEST(scan, test_blocklist)
+{
+	const uint16_t first = 0x100;
+	bt_addr_le_t addr;
+
+	for (uint16_t i = 0; i < CONFIG_BT_SCAN_BLOCKLIST_LEN; i++) {
+		addr_get(first + i, &addr);
+		zassert_ok(bt_scan_blocklist_device_add(&addr));
+	}
+
+	/* Devices already on the blocklist do not take more space */
+	addr_get(first, &addr);
+	zassert_ok(bt_scan_blocklist_device_add(&addr));
+
+	addr_get(first + CONFIG_BT_SCAN_BLOCKLIST_LEN, &addr);
+	zassert_equal(bt_scan_blocklist_device_add(&addr), -ENOMEM);
+
+	for (uint16_t i = 0; i < CONFIG_BT_SCAN_BLOCKLIST_LEN; i++) {
+		report(first + i, -50, adv_name, sizeof(adv_name));
+	}
+
+	zassert_equal(report_cnt(), 0, "Blocked device reported");
+
+	report(first + CONFIG_BT_SCAN_BLOCKLIST_LEN, -50, adv_name, sizeof(adv_name));
+	zassert_equal(report_cnt(), 1);
+
+	bt_scan_blocklist_clear();
+
+	for (uint16_t i = 0; i < CONFIG_BT_SCAN_BLOCKLIST_LEN; i++) {
+		report(first + i, -50, adv_name, sizeof(adv_name));
+	}
+
+	zassert_equal(report_cnt(), 1 + CONFIG_BT_SCAN_BLOCKLIST_LEN,
+		      "Device reported after the blocklist was cleared");
+}
+
+ZTEST(scan, test_conn_attempts_filter)
+{
+	struct bt_conn *conn = (struct bt_conn *)&conn_dst;
+
+	scan_init(true);
+	name_filter_enable();
+
+	addr_get(0, &conn_dst);
+
+	for (int i = 0; i < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT; i++) {
+		report(0, -50, adv_name, sizeof(adv_name));
+		conn_cb->connected(conn, BT_HCI_ERR_UNKNOWN_CONN_ID);
+	}
+
+	zassert_equal(conn_create_cnt, CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT);
+
+	/* The device is filtered out after the failed attempts */
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(conn_create_cnt, CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT);
+	zassert_equal(match_cnt, CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT, "Filtered device reported");
+
+	report(1, -50, adv_name, sizeof(adv_name));
+	zassert_equal(conn_create_cnt, CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT + 1);
+
+	/* Connections to other devices replace the oldest filtered device */
+	for (uint16_t i = 1; i <= CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN; i++) {
+		addr_get(i, &conn_dst);
+		conn_cb->connected(conn, 0);
+	}
+
+	report(0, -50, adv_name, sizeof(adv_name));
+	zassert_equal(conn_create_cnt, CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT + 2,
+		      "Replaced device still filtered");
+
+	/* The other devices have no failed attempts */
+	for (uint16_t i = 1; i <= CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN; i++) {
+		report(i, -50, adv_name, sizeof(adv_name));
+	}
+
+	zassert_equal(conn_create_cnt,
+		      CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT + 2 + CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN);
+}
@@ -171,13 +171,49 @@ static void prepare(void)
 	zassert_true(emds_is_ready(), "EMDS should be ready");
 }
 
-static void store(int idx)
+/* Store time of all entries in a full snapshot */
+static uint32_t store_time_full_get(void)
 {
-	zassert_true(emds_is_ready(), "Store should be ready to execute");
+	size_t store_size;
+	uint32_t words;
+
+	zassert_equal(emds_store_size_get(&store_size), 0, "Getting store size failed");
+
+	words = DIV_ROUND_UP(store_size, 4) +
+		DIV_ROUND_UP(sizeof(struct emds_snapshot_metadata), 4);
+
+	return words * CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US +
+	       DIV_ROUND_UP(store_size, 16) * CONFIG_EMDS_CHUNK_PREPARATION_TIME_US;
+}
+
+/* The estimate covers only the changed entries, so it must not exceed the full snapshot */
+static void store_time_check(int idx)
+{
+	uint32_t before_us;
+	uint32_t after_us;
+
+	zassert_equal(emds_store_time_get(&before_us), 0, "Getting store time failed");
 
 	memcpy(d_data, &expect_d_data[idx][0][0], sizeof(d_data));
 	memcpy(s_data, &expect_s_data[idx][0], sizeof(s_data));
 
+	zassert_equal(emds_store_time_get(&after_us), 0, "Getting store time failed");
+
+#if CONFIG_EMDS_INCREMENTAL
+	zassert_true(before_us <= after_us, "Estimate dropped when entries changed");
+	zassert_true(after_us <= store_time_full_get(), "Estimate above the full snapshot");
+#else
+	zassert_equal(before_us, after_us, "Estimate depends on the entry data");
+	zassert_equal(after_us, store_time_full_get(), "Wrong estimate");
+#endif
+}
+
+static void store(int idx)
+{
+	zassert_true(emds_is_ready(), "Store should be ready to execute");
+
+	store_time_check(idx);
+
 #if defined(CONFIG_BT) && !defined(CONFIG_BT_LL_SW_SPLIT)
 	/* Disable bluetooth and mpsl scheduler if bluetooth is enabled. */
 	(void) sdc_disable(); // Replace with bt_disable when added.
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <cJSON.h>
+#include <date_time.h>
+#include <net/nrf_cloud_coap.h>
+#include "nrf_cloud_coap_transport.h"
+
+LOG_MODULE_REGISTER(nrf_cloud_coap, CONFIG_NRF_CLOUD_COAP_LOG_LEVEL);
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(bool, nrf_cloud_coap_is_connected);
+FAKE_VALUE_FUNC(int, date_time_now, int64_t *);
+FAKE_VALUE_FUNC(int, nrf_cloud_coap_post, const char *, const char *, const uint8_t *, size_t,
+		enum coap_content_format, bool, coap_client_response_cb_t, void *);
+
+#define TEST_TS 1700000000123LL
+#define PRODUCER_STACK_SIZE 2048
+#define PRODUCER_PRIO 5
+
+static char sent_rsc[32];
+static char sent_buf[CONFIG_NRF_CLOUD_COAP_QUEUE_SIZE + 2];
+static enum coap_content_format sent_fmt;
+static int post_result;
+
+static K_THREAD_STACK_DEFINE(producer_stack, PRODUCER_STACK_SIZE);
+static struct k_thread producer_thread;
+static K_SEM_DEFINE(producer_done, 0, 1);
+static int producer_err;
+
+static int post_record(const char *resource, const char *query, const uint8_t *buf, size_t len,
+		       enum coap_content_format fmt, bool reliable,
+		       coap_client_response_cb_t cb, void *user)
+{
+	zassert_true(len < sizeof(sent_buf), "Payload too long");
+
+	strncpy(sent_rsc, resource, sizeof(sent_rsc) - 1);
+	memcpy(sent_buf, buf, len);
+	sent_buf[len] = '\0';
+	sent_fmt = fmt;
+
+	return post_result;
+}
+
+static void producer_fn(void *p1, void *p2, void *p3)
+{
+	producer_err = nrf_cloud_coap_sensor_queue("HUMID", 40, TEST_TS + 1);
+	k_sem_give(&producer_done);
+}
+
+/* Queue a message from another thread while the request is in progress. This only
+ * completes if the queue is not locked during network I/O.
+ */
+static int post_with_producer(const char *resource, const char *query, const uint8_t *buf,
+			      size_t len, enum coap_content_format fmt, bool reliable,
+			      coap_client_response_cb_t cb, void *user)
+{
+	k_thread_create(&producer_thread, producer_stack, K_THREAD_STACK_SIZEOF(producer_stack),
+			producer_fn, NULL, NULL, NULL, PRODUCER_PRIO, 0, K_NO_WAIT);
+
+	zassert_ok(k_sem_take(&producer_done, K_SECONDS(1)), "Queue locked during the request");
+	zassert_ok(producer_err);
+
+	return post_record(resource, query, buf, len, fmt, reliable, cb, user);
+}
+
+static cJSON *sent_array_get(int expected_cnt)
+{
+	cJSON *array = cJSON_Parse(sent_buf);
+
+	zassert_not_null(array, "Payload is not JSON: %s", sent_buf);
+	zassert_true(cJSON_IsArray(array));
+	zassert_equal(cJSON_GetArraySize(array), expected_cnt);
+
+	return array;
+}
+
+static void msg_check(cJSON *msg, const char *app_id, int64_t ts)
+{
+	cJSON *item;
+
+	item = cJSON_GetObjectItem(msg, NRF_CLOUD_JSON_APPID_KEY);
+	zassert_true(cJSON_IsString(item));
+	zassert_str_equal(item->valuestring, app_id);
+
+	item = cJSON_GetObjectItem(msg, NRF_CLOUD_JSON_MSG_TYPE_KEY);
+	zassert_true(cJSON_IsString(item));
+	zassert_str_equal(item->valuestring, NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA);
+
+	item = cJSON_GetObjectItem(msg, NRF_CLOUD_MSG_TIMESTAMP_KEY);
+	zassert_true(cJSON_IsNumber(item));
+	zassert_equal((int64_t)item->valuedouble, ts);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	RESET_FAKE(nrf_cloud_coap_is_connected);
+	RESET_FAKE(date_time_now);
+	RESET_FAKE(nrf_cloud_coap_post);
+
+	/* Empty the queue left by the previous test */
+	nrf_cloud_coap_is_connected_fake.return_val = true;
+	nrf_cloud_coap_post_fake.return_val = 0;
+	(void)nrf_cloud_coap_queue_flush(true);
+
+	RESET_FAKE(nrf_cloud_coap_post);
+	nrf_cloud_coap_post_fake.custom_fake = post_record;
+	post_result = 0;
+	memset(sent_buf, 0, sizeof(sent_buf));
+}
+
+ZTEST(nrf_cloud_coap_queue, test_flush_sends_json_array)
+{
+	cJSON *array;
+	cJSON *item;
+
+	zassert_ok(nrf_cloud_coap_sensor_queue("TEMP", 21.5, TEST_TS));
+	zassert_ok(nrf_cloud_coap_message_queue("LOG", "hello", TEST_TS + 1));
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 0, "Sent before the flush");
+
+	zassert_ok(nrf_cloud_coap_queue_flush(true));
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 1);
+	zassert_str_equal(sent_rsc, COAP_D2C_BULK_RSC);
+	zassert_equal(sent_fmt, COAP_CONTENT_FORMAT_APP_JSON);
+
+	array = sent_array_get(2);
+
+	msg_check(cJSON_GetArrayItem(array, 0), "TEMP", TEST_TS);
+	item = cJSON_GetObjectItem(cJSON_GetArrayItem(array, 0), NRF_CLOUD_JSON_DATA_KEY);
+	zassert_true(cJSON_IsNumber(item));
+	zassert_within(item->valuedouble, 21.5, 0.001);
+
+	msg_check(cJSON_GetArrayItem(array, 1), "LOG", TEST_TS + 1);
+	item = cJSON_GetObjectItem(cJSON_GetArrayItem(array, 1), NRF_CLOUD_JSON_DATA_KEY);
+	zassert_true(cJSON_IsString(item));
+	zassert_str_equal(item->valuestring, "hello");
+
+	cJSON_Delete(array);
+
+	/* Sent messages are removed */
+	zassert_ok(nrf_cloud_coap_queue_flush(true));
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 1);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_timestamp_from_date_time)
+{
+	cJSON *array;
+
+	date_time_now_fake.return_val = -ENODATA;
+	zassert_equal(nrf_cloud_coap_sensor_queue("TEMP", 1, NRF_CLOUD_NO_TIMESTAMP), -ENODATA);
+
+	date_time_now_fake.return_val = 0;
+	zassert_ok(nrf_cloud_coap_sensor_queue("TEMP", 1, NRF_CLOUD_NO_TIMESTAMP));
+	zassert_equal(date_time_now_fake.call_count, 2);
+
+	zassert_ok(nrf_cloud_coap_queue_flush(true));
+	array = sent_array_get(1);
+	cJSON_Delete(array);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_failed_flush_keeps_messages)
+{
+	cJSON *array;
+
+	zassert_ok(nrf_cloud_coap_sensor_queue("TEMP", 1, TEST_TS));
+
+	post_result = -ETIMEDOUT;
+	zassert_equal(nrf_cloud_coap_queue_flush(true), -ETIMEDOUT);
+
+	zassert_ok(nrf_cloud_coap_sensor_queue("TEMP", 2, TEST_TS + 1));
+
+	post_result = 0;
+	zassert_ok(nrf_cloud_coap_queue_flush(true));
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 2);
+
+	array = sent_array_get(2);
+	msg_check(cJSON_GetArrayItem(array, 0), "TEMP", TEST_TS);
+	msg_check(cJSON_GetArrayItem(array, 1), "TEMP", TEST_TS + 1);
+	cJSON_Delete(array);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_queue_during_flush)
+{
+	cJSON *array;
+
+	zassert_ok(nrf_cloud_coap_sensor_queue("TEMP", 1, TEST_TS));
+
+	nrf_cloud_coap_post_fake.custom_fake = post_with_producer;
+	zassert_ok(nrf_cloud_coap_queue_flush(true));
+
+	/* Only the message queued before the request was sent */
+	array = sent_array_get(1);
+	msg_check(cJSON_GetArrayItem(array, 0), "TEMP", TEST_TS);
+	cJSON_Delete(array);
+
+	nrf_cloud_coap_post_fake.custom_fake = post_record;
+	zassert_ok(nrf_cloud_coap_queue_flush(true));
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 2);
+
+	array = sent_array_get(1);
+	msg_check(cJSON_GetArrayItem(array, 0), "HUMID", TEST_TS + 1);
+	cJSON_Delete(array);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_failed_flush_keeps_messages_queued_during_it)
+{
+	cJSON *array;
+
+	zassert_ok(nrf_cloud_coap_sensor_queue("TEMP", 1, TEST_TS));
+
+	post_result = -ETIMEDOUT;
+	nrf_cloud_coap_post_fake.custom_fake = post_with_producer;
+	zassert_equal(nrf_cloud_coap_queue_flush(true), -ETIMEDOUT);
+
+	post_result = 0;
+	nrf_cloud_coap_post_fake.custom_fake = post_record;
+	zassert_ok(nrf_cloud_coap_queue_flush(true));
+
+	array = sent_array_get(2);
+	msg_check(cJSON_GetArrayItem(array, 0), "TEMP", TEST_TS);
+	msg_check(cJSON_GetArrayItem(array, 1), "HUMID", TEST_TS + 1);
+	cJSON_Delete(array);
+}
+
+ZTEST(nrf_cloud_coap_queue, test_full_queue_flushes_when_connected)
+{
+	int i;
+
+	for (i = 0; (i < 20) && (nrf_cloud_coap_post_fake.call_count == 0); i++) {
+		zassert_ok(nrf_cloud_coap_sensor_queue("TEMP", i, TEST_TS + i));
+	}
+
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 1, "Full queue was not sent");
+
+	/* The message that did not fit is kept for the next flush */
+	cJSON_Delete(sent_array_get(i - 1));
+	zassert_ok(nrf_cloud_coap_queue_flush(true));
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 2);
+	cJSON_Delete(sent_array_get(1));
+}
+
+ZTEST(nrf_cloud_coap_queue, test_full_queue_rejects_when_disconnected)
+{
+	int err = 0;
+
+	nrf_cloud_coap_is_connected_fake.return_val = false;
+
+	for (int i = 0; (i < 20) && !err; i++) {
+		err = nrf_cloud_coap_sensor_queue("TEMP", i, TEST_TS + i);
+	}
+
+	zassert_equal(err, -ENOBUFS);
+	zassert_equal(nrf_cloud_coap_post_fake.call_count, 0);
+	zassert_equal(nrf_cloud_coap_queue_flush(true), -EACCES);
+}
+
+ZTEST_SUITE(nrf_cloud_coap_queue, NULL, NULL, before, NULL, NULL);
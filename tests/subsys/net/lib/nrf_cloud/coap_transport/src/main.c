@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net/coap.h>
+#include <zephyr/net/coap_client.h>
+#include <net/nrf_cloud_coap.h>
+
+#define TEST_RSC "msg/d2c"
+#define THREAD_CNT 3
+#define THREAD_STACK_SIZE 2048
+#define THREAD_PRIO 5
+#define REQ_CNT 4
+
+/* A request passed to the CoAP client, answered by the test */
+struct req_record {
+	bool active;
+	struct coap_client_request *req;
+	coap_client_response_cb_t cb;
+	void *user_data;
+};
+
+struct transfer_thread {
+	struct k_thread thread;
+	struct k_sem done;
+	bool started;
+	int err;
+};
+
+static const uint8_t payload[] = "{\"appId\":\"TEMP\",\"messageType\":\"DATA\",\"data\":21}";
+
+static struct req_record reqs[REQ_CNT];
+static K_MUTEX_DEFINE(reqs_mut);
+static K_SEM_DEFINE(req_sem, 0, REQ_CNT);
+/* Number of cancelled requests whose transfer context was in use by another request */
+static int ctx_reused_cnt;
+/* Called once when the next request is cancelled */
+static void (*cancel_hook)(void);
+
+static struct transfer_thread threads[THREAD_CNT];
+static K_THREAD_STACK_ARRAY_DEFINE(thread_stacks, THREAD_CNT, THREAD_STACK_SIZE);
+
+int __wrap_coap_client_req(struct coap_client *client, int sock, const struct sockaddr *addr,
+			   struct coap_client_request *req,
+			   struct coap_transmission_parameters *params)
+{
+	int err = -EAGAIN;
+
+	k_mutex_lock(&reqs_mut, K_FOREVER);
+	for (int i = 0; i < ARRAY_SIZE(reqs); i++) {
+		if (!reqs[i].active && !reqs[i].req) {
+			reqs[i].active = true;
+			reqs[i].req = req;
+			reqs[i].cb = req->cb;
+			reqs[i].user_data = req->user_data;
+			err = 0;
+			break;
+		}
+	}
+	k_mutex_unlock(&reqs_mut);
+
+	if (!err) {
+		k_sem_give(&req_sem);
+	}
+
+	return err;
+}
+
+void __wrap_coap_client_cancel_request(struct coap_client *client,
+				       struct coap_client_request *req)
+{
+	void (*hook)(void) = cancel_hook;
+
+	if (hook) {
+		cancel_hook = NULL;
+		hook();
+	}
+
+	k_mutex_lock(&reqs_mut, K_FOREVER);
+	for (int i = 0; i < ARRAY_SIZE(reqs); i++) {
+		if (!reqs[i].active) {
+			continue;
+		}
+
+		if (reqs[i].req == req) {
+			reqs[i].active = false;
+		} else if (reqs[i].user_data == req->user_data) {
+			ctx_reused_cnt++;
+		}
+	}
+	k_mutex_unlock(&reqs_mut);
+}
+
+/* Answer a request as the server would */
+static void req_complete(int idx)
+{
+	zassert_true(reqs[idx].active, "Request %d not outstanding", idx);
+
+	reqs[idx].cb(COAP_RESPONSE_CODE_CHANGED, 0, NULL, 0, true, reqs[idx].user_data);
+}
+
+static void req_wait(int cnt)
+{
+	for (int i = 0; i < cnt; i++) {
+		zassert_ok(k_sem_take(&req_sem, K_SECONDS(1)), "Request %d not sent", i);
+	}
+}
+
+static void post_fn(void *p1, void *p2, void *p3)
+{
+	struct transfer_thread *t = p1;
+
+	t->err = nrf_cloud_coap_post(TEST_RSC, NULL, payload, sizeof(payload) - 1,
+				     COAP_CONTENT_FORMAT_APP_JSON, true, NULL, NULL);
+	k_sem_give(&t->done);
+}
+
+static void resume_fn(void *p1, void *p2, void *p3)
+{
+	struct transfer_thread *t = p1;
+
+	t->err = nrf_cloud_coap_resume();
+	k_sem_give(&t->done);
+}
+
+static void thread_start(int idx, k_thread_entry_t fn, int prio)
+{
+	threads[idx].started = true;
+	k_thread_create(&threads[idx].thread, thread_stacks[idx],
+			K_THREAD_STACK_SIZEOF(thread_stacks[idx]), fn, &threads[idx], NULL, NULL,
+			prio, 0, K_NO_WAIT);
+}
+
+static void thread_done_wait(int idx)
+{
+	zassert_ok(k_sem_take(&threads[idx].done, K_SECONDS(1)), "Thread %d blocked", idx);
+}
+
+static bool thread_is_done(int idx, k_timeout_t timeout)
+{
+	return k_sem_take(&threads[idx].done, timeout) == 0;
+}
+
+/* Start a transfer from a thread of higher priority, which runs before the cancelling
+ * thread continues.
+ */
+static void start_transfer_on_cancel(void)
+{
+	thread_start(1, post_fn, THREAD_PRIO - 1);
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(reqs, 0, sizeof(reqs));
+	k_sem_reset(&req_sem);
+	ctx_reused_cnt = 0;
+	cancel_hook = NULL;
+
+	for (int i = 0; i < THREAD_CNT; i++) {
+		k_sem_init(&threads[i].done, 0, 1);
+		threads[i].started = false;
+		threads[i].err = -EINPROGRESS;
+	}
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Release transfers left by a failed test */
+	for (int i = 0; i < ARRAY_SIZE(reqs); i++) {
+		if (reqs[i].active) {
+			req_complete(i);
+		}
+	}
+
+	for (int i = 0; i < THREAD_CNT; i++) {
+		if (threads[i].started) {
+			(void)k_thread_join(&threads[i].thread, K_SECONDS(1));
+		}
+	}
+}
+
+ZTEST(nrf_cloud_coap_transport, test_overlapping_transfers)
+{
+	thread_start(0, post_fn, THREAD_PRIO);
+	thread_start(1, post_fn, THREAD_PRIO);
+
+	/* Both requests are outstanding at the same time, each with its own context */
+	req_wait(2);
+	zassert_not_equal(reqs[0].user_data, reqs[1].user_data, "Context shared");
+
+	req_complete(1);
+	thread_done_wait(1);
+	zassert_ok(threads[1].err);
+	zassert_false(thread_is_done(0, K_NO_WAIT), "Transfer completed without a response");
+
+	req_complete(0);
+	thread_done_wait(0);
+	zassert_ok(threads[0].err);
+
+	zassert_equal(ctx_reused_cnt, 0, "Request cancelled in a reused context");
+}
+
+ZTEST(nrf_cloud_coap_transport, test_state_lock_waits_for_transfers)
+{
+	thread_start(0, post_fn, THREAD_PRIO);
+	thread_start(1, post_fn, THREAD_PRIO);
+	req_wait(2);
+
+	/* The client is not connected, so resuming fails once it gets the state */
+	thread_start(2, resume_fn, THREAD_PRIO);
+	zassert_false(thread_is_done(2, K_MSEC(100)), "State changed during transfers");
+
+	req_complete(0);
+	thread_done_wait(0);
+	zassert_false(thread_is_done(2, K_MSEC(100)), "State changed during a transfer");
+
+	req_complete(1);
+	thread_done_wait(1);
+	thread_done_wait(2);
+	zassert_equal(threads[2].err, -EACCES);
+
+	zassert_ok(threads[0].err);
+	zassert_ok(threads[1].err);
+}
+
+ZTEST(nrf_cloud_coap_transport, test_context_kept_until_cancelled)
+{
+	thread_start(0, post_fn, THREAD_PRIO);
+	req_wait(1);
+
+	/* The second transfer takes a context while the first one is being cancelled */
+	cancel_hook = start_transfer_on_cancel;
+	req_complete(0);
+	thread_done_wait(0);
+	zassert_ok(threads[0].err);
+
+	req_wait(1);
+	zassert_not_equal(reqs[0].user_data, reqs[1].user_data, "Context taken before cancel");
+	zassert_equal(ctx_reused_cnt, 0, "Request cancelled in a reused context");
+
+	req_complete(1);
+	thread_done_wait(1);
+	zassert_ok(threads[1].err);
+}
+
+ZTEST_SUITE(nrf_cloud_coap_transport, NULL, NULL, before, after, NULL);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <cJSON.h>
+#include <net/nrf_cloud_codec.h>
+#include "nrf_cloud_codec_internal.h"
+#include "nrf_cloud_mem.h"
+
+#define TOPIC_SIZE 64
+#define NODE_CNT 100
+
+/* Encode and free one message, like the library does for each message it sends.
+ * Returns the address of the root cJSON node of the message.
+ */
+static void *msg_cycle(bool free_with_nrf_cloud_free)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(msg_obj);
+	void *root;
+
+	zassert_ok(nrf_cloud_obj_msg_init(&msg_obj, "TEMP", NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA));
+	zassert_ok(nrf_cloud_obj_num_add(&msg_obj, NRF_CLOUD_JSON_DATA_KEY, 21.5, false));
+	zassert_ok(nrf_cloud_obj_ts_add(&msg_obj, 1700000000000LL));
+	zassert_ok(nrf_cloud_obj_cloud_encode(&msg_obj));
+
+	root = msg_obj.json;
+
+	if (free_with_nrf_cloud_free) {
+		/* Several transports free printed messages with nrf_cloud_free() */
+		nrf_cloud_free((void *)msg_obj.encoded_data.ptr);
+		msg_obj.encoded_data.ptr = NULL;
+	} else {
+		zassert_ok(nrf_cloud_obj_cloud_encoded_free(&msg_obj));
+	}
+
+	zassert_ok(nrf_cloud_obj_free(&msg_obj));
+
+	return root;
+}
+
+ZTEST(nrf_cloud_mem_arena, test_rewind_with_long_lived_allocations)
+{
+	void *first;
+	/* Like the MQTT topics allocated while the device is connected */
+	void *topic = nrf_cloud_malloc(TOPIC_SIZE);
+
+	zassert_not_null(topic);
+
+	first = msg_cycle(false);
+
+	for (int i = 0; i < 10; i++) {
+		zassert_equal_ptr(msg_cycle(false), first, "Arena not rewound after message %d", i);
+	}
+
+	nrf_cloud_free(topic);
+}
+
+ZTEST(nrf_cloud_mem_arena, test_live_message_keeps_arena)
+{
+	NRF_CLOUD_OBJ_JSON_DEFINE(live_obj);
+	void *first = msg_cycle(false);
+
+	zassert_ok(nrf_cloud_obj_msg_init(&live_obj, "HUMID", NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA));
+	zassert_equal_ptr(live_obj.json, first);
+
+	/* The live message is not overwritten */
+	zassert_not_equal(msg_cycle(false), first);
+	zassert_not_null(cJSON_GetObjectItem(live_obj.json, NRF_CLOUD_JSON_APPID_KEY));
+	zassert_str_equal(cJSON_GetObjectItem(live_obj.json, NRF_CLOUD_JSON_APPID_KEY)->valuestring,
+			  "HUMID");
+
+	zassert_ok(nrf_cloud_obj_free(&live_obj));
+	zassert_equal_ptr(msg_cycle(false), first, "Arena not rewound after the live message");
+}
+
+ZTEST(nrf_cloud_mem_arena, test_nrf_cloud_free_returns_to_arena)
+{
+	void *first = msg_cycle(true);
+
+	zassert_equal_ptr(msg_cycle(true), first);
+	zassert_equal_ptr(msg_cycle(false), first);
+}
+
+ZTEST(nrf_cloud_mem_arena, test_full_arena_falls_back)
+{
+	void *first = msg_cycle(false);
+	cJSON *array = cJSON_CreateArray();
+
+	zassert_not_null(array);
+
+	/* More nodes than fit into the arena */
+	for (int i = 0; i < NODE_CNT; i++) {
+		cJSON *num = cJSON_CreateNumber(i);
+
+		zassert_not_null(num, "Allocation %d failed", i);
+		zassert_true(cJSON_AddItemToArray(array, num));
+	}
+
+	zassert_equal(cJSON_GetArraySize(array), NODE_CNT);
+	cJSON_Delete(array);
+
+	zassert_equal_ptr(msg_cycle(false), first);
+}
+
+static void *setup(void)
+{
+	/* Installs the arena as the cJSON hooks, as nrf_cloud_init() does */
+	zassert_ok(nrf_cloud_codec_init(NULL));
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_cloud_mem_arena, NULL, setup, NULL, NULL, NULL);
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zcbor_decode.h>
+#include <net/nrf_cloud_codec.h>
+
+#define MSG_BUF_SIZE 128
+#define MSG_TS 1700000000123LL
+
+/* Keys of the message_out type in nrf_cloud_coap_device_msg.cddl */
+#define KEY_APP_ID 1
+#define KEY_DATA 2
+#define KEY_TS 3
+#define KEY_LAT 4
+#define KEY_LNG 5
+#define KEY_ACC 6
+#define KEY_SPD 7
+#define KEY_HDG 8
+#define KEY_ALT 9
+
+enum data_choice {
+	DATA_TSTR,
+	DATA_FLOAT,
+	DATA_INT,
+	DATA_PVT,
+};
+
+/* A message_out decoded as strictly as the zcbor code generated from the schema does */
+struct msg_out {
+	char app_id[16];
+	enum data_choice choice;
+	char str[16];
+	double num;
+	int32_t integer;
+	double lat;
+	double lng;
+	double acc;
+	double spd;
+	double hdg;
+	double alt;
+	bool spd_present;
+	bool hdg_present;
+	bool alt_present;
+	uint64_t ts;
+	bool ts_present;
+};
+
+static uint8_t msg_buf[MSG_BUF_SIZE];
+
+static bool str_decode(zcbor_state_t *state, char *const str, const size_t size)
+{
+	struct zcbor_string zstr;
+
+	if (!zcbor_tstr_decode(state, &zstr) || (zstr.len >= size)) {
+		return false;
+	}
+
+	memcpy(str, zstr.value, zstr.len);
+	str[zstr.len] = '\0';
+
+	return true;
+}
+
+static bool optional_float_decode(zcbor_state_t *state, const uint32_t key, double *const val,
+				  bool *const present)
+{
+	*present = zcbor_uint32_expect(state, key);
+
+	return !*present || zcbor_float64_decode(state, val);
+}
+
+static bool pvt_decode(zcbor_state_t *state, struct msg_out *const msg)
+{
+	return zcbor_map_start_decode(state) &&
+	       zcbor_uint32_expect(state, KEY_LAT) && zcbor_float64_decode(state, &msg->lat) &&
+	       zcbor_uint32_expect(state, KEY_LNG) && zcbor_float64_decode(state, &msg->lng) &&
+	       zcbor_uint32_expect(state, KEY_ACC) && zcbor_float64_decode(state, &msg->acc) &&
+	       optional_float_decode(state, KEY_SPD, &msg->spd, &msg->spd_present) &&
+	       optional_float_decode(state, KEY_HDG, &msg->hdg, &msg->hdg_present) &&
+	       optional_float_decode(state, KEY_ALT, &msg->alt, &msg->alt_present) &&
+	       zcbor_map_end_decode(state);
+}
+
+static bool data_decode(zcbor_state_t *state, struct msg_out *const msg)
+{
+	switch (ZCBOR_MAJOR_TYPE(*state->payload)) {
+	case ZCBOR_MAJOR_TYPE_TSTR:
+		msg->choice = DATA_TSTR;
+		return str_decode(state, msg->str, sizeof(msg->str));
+	case ZCBOR_MAJOR_TYPE_SIMPLE:
+		msg->choice = DATA_FLOAT;
+		return zcbor_float64_decode(state, &msg->num);
+	case ZCBOR_MAJOR_TYPE_PINT:
+	case ZCBOR_MAJOR_TYPE_NINT:
+		msg->choice = DATA_INT;
+		return zcbor_int32_decode(state, &msg->integer);
+	case ZCBOR_MAJOR_TYPE_MAP:
+		msg->choice = DATA_PVT;
+		return pvt_decode(state, msg);
+	default:
+		return false;
+	}
+}
+
+static void msg_decode(const struct nrf_cloud_obj *const obj, struct msg_out *const msg)
+{
+	bool ok;
+
+	ZCBOR_STATE_D(state, 2, obj->encoded_data.ptr, obj->encoded_data.len, 1, 0);
+
+	memset(msg, 0, sizeof(*msg));
+
+	ok = zcbor_map_start_decode(state) &&
+	     zcbor_uint32_expect(state, KEY_APP_ID) &&
+	     str_decode(state, msg->app_id, sizeof(msg->app_id)) &&
+	     zcbor_uint32_expect(state, KEY_DATA) && data_decode(state, msg);
+
+	msg->ts_present = ok && zcbor_uint32_expect(state, KEY_TS);
+	if (msg->ts_present) {
+		ok = zcbor_uint64_decode(state, &msg->ts);
+	}
+
+	ok = ok && zcbor_map_end_decode(state);
+
+	zassert_true(ok, "Message does not match message_out: %d", zcbor_peek_error(state));
+	zassert_equal(state->payload, (const uint8_t *)obj->encoded_data.ptr +
+				      obj->encoded_data.len, "Data after the message");
+}
+
+static void *obj_stream_setup(void)
+{
+	/* Start every test with a distinguishable buffer */
+	memset(msg_buf, 0xAA, sizeof(msg_buf));
+
+	return NULL;
+}
+
+ZTEST(nrf_cloud_obj_stream, test_cbor_gnss_msg)
+{
+	NRF_CLOUD_OBJ_STREAM_DEFINE(obj, msg_buf, sizeof(msg_buf), NRF_CLOUD_OBJ_STREAM_FMT_CBOR);
+	struct nrf_cloud_gnss_data gnss = {
+		.type = NRF_CLOUD_GNSS_TYPE_PVT,
+		.ts_ms = MSG_TS,
+		.pvt = {
+			.lat = 63.421218,
+			.lon = 10.437378,
+			.accuracy = 12.5f,
+			.alt = 48.0f,
+			.has_alt = true,
+			.heading = 271.0f,
+			.has_heading = true,
+		},
+	};
+	struct msg_out msg;
+
+	zassert_ok(nrf_cloud_obj_gnss_msg_create(&obj, &gnss), "Creating GNSS message failed");
+	zassert_ok(nrf_cloud_obj_cloud_encode(&obj), "Encoding failed");
+
+	msg_decode(&obj, &msg);
+
+	zassert_str_equal(msg.app_id, NRF_CLOUD_JSON_APPID_VAL_GNSS, "Wrong app ID");
+	zassert_equal(msg.choice, DATA_PVT, "Data is not PVT");
+	zassert_equal(msg.lat, gnss.pvt.lat, "Wrong latitude");
+	zassert_equal(msg.lng, gnss.pvt.lon, "Wrong longitude");
+	zassert_equal(msg.acc, gnss.pvt.accuracy, "Wrong accuracy");
+	zassert_false(msg.spd_present, "Speed was not set");
+	zassert_true(msg.hdg_present && (msg.hdg == gnss.pvt.heading), "Wrong heading");
+	zassert_true(msg.alt_present && (msg.alt == gnss.pvt.alt), "Wrong altitude");
+	zassert_true(msg.ts_present && (msg.ts == MSG_TS), "Wrong timestamp");
+
+	zassert_ok(nrf_cloud_obj_free(&obj), "Freeing failed");
+}
+
+ZTEST(nrf_cloud_obj_stream, test_cbor_scalar_msg)
+{
+	NRF_CLOUD_OBJ_STREAM_DEFINE(obj, msg_buf, sizeof(msg_buf), NRF_CLOUD_OBJ_STREAM_FMT_CBOR);
+	struct msg_out msg;
+
+	/* Integral values are sent as int */
+	zassert_ok(nrf_cloud_obj_msg_init(&obj, "TEMP", NRF_CLOUD_JSON_MSG_TYPE_VAL_DATA),
+		   "Init failed");
+	zassert_ok(nrf_cloud_obj_num_add(&obj, NRF_CLOUD_JSON_DATA_KEY, -21, false),
+		   "Adding failed");
+	zassert_ok(nrf_cloud_obj_cloud_encode(&obj), "Encoding failed");
+	msg_decode(&obj, &msg);
+	zassert_str_equal(msg.app_id, "TEMP", "Wrong app ID");
+	zassert_true((msg.choice == DATA_INT) && (msg.integer == -21), "Wrong int data");
+	zassert_false(msg.ts_present, "Timestamp was not set");
+	zassert_ok(nrf_cloud_obj_free(&obj), "Freeing failed");
+
+	/* The timestamp is moved after the data, as in message_out */
+	zassert_ok(nrf_cloud_obj_msg_init(&obj, "TEMP", NULL), "Init failed");
+	zassert_ok(nrf_cloud_obj_ts_add(&obj, MSG_TS), "Adding timestamp failed");
+	zassert_ok(nrf_cloud_obj_num_add(&obj, NRF_CLOUD_JSON_DATA_KEY, 21.7, false),
+		   "Adding failed");
+	zassert_ok(nrf_cloud_obj_cloud_encode(&obj), "Encoding failed");
+	msg_decode(&obj, &msg);
+	zassert_true((msg.choice == DATA_FLOAT) && (msg.num == 21.7), "Wrong float data");
+	zassert_true(msg.ts_present && (msg.ts == MSG_TS), "Wrong timestamp");
+	zassert_ok(nrf_cloud_obj_free(&obj), "Freeing failed");
+
+	zassert_ok(nrf_cloud_obj_msg_init(&obj, "NOTE", NULL), "Init failed");
+	zassert_ok(nrf_cloud_obj_str_add(&obj, NRF_CLOUD_JSON_DATA_KEY, "hello", false),
+		   "Adding failed");
+	zassert_ok(nrf_cloud_obj_cloud_encode(&obj), "Encoding failed");
+	msg_decode(&obj, &msg);
+	zassert_true((msg.choice == DATA_TSTR) && (strcmp(msg.str, "hello") == 0),
+		     "Wrong string data");
+	zassert_ok(nrf_cloud_obj_free(&obj), "Freeing failed");
+}
+
+ZTEST(nrf_cloud_obj_stream, test_cbor_outside_schema)
+{
+	NRF_CLOUD_OBJ_STREAM_DEFINE(obj, msg_buf, sizeof(msg_buf), NRF_CLOUD_OBJ_STREAM_FMT_CBOR);
+	static const uint32_t ints[] = { 1, 2 };
+	static const char *const strs[] = { "a", "b" };
+	size_t len;
+
+	zassert_equal(nrf_cloud_obj_bulk_init(&obj), -ENOTSUP, "CBOR bulk message started");
+
+	zassert_ok(nrf_cloud_obj_msg_init(&obj, "TEMP", NULL), "Init failed");
+	len = obj_stream.len;
+
+	zassert_equal(nrf_cloud_obj_num_add(&obj, "temp", 21.7, true), -ENOTSUP,
+		      "Key outside the schema added");
+	zassert_equal(nrf_cloud_obj_num_add(&obj, "temp", 21.7, false), -ENOTSUP,
+		      "Key outside the schema added");
+	zassert_equal(nrf_cloud_obj_bool_add(&obj, NRF_CLOUD_JSON_DATA_KEY, true, false),
+		      -ENOTSUP, "Boolean added");
+	zassert_equal(nrf_cloud_obj_null_add(&obj, NRF_CLOUD_JSON_DATA_KEY, false), -ENOTSUP,
+		      "Null added");
+	zassert_equal(nrf_cloud_obj_int_array_add(&obj, NRF_CLOUD_JSON_DATA_KEY, ints,
+						  ARRAY_SIZE(ints), false),
+		      -ENOTSUP, "Array added");
+	zassert_equal(nrf_cloud_obj_str_array_add(&obj, NRF_CLOUD_JSON_DATA_KEY, strs,
+						  ARRAY_SIZE(strs), false),
+		      -ENOTSUP, "Array added");
+	zassert_equal(nrf_cloud_obj_ts_add(&obj, -1), -EINVAL, "Negative timestamp added");
+	zassert_equal(obj_stream.len, len, "Rejected value was written");
+
+	/* message_out needs a data value */
+	zassert_equal(nrf_cloud_obj_cloud_encode(&obj), -ENODATA, "Message without data");
+
+	/* and only one of them */
+	zassert_ok(nrf_cloud_obj_num_add(&obj, NRF_CLOUD_JSON_DATA_KEY, 1, false),
+		   "Adding failed");
+	zassert_equal(nrf_cloud_obj_str_add(&obj, NRF_CLOUD_JSON_DATA_KEY, "x", false), -EEXIST,
+		      "Second data value added");
+	zassert_ok(nrf_cloud_obj_free(&obj), "Freeing failed");
+
+	/* A PVT value needs latitude, longitude and accuracy */
+	zassert_ok(nrf_cloud_obj_msg_init(&obj, "GNSS", NULL), "Init failed");
+	zassert_ok(nrf_cloud_obj_num_add(&obj, NRF_CLOUD_JSON_GNSS_PVT_KEY_LAT, 63.4, true),
+		   "Adding failed");
+	zassert_equal(nrf_cloud_obj_cloud_encode(&obj), -ENODATA, "Incomplete PVT encoded");
+	zassert_ok(nrf_cloud_obj_free(&obj), "Freeing failed");
+}
+
+ZTEST(nrf_cloud_obj_stream, test_pvt_add_all_or_nothing)
+{
+	static const struct nrf_cloud_gnss_pvt pvt = {
+		.lat = 63.421218,
+		.lon = 10.437378,
+		.accuracy = 12.5f,
+		.alt = 48.0f,
+		.has_alt = true,
+		.speed = 0.3f,
+		.has_speed = true,
+	};
+	const enum nrf_cloud_obj_stream_fmt fmts[] = {
+		NRF_CLOUD_OBJ_STREAM_FMT_JSON,
+		NRF_CLOUD_OBJ_STREAM_FMT_CBOR,
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(fmts); i++) {
+		/* Room for the app ID and some, but not all of the PVT members */
+		NRF_CLOUD_OBJ_STREAM_DEFINE(obj, msg_buf, 40, fmts[i]);
+		size_t len;
+
+		zassert_ok(nrf_cloud_obj_msg_init(&obj, "GNSS", NULL), "Init failed");
+		len = obj_stream.len;
+
+		zassert_equal(nrf_cloud_obj_pvt_add(&obj, &pvt), -ENOMEM, "PVT fit the buffer");
+		zassert_equal(obj_stream.len, len, "Failed PVT was partially written");
+		zassert_equal(obj_stream.depth, 1, "Failed PVT left the data child open");
+		zassert_false(obj_stream.data_open, "Failed PVT left the data child open");
+
+		/* The message can still be completed */
+		zassert_ok(nrf_cloud_obj_str_add(&obj, NRF_CLOUD_JSON_DATA_KEY, "none", false),
+			   "Adding failed");
+		zassert_ok(nrf_cloud_obj_cloud_encode(&obj), "Encoding failed");
+
+		zassert_ok(nrf_cloud_obj_free(&obj), "Freeing failed");
+	}
+}
+
+ZTEST(nrf_cloud_obj_stream, test_missing_stream)
+{
+	struct nrf_cloud_obj obj = { .type = NRF_CLOUD_OBJ_TYPE_STREAM, .stream = NULL };
+	static const char *const strs[] = { "a" };
+
+	zassert_equal(nrf_cloud_obj_str_array_add(&obj, "k", strs, ARRAY_SIZE(strs), true),
+		      -ENOENT, "Array added without a stream");
+}
+
+ZTEST_SUITE(nrf_cloud_obj_stream, NULL, obj_stream_setup, NULL, NULL, NULL);
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <time.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+#include <pm_config.h>
+#include <flash_map_pm.h>
+#include <date_time.h>
+#include <net/nrf_cloud_pgps.h>
+#include "nrf_cloud_pgps_internal.h"
+#include "nrf_cloud_pgps_schema_v1.h"
+#include "nrf_cloud_pgps_utils.h"
+
+#define PERIOD_MIN 240
+#define HEAD_SIZE sizeof(struct pgps_prediction_dl_head)
+#define EPH_SIZE sizeof(struct nrf_cloud_agnss_ephemeris)
+/* Ephemeris of each prediction that is downloaded as all zeros */
+#define EMPTY_SV 5
+
+static uint8_t dl_buf[sizeof(struct nrf_cloud_pgps_header) +
+		      NUM_PREDICTIONS * PGPS_PREDICTION_DL_SIZE];
+static struct nrf_cloud_pgps_prediction expected[NUM_PREDICTIONS];
+static uint8_t block_buf[BLOCK_SIZE];
+static const struct flash_area *pgps_area;
+static int64_t start_sec;
+static bool request_received;
+static K_SEM_DEFINE(ready_sem, 0, 1);
+
+/* Split the head of the first prediction, then its third ephemeris, then span into
+ * the next prediction. The last size is repeated until the end of the download.
+ */
+static const size_t split_frags[] = {
+	sizeof(struct nrf_cloud_pgps_header) + 5,
+	HEAD_SIZE - 5 + 2 * EPH_SIZE + 8,
+	PGPS_PREDICTION_DL_SIZE - (HEAD_SIZE + 2 * EPH_SIZE + 8) + HEAD_SIZE + 3,
+	257,
+};
+
+static void pgps_handler(struct nrf_cloud_pgps_event *event)
+{
+	if (event->type == PGPS_EVT_REQUEST) {
+		request_received = true;
+	} else if (event->type == PGPS_EVT_READY) {
+		k_sem_give(&ready_sem);
+	}
+}
+
+/* Build the download of a full prediction set and the predictions expected in flash */
+static void download_build(void)
+{
+	struct nrf_cloud_pgps_header header = {
+		.schema_version = NRF_CLOUD_PGPS_BIN_SCHEMA_VERSION,
+		.array_type = NRF_CLOUD_PGPS_PREDICTION_HEADER,
+		.num_items = 1,
+		.prediction_count = NUM_PREDICTIONS,
+		.prediction_size = PGPS_PREDICTION_DL_SIZE,
+		.prediction_period_min = PERIOD_MIN,
+	};
+	uint8_t *pos = dl_buf;
+	uint16_t gps_day;
+	uint32_t gps_time_of_day;
+
+	npgps_gps_sec_to_day_time(start_sec, &gps_day, &gps_time_of_day);
+	header.gps_day = gps_day;
+	header.gps_time_of_day = gps_time_of_day;
+	memcpy(pos, &header, sizeof(header));
+	pos += sizeof(header);
+
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		struct nrf_cloud_pgps_prediction *p = &expected[pnum];
+		int64_t pred_sec = start_sec + pnum * PERIOD_MIN * SEC_PER_MIN;
+		struct pgps_prediction_dl_head head = {
+			.time_type = NRF_CLOUD_AGNSS_GPS_SYSTEM_CLOCK,
+			.time_count = 1,
+			.ephemeris_type = NRF_CLOUD_AGNSS_GPS_EPHEMERIDES,
+			.ephemeris_count = NRF_CLOUD_PGPS_NUM_SV,
+		};
+
+		npgps_gps_sec_to_day_time(pred_sec, &gps_day, &gps_time_of_day);
+		head.time.date_day = gps_day;
+		head.time.time_full_s = gps_time_of_day;
+		memcpy(pos, &head, sizeof(head));
+		pos += sizeof(head);
+
+		memset(p, 0, sizeof(*p));
+		p->time_type = head.time_type;
+		p->time_count = head.time_count;
+		p->time = head.time;
+		p->schema_version = NRF_CLOUD_AGNSS_BIN_SCHEMA_VERSION;
+		p->ephemeris_type = head.ephemeris_type;
+		p->ephemeris_count = head.ephemeris_count;
+		p->sentinel = (uint32_t)pred_sec;
+
+		for (int sv = 0; sv < NRF_CLOUD_PGPS_NUM_SV; sv++) {
+			uint8_t *eph = (uint8_t *)&p->ephemerii[sv];
+
+			/* Different data in each ephemeris, so misplaced bytes are detected */
+			eph[0] = sv + 1;
+			for (int i = 1; i < EPH_SIZE; i++) {
+				eph[i] = (sv == EMPTY_SV) ? 0 : (uint8_t)(pnum * 64 + sv + i);
+			}
+
+			memcpy(pos, eph, EPH_SIZE);
+			pos += EPH_SIZE;
+		}
+
+		/* Empty ephemerides are marked as such when stored */
+		p->ephemerii[EMPTY_SV].health = NRF_CLOUD_PGPS_EMPTY_EPHEM_HEALTH;
+	}
+
+	zassert_equal(pos - dl_buf, sizeof(dl_buf));
+}
+
+/* Pass the download to the library in fragments of the given sizes; the last size
+ * is repeated until the end of the download.
+ */
+static void download_feed(const size_t *frag_len, size_t frag_cnt)
+{
+	size_t off = 0;
+
+	zassert_ok(nrf_cloud_pgps_begin_update());
+
+	for (size_t i = 0; off < sizeof(dl_buf); i++) {
+		size_t len = MIN(frag_len[MIN(i, frag_cnt - 1)], sizeof(dl_buf) - off);
+
+		zassert_ok(nrf_cloud_pgps_process_update(&dl_buf[off], len),
+			   "Fragment %zu at offset %zu rejected", i, off);
+		off += len;
+	}
+
+	zassert_ok(nrf_cloud_pgps_finish_update());
+	zassert_ok(k_sem_take(&ready_sem, K_NO_WAIT), "Predictions not ready");
+}
+
+static void storage_verify(void)
+{
+	const struct npgps_index_record *record = npgps_get_saved_index();
+
+	zassert_equal(record->count, NUM_PREDICTIONS);
+	zassert_equal(record->start_sec, start_sec);
+
+	for (int pnum = 0; pnum < NUM_PREDICTIONS; pnum++) {
+		zassert_true(record->block[pnum] < NUM_BLOCKS, "Prediction %d not stored", pnum);
+		zassert_ok(flash_area_read(pgps_area, npgps_block_to_offset(record->block[pnum]),
+					   block_buf, sizeof(block_buf)));
+
+		zassert_mem_equal(block_buf, &expected[pnum], sizeof(expected[pnum]),
+				  "Prediction %d stored incorrectly", pnum);
+		zassert_equal(record->crc[pnum],
+			      crc32_ieee(block_buf, sizeof(struct nrf_cloud_pgps_prediction)),
+			      "Wrong CRC of prediction %d", pnum);
+
+		for (size_t i = sizeof(expected[pnum]); i < sizeof(block_buf); i++) {
+			zassert_equal(block_buf[i], 0xff, "Padding of prediction %d written", pnum);
+		}
+	}
+}
+
+static void before(void *fixture)
+{
+	int64_t now_sec;
+
+	ARG_UNUSED(fixture);
+
+	request_received = false;
+	k_sem_reset(&ready_sem);
+
+	zassert_ok(nrf_cloud_pgps_request_internal_all());
+	zassert_true(request_received, "No request for predictions");
+
+	/* The set started an hour ago, so it covers the current time */
+	zassert_ok(npgps_get_time(&now_sec, NULL, NULL));
+	start_sec = now_sec - SEC_PER_HOUR;
+	download_build();
+}
+
+ZTEST(nrf_cloud_pgps, test_fragments_split_parts)
+{
+	download_feed(split_frags, ARRAY_SIZE(split_frags));
+	storage_verify();
+}
+
+ZTEST(nrf_cloud_pgps, test_single_byte_fragments)
+{
+	/* Every part of every prediction is staged */
+	static const size_t frags[] = { sizeof(struct nrf_cloud_pgps_header), 1 };
+
+	download_feed(frags, ARRAY_SIZE(frags));
+	storage_verify();
+}
+
+ZTEST(nrf_cloud_pgps, test_single_fragment)
+{
+	/* No part of any prediction is staged */
+	static const size_t frags[] = { sizeof(dl_buf) };
+
+	download_feed(frags, ARRAY_SIZE(frags));
+	storage_verify();
+}
+
+static void *setup(void)
+{
+	struct nrf_cloud_pgps_init_param param = {
+		.event_handler = pgps_handler,
+	};
+	struct tm now = {
+		.tm_year = 125,
+		.tm_mon = 0,
+		.tm_mday = 1,
+		.tm_hour = 12,
+	};
+
+	zassert_ok(date_time_set(&now));
+	zassert_ok(nrf_cloud_pgps_init(&param));
+	zassert_ok(flash_area_open(FLASH_AREA_ID(PGPS), &pgps_area));
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_cloud_pgps, NULL, setup, before, NULL, NULL);
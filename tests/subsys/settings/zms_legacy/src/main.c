@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+#include <settings/settings_zms_legacy.h>
+
+#define SUBTREE "zmst"
+#define NAME_LEN 32
+#define ENTRY_CNT 64
+/* More than the previously fixed-size free ID list could hold */
+#define DELETE_CNT 40
+/* More than CONFIG_SETTINGS_ZMS_NAME_CACHE_SIZE in the small cache test, with
+ * fewer entries left after the deletes.
+ */
+#define RELOAD_CNT 12
+#define RELOAD_DELETE_CNT 10
+/* Enough updates to fill the transaction buffer many times */
+#define TXN_ROUNDS 200
+#define TXN_ENTRY_CNT 16
+#define TXN_THREAD_STACK_SIZE 1024
+
+static uint32_t subtree_cnt;
+
+static K_THREAD_STACK_DEFINE(txn_thread_stack, TXN_THREAD_STACK_SIZE);
+static struct k_thread txn_thread;
+static int txn_thread_err;
+
+static int subtree_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg)
+{
+	subtree_cnt++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(zms_legacy_test, SUBTREE, NULL, subtree_set, NULL, NULL);
+
+static struct settings_zms *backend_get(void)
+{
+	struct zms_fs *fs;
+
+	zassert_ok(settings_storage_get((void **)&fs));
+
+	return CONTAINER_OF(fs, struct settings_zms, cf_zms);
+}
+
+static void entry_name_get(const char *prefix, uint32_t idx, char *name)
+{
+	snprintf(name, NAME_LEN, SUBTREE "/%s/%u", prefix, idx);
+}
+
+static void entries_store(const char *prefix, uint32_t first, uint32_t cnt)
+{
+	char name[NAME_LEN];
+
+	for (uint32_t i = first; i < first + cnt; i++) {
+		entry_name_get(prefix, i, name);
+		zassert_ok(settings_save_one(name, &i, sizeof(i)), "Cannot store %s", name);
+	}
+}
+
+static void entries_delete(const char *prefix, uint32_t first, uint32_t cnt)
+{
+	char name[NAME_LEN];
+
+	for (uint32_t i = first; i < first + cnt; i++) {
+		entry_name_get(prefix, i, name);
+		zassert_ok(settings_delete(name), "Cannot delete %s", name);
+	}
+}
+
+static void entries_verify(const char *prefix, uint32_t first, uint32_t cnt, bool exist)
+{
+	char name[NAME_LEN];
+	uint32_t val;
+	ssize_t rc;
+
+	for (uint32_t i = first; i < first + cnt; i++) {
+		entry_name_get(prefix, i, name);
+		rc = settings_zms_legacy_load_one(name, &val, sizeof(val));
+
+		if (exist) {
+			zassert_equal(rc, sizeof(val), "Cannot read %s: %d", name, (int)rc);
+			zassert_equal(val, i, "Wrong value of %s", name);
+		} else {
+			zassert_equal(rc, -ENOENT, "Deleted %s found: %d", name, (int)rc);
+		}
+	}
+}
+
+ZTEST(settings_zms_legacy, test_save_load_delete)
+{
+	struct settings_zms *cf = backend_get();
+	uint32_t last_name_id;
+
+	entries_store("sld", 0, ENTRY_CNT);
+	last_name_id = cf->last_name_id;
+	entries_verify("sld", 0, ENTRY_CNT, true);
+
+	entries_delete("sld", 0, ENTRY_CNT / 2);
+	entries_verify("sld", 0, ENTRY_CNT / 2, false);
+	entries_verify("sld", ENTRY_CNT / 2, ENTRY_CNT / 2, true);
+
+	/* Updates do not allocate new name IDs */
+	entries_store("sld", ENTRY_CNT / 2, ENTRY_CNT / 2);
+	entries_verify("sld", ENTRY_CNT / 2, ENTRY_CNT / 2, true);
+	zassert_equal(cf->last_name_id, last_name_id);
+
+	entries_delete("sld", ENTRY_CNT / 2, ENTRY_CNT / 2);
+}
+
+ZTEST(settings_zms_legacy, test_deleted_ids_reused)
+{
+	struct settings_zms *cf = backend_get();
+	uint32_t last_name_id;
+
+	entries_store("old", 0, ENTRY_CNT);
+	last_name_id = cf->last_name_id;
+
+	/* Keep the largest name ID in use */
+	entries_delete("old", 0, DELETE_CNT);
+	zassert_equal(cf->last_name_id, last_name_id);
+
+	entries_store("new", 0, DELETE_CNT);
+	zassert_equal(cf->last_name_id, last_name_id, "Deleted name IDs not reused");
+
+	entries_verify("old", 0, DELETE_CNT, false);
+	entries_verify("old", DELETE_CNT, ENTRY_CNT - DELETE_CNT, true);
+	entries_verify("new", 0, DELETE_CNT, true);
+
+	entries_delete("old", DELETE_CNT, ENTRY_CNT - DELETE_CNT);
+	entries_delete("new", 0, DELETE_CNT);
+}
+
+ZTEST(settings_zms_legacy, test_ids_freed_before_load_reused)
+{
+	struct settings_zms *cf = backend_get();
+	uint32_t last_name_id;
+
+	/* With a small name cache, the load rebuilds it with free IDs that are
+	 * too large for the free ID bitmap.
+	 */
+	entries_store("fbl", 0, RELOAD_CNT);
+	entries_delete("fbl", 0, RELOAD_DELETE_CNT);
+	zassert_ok(settings_load());
+	last_name_id = cf->last_name_id;
+
+	entries_store("fbl", RELOAD_CNT, RELOAD_DELETE_CNT);
+	zassert_equal(cf->last_name_id, last_name_id, "Deleted name IDs not reused");
+	entries_verify("fbl", 0, RELOAD_DELETE_CNT, false);
+	entries_verify("fbl", RELOAD_DELETE_CNT, RELOAD_CNT, true);
+
+	entries_delete("fbl", RELOAD_DELETE_CNT, RELOAD_CNT);
+}
+
+ZTEST(settings_zms_legacy, test_load_subtree_keeps_index)
+{
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+	struct settings_zms *cf = backend_get();
+	uint32_t cache_total;
+#endif
+
+	entries_store("lst", 0, ENTRY_CNT);
+
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+	cache_total = cf->cache_total;
+#endif
+
+	subtree_cnt = 0;
+	zassert_ok(settings_load_subtree(SUBTREE));
+	zassert_equal(subtree_cnt, ENTRY_CNT);
+
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+	zassert_true(cf->cache_ovfl || (cf->cache_total == cache_total),
+		     "Name index changed by the load");
+#endif
+
+	/* Saves and deletes after the load still find the stored names */
+	entries_delete("lst", 0, ENTRY_CNT / 2);
+	entries_store("lst", ENTRY_CNT, ENTRY_CNT / 2);
+	entries_verify("lst", 0, ENTRY_CNT / 2, false);
+	entries_verify("lst", ENTRY_CNT / 2, ENTRY_CNT, true);
+
+	subtree_cnt = 0;
+	zassert_ok(settings_load_subtree(SUBTREE));
+	zassert_equal(subtree_cnt, ENTRY_CNT);
+
+	entries_delete("lst", ENTRY_CNT / 2, ENTRY_CNT);
+}
+
+ZTEST(settings_zms_legacy, test_txn_coalesce)
+{
+	char name[NAME_LEN];
+	uint32_t val;
+
+	zassert_ok(settings_zms_legacy_txn_begin());
+
+	for (uint32_t round = 0; round < TXN_ROUNDS; round++) {
+		for (uint32_t i = 0; i < TXN_ENTRY_CNT; i++) {
+			entry_name_get("txn", i, name);
+			val = round * TXN_ENTRY_CNT + i;
+			zassert_ok(settings_save_one(name, &val, sizeof(val)), "Cannot stage %s",
+				   name);
+		}
+	}
+
+	entries_delete("txn", 0, TXN_ENTRY_CNT / 2);
+
+	/* Nothing is written before the commit */
+	entries_verify("txn", TXN_ENTRY_CNT / 2, TXN_ENTRY_CNT / 2, false);
+
+	zassert_ok(settings_zms_legacy_txn_commit());
+	zassert_equal(settings_zms_legacy_txn_commit(), -EINVAL);
+
+	entries_verify("txn", 0, TXN_ENTRY_CNT / 2, false);
+
+	for (uint32_t i = TXN_ENTRY_CNT / 2; i < TXN_ENTRY_CNT; i++) {
+		entry_name_get("txn", i, name);
+		zassert_equal(settings_zms_legacy_load_one(name, &val, sizeof(val)), sizeof(val));
+		zassert_equal(val, (TXN_ROUNDS - 1) * TXN_ENTRY_CNT + i, "Wrong value of %s",
+			      name);
+	}
+
+	entries_delete("txn", TXN_ENTRY_CNT / 2, TXN_ENTRY_CNT / 2);
+}
+
+/* Write a journal as an interrupted commit would, storing entry i of prefix, or
+ * deleting it if del is true, in two chunks and with the commit marker if
+ * committed is true.
+ */
+static void journal_write(struct settings_zms *cf, const char *prefix, uint32_t cnt, bool del,
+			  bool committed)
+{
+	static uint8_t journal[CONFIG_SETTINGS_ZMS_TXN_BUF_SIZE];
+	struct settings_zms_txn_rec rec;
+	char name[NAME_LEN];
+	uint32_t len = 0;
+
+	for (uint32_t i = 0; i < cnt; i++) {
+		entry_name_get(prefix, i, name);
+		rec.name_len = strlen(name);
+		rec.val_len = del ? 0 : sizeof(i);
+		zassert_true(len + sizeof(rec) + rec.name_len + rec.val_len <= sizeof(journal));
+
+		memcpy(&journal[len], &rec, sizeof(rec));
+		len += sizeof(rec);
+		memcpy(&journal[len], name, rec.name_len);
+		len += rec.name_len;
+		memcpy(&journal[len], &i, rec.val_len);
+		len += rec.val_len;
+	}
+
+	zassert_true(zms_write(&cf->cf_zms, ZMS_TXN_DATA_ID, journal, len / 2) >= 0);
+	zassert_true(zms_write(&cf->cf_zms, ZMS_TXN_DATA_ID + 1, &journal[len / 2],
+			       len - len / 2) >= 0);
+
+	if (committed) {
+		zassert_true(zms_write(&cf->cf_zms, ZMS_TXN_ID, &len, sizeof(len)) >= 0);
+	}
+}
+
+static void journal_verify_deleted(struct settings_zms *cf)
+{
+	zassert_equal(zms_get_data_length(&cf->cf_zms, ZMS_TXN_ID), -ENOENT,
+		      "Commit marker not deleted");
+	zassert_equal(zms_get_data_length(&cf->cf_zms, ZMS_TXN_DATA_ID), -ENOENT,
+		      "Journal not deleted");
+	zassert_equal(zms_get_data_length(&cf->cf_zms, ZMS_TXN_DATA_ID + 1), -ENOENT,
+		      "Journal not deleted");
+}
+
+ZTEST(settings_zms_legacy, test_txn_journal)
+{
+	struct settings_zms *cf = backend_get();
+
+	entries_store("txj", 0, TXN_ENTRY_CNT);
+
+	/* The journal is written and the marker is deleted after the commit */
+	zassert_ok(settings_zms_legacy_txn_begin());
+	entries_delete("txj", 0, TXN_ENTRY_CNT);
+	entries_store("txk", 0, TXN_ENTRY_CNT);
+	zassert_ok(settings_zms_legacy_txn_commit());
+
+	journal_verify_deleted(cf);
+	entries_verify("txj", 0, TXN_ENTRY_CNT, false);
+	entries_verify("txk", 0, TXN_ENTRY_CNT, true);
+
+	entries_delete("txk", 0, TXN_ENTRY_CNT);
+}
+
+ZTEST(settings_zms_legacy, test_txn_recover_committed)
+{
+	struct settings_zms *cf = backend_get();
+
+	entries_store("txr", 0, TXN_ENTRY_CNT);
+
+	/* A reset after the commit marker was written, before the updates */
+	journal_write(cf, "txr", TXN_ENTRY_CNT, true, true);
+	zassert_ok(settings_zms_legacy_txn_recover(cf));
+
+	journal_verify_deleted(cf);
+	entries_verify("txr", 0, TXN_ENTRY_CNT, false);
+
+	journal_write(cf, "txs", TXN_ENTRY_CNT, false, true);
+	zassert_ok(settings_zms_legacy_txn_recover(cf));
+
+	journal_verify_deleted(cf);
+	entries_verify("txs", 0, TXN_ENTRY_CNT, true);
+
+	entries_delete("txs", 0, TXN_ENTRY_CNT);
+}
+
+ZTEST(settings_zms_legacy, test_txn_recover_uncommitted)
+{
+	struct settings_zms *cf = backend_get();
+
+	entries_store("txu", 0, TXN_ENTRY_CNT);
+
+	/* A reset while the journal was written, before the commit marker */
+	journal_write(cf, "txu", TXN_ENTRY_CNT, true, false);
+	zassert_ok(settings_zms_legacy_txn_recover(cf));
+
+	journal_verify_deleted(cf);
+	entries_verify("txu", 0, TXN_ENTRY_CNT, true);
+
+	entries_delete("txu", 0, TXN_ENTRY_CNT);
+}
+
+static void txn_thread_fn(void *p1, void *p2, void *p3)
+{
+	txn_thread_err = settings_zms_legacy_txn_commit();
+}
+
+ZTEST(settings_zms_legacy, test_txn_owner)
+{
+	zassert_ok(settings_zms_legacy_txn_begin());
+	zassert_equal(settings_zms_legacy_txn_begin(), -EALREADY);
+
+	k_thread_create(&txn_thread, txn_thread_stack, K_THREAD_STACK_SIZEOF(txn_thread_stack),
+			txn_thread_fn, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_thread_join(&txn_thread, K_SECONDS(1)), "Commit blocked");
+	zassert_equal(txn_thread_err, -EPERM);
+
+	zassert_ok(settings_zms_legacy_txn_abort());
+	zassert_equal(settings_zms_legacy_txn_abort(), -EINVAL);
+}
+
+static void *settings_zms_legacy_setup(void)
+{
+	zassert_ok(settings_subsys_init(), "Cannot initialize settings");
+	zassert_ok(settings_load(), "Cannot load settings");
+
+	return NULL;
+}
+
+ZTEST_SUITE(settings_zms_legacy, NULL, settings_zms_legacy_setup, NULL, NULL, NULL);